@@ -0,0 +1,82 @@
+// Intrinsics::gather against the scalar lookup loop, per tier, from tables that fit L1 to tables far past the LLC.
+// Usage: Gather [lookups] (default 4M random indices). Prints ns per lookup and the speedup over the scalar loop
+#include "AvxIntrinsics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace devsw::stl;
+
+namespace {
+	constexpr int RUNS = 5;
+
+	// Best of RUNS, in ns per lookup
+	template <typename F>
+	double time_lookups(size_t lookups, F&& body) {
+		double best = 1e30;
+		for (int run = 0; run < RUNS; ++run) {
+			auto start = std::chrono::steady_clock::now();
+			body();
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			if (ns < best) best = ns;
+		}
+		return best / static_cast<double>(lookups);
+	}
+
+	template <typename T>
+	void sweep(const char* type, size_t lookups) {
+		std::mt19937 rng(7);
+		const SimdTier tiers[] = { SimdTier::Scalar, SimdTier::SSE42, SimdTier::AVX2, SimdTier::AVX512 };
+		std::printf("\n%s, %zu random lookups. ns per lookup (speedup over the scalar loop)\n", type, lookups);
+		std::printf("%10s %8s", "table", "loop");
+		for (SimdTier tier : tiers) {
+			Dispatch::set_tier(tier);
+			if (Dispatch::active_tier() == tier) std::printf(" %15s %15s", Dispatch::tier_name(tier), "unchecked");
+		}
+		std::printf("\n");
+
+		for (size_t table_bytes = size_t(4) << 10; table_bytes <= size_t(512) << 20; table_bytes *= 4) {
+			size_t rows = table_bytes / sizeof(T);
+			AlignedVector<T> table(rows);
+			for (size_t i = 0; i < rows; ++i) table[i] = static_cast<T>(i);
+			AlignedVector<uint32_t> indices(lookups);
+			std::uniform_int_distribution<uint32_t> row(0, static_cast<uint32_t>(rows - 1));
+			for (size_t i = 0; i < lookups; ++i) indices[i] = row(rng);
+			AlignedVector<T> dest(lookups);
+
+			// What the callers wrote before gather existed
+			double loop = time_lookups(lookups, [&] {
+				const T* t = table.begin();
+				const uint32_t* idx = indices.begin();
+				T* d = dest.begin();
+				for (size_t i = 0; i < lookups; ++i) d[i] = t[idx[i]];
+			});
+			volatile T sink = dest[lookups / 2];
+			(void)sink;
+
+			if (table_bytes >= (size_t(1) << 20)) std::printf("%7zu MiB %8.2f", table_bytes >> 20, loop);
+			else std::printf("%7zu KiB %8.2f", table_bytes >> 10, loop);
+			for (SimdTier tier : tiers) {
+				Dispatch::set_tier(tier);
+				if (Dispatch::active_tier() != tier) continue;
+				double checked = time_lookups(lookups, [&] { Intrinsics::gather(dest, table, indices, BoundsCheck::Checked); });
+				double unchecked = time_lookups(lookups, [&] { Intrinsics::gather(dest, table, indices, BoundsCheck::Unchecked); });
+				std::printf(" %7.2f (%4.2fx) %7.2f (%4.2fx)", checked, loop / checked, unchecked, loop / unchecked);
+			}
+			std::printf("\n");
+		}
+		Dispatch::set_tier(Dispatch::detected_tier());
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t lookups = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : size_t(4) << 20;
+	if (lookups == 0) lookups = size_t(4) << 20;
+	std::printf("Host tier %s, last level cache %zu KiB\n", Dispatch::tier_name(Dispatch::detected_tier()), Dispatch::features().last_level_cache >> 10);
+	sweep<float>("float", lookups);
+	sweep<double>("double", lookups);
+	sweep<int32_t>("int32_t", lookups);
+	return 0;
+}
@@ -0,0 +1,139 @@
+// The inline paths Memory.h takes below SIMD_FILL_BYTES/SIMD_COMPARE_BYTES/SIMD_ZERO_BYTES against the
+// Dispatch::memory() kernel it calls above them, power-of-two sizes from 8 B to 1 GiB, libc alongside for reference.
+// The copy kernel is timed against memcpy for reference only: it is level with it, so copy_range stays on memcpy.
+// Usage: MemoryCrossover [max bytes]. Prints ns per call, then per function the smallest size from which the kernel
+// is level or ahead at every size up to 64 KiB: the value of the constant for this host
+#include "Dispatch.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace devsw::stl;
+
+namespace {
+	constexpr int RUNS = 5;
+	constexpr size_t MIN_BYTES = 8;
+	constexpr size_t CROSSOVER_LIMIT = size_t(64) << 10; // Past this everything is bandwidth, not call overhead
+	constexpr double NOISE = 1.03; // A kernel within 3% is level, e.g. copy against glibc memcpy
+	volatile size_t sink;
+
+	// Best of RUNS of enough calls to take a few ms, in ns per call
+	template <typename F>
+	double time_calls(size_t bytes, F&& call) {
+		size_t calls = (size_t(64) << 20) / bytes;
+		if (calls < 1) calls = 1;
+		if (calls > (size_t(1) << 22)) calls = size_t(1) << 22;
+		double best = 1e30;
+		for (int run = 0; run < RUNS; ++run) {
+			size_t result = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < calls; ++i) {
+				result += call(i);
+				std::atomic_signal_fence(std::memory_order_seq_cst); // Nothing read or written may be hoisted out of the loop
+			}
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			sink = result;
+			if (ns < best) best = ns;
+		}
+		return best / static_cast<double>(calls);
+	}
+
+	// The inline paths, as in Memory.h
+	void fill_loop(uint32_t* dest, size_t count, uint32_t value) {
+		for (size_t i = 0; i < count; ++i) dest[i] = value;
+	}
+
+	size_t compare_loop(const uint32_t* a, const uint32_t* b, size_t count) {
+		for (size_t i = 0; i < count; ++i) {
+			if (!(a[i] == b[i])) return i;
+		}
+		return count;
+	}
+
+	bool zero_loop(const void* ptr, size_t bytes) {
+		const unsigned char* p = static_cast<const unsigned char*>(ptr);
+		uint64_t acc = 0;
+		size_t i = 0;
+		for (; i + 8 <= bytes; i += 8) {
+			uint64_t word;
+			std::memcpy(&word, p + i, 8);
+			acc |= word;
+		}
+		for (; i < bytes; ++i) acc |= p[i];
+		return acc == 0;
+	}
+
+	struct Crossover {
+		const char* name;
+		const char* constant;
+		size_t smallest = 0; // Smallest size from which the kernel has won at every size so far
+		bool lost = false;
+
+		void add(size_t bytes, double inline_ns, double kernel_ns) {
+			if (bytes > CROSSOVER_LIMIT) return;
+			if (kernel_ns <= inline_ns * NOISE) {
+				if (!smallest || lost) smallest = bytes;
+				lost = false;
+			}
+			else {
+				lost = true;
+			}
+		}
+
+		void print() const {
+			if (smallest && !lost) std::printf("%-18s = %zu   (%s kernel level or ahead from %zu B)\n", constant, smallest, name, smallest);
+			else std::printf("%-18s : %s kernel not ahead by %zu B, keep the inline path\n", constant, name, CROSSOVER_LIMIT);
+		}
+	};
+}
+
+int main(int argc, char** argv) {
+	size_t max_bytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : size_t(1) << 30;
+	if (max_bytes < MIN_BYTES) max_bytes = size_t(1) << 30;
+	const CpuFeatures& features = Dispatch::features();
+	const MemoryTable& memory = Dispatch::memory();
+	std::printf("Tier %s, ERMS %d, FSRM %d. ns per call\n", Dispatch::tier_name(Dispatch::active_tier()), features.erms, features.fsrm);
+
+	// Equal buffers, so compare scans everything; zero, so is_zero does too
+	std::vector<uint32_t> a(max_bytes / sizeof(uint32_t) + 1), b(a.size());
+	std::vector<unsigned char> zeros(max_bytes);
+
+	Crossover fill{ "fill", "SIMD_FILL_BYTES" };
+	Crossover compare{ "compare", "SIMD_COMPARE_BYTES" }, zero{ "is_zero", "SIMD_ZERO_BYTES" };
+	std::printf("%10s | %8s %8s %8s | %8s %8s | %8s %8s %8s | %8s %8s\n", "bytes", "fill", "memset", "kernel",
+		"memcpy", "kernel", "==", "memcmp", "kernel", "zero", "kernel");
+	for (size_t bytes = MIN_BYTES; bytes <= max_bytes; bytes *= 2) {
+		size_t count = bytes / sizeof(uint32_t);
+		uint32_t* pa = a.data();
+		const uint32_t* pb = b.data();
+
+		double fill_inline = time_calls(bytes, [&](size_t i) { fill_loop(pa, count, static_cast<uint32_t>(i)); return size_t(pa[0]); });
+		double fill_libc = time_calls(bytes, [&](size_t i) { std::memset(pa, static_cast<int>(i), bytes); return size_t(pa[0]); });
+		double fill_kernel = time_calls(bytes, [&](size_t i) { uint32_t value = static_cast<uint32_t>(i); memory.fill(pa, &value, sizeof(value), bytes); return size_t(pa[0]); });
+		double copy_libc = time_calls(bytes, [&](size_t) { std::memcpy(pa, pb, bytes); return size_t(pa[0]); });
+		double copy_kernel = time_calls(bytes, [&](size_t) { memory.copy(pa, pb, bytes); return size_t(pa[0]); });
+		std::memcpy(pa, pb, bytes);
+		double compare_inline = time_calls(bytes, [&](size_t) { return compare_loop(pa, pb, count); });
+		double compare_libc = time_calls(bytes, [&](size_t) { return size_t(std::memcmp(pa, pb, bytes) == 0); });
+		double compare_kernel = time_calls(bytes, [&](size_t) { return memory.mismatch(pa, pb, bytes); });
+		double zero_inline = time_calls(bytes, [&](size_t) { return size_t(zero_loop(zeros.data(), bytes)); });
+		double zero_kernel = time_calls(bytes, [&](size_t) { return size_t(memory.is_zero(zeros.data(), bytes)); });
+
+		std::printf("%10zu | %8.1f %8.1f %8.1f | %8.1f %8.1f | %8.1f %8.1f %8.1f | %8.1f %8.1f\n", bytes, fill_inline, fill_libc, fill_kernel,
+			copy_libc, copy_kernel, compare_inline, compare_libc, compare_kernel, zero_inline, zero_kernel);
+		fill.add(bytes, fill_inline, fill_kernel);
+		compare.add(bytes, compare_inline, compare_kernel);
+		zero.add(bytes, zero_inline, zero_kernel);
+	}
+
+	std::printf("\nThresholds for Memory.h on this host:\n");
+	fill.print();
+	compare.print();
+	zero.print();
+	return 0;
+}
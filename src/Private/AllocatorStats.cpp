@@ -0,0 +1,88 @@
+#include "AllocatorStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace devsw::stl {
+	namespace {
+		std::atomic<bool> tracing{ false };
+		std::atomic<uint32_t> sample_period{ 1 };
+		std::atomic<uint64_t> next_record{ 0 };
+		std::atomic<uint64_t> dropped_records{ 0 };
+		std::mutex control; // start, stop and dump
+		AllocationTrace::TraceRecord* records = nullptr; // Never freed, a sampling thread may still be writing to it
+		size_t record_capacity = 0;
+		std::chrono::steady_clock::time_point started;
+
+		thread_local uint32_t countdown = 0;
+	}
+
+	void AllocationTrace::start(uint32_t sample_every, size_t capacity) {
+		std::lock_guard<std::mutex> lock(control);
+		if (!records) {
+			records = new (std::nothrow) TraceRecord[capacity];
+			if (!records) {
+				//TODO Errors...
+				return;
+			}
+			record_capacity = capacity;
+		}
+		sample_period.store(sample_every ? sample_every : 1, std::memory_order_relaxed);
+		next_record.store(0, std::memory_order_relaxed);
+		dropped_records.store(0, std::memory_order_relaxed);
+		started = std::chrono::steady_clock::now();
+		tracing.store(true, std::memory_order_release);
+	}
+
+	void AllocationTrace::stop() {
+		tracing.store(false, std::memory_order_release);
+	}
+
+	bool AllocationTrace::active() {
+		return tracing.load(std::memory_order_acquire);
+	}
+
+	size_t AllocationTrace::recorded() {
+		uint64_t next = next_record.load(std::memory_order_acquire);
+		return static_cast<size_t>(next < record_capacity ? next : record_capacity);
+	}
+
+	bool AllocationTrace::dump(const char* path) {
+		std::lock_guard<std::mutex> lock(control);
+		FILE* file = std::fopen(path, "wb");
+		if (!file) return false;
+		TraceHeader header = {};
+		std::memcpy(header.magic, "DEVSWTRC", sizeof(header.magic));
+		header.version = 1;
+		header.record_size = sizeof(TraceRecord);
+		header.sample_every = sample_period.load(std::memory_order_relaxed);
+		header.records = recorded();
+		header.dropped = dropped_records.load(std::memory_order_relaxed);
+		header.anchor = reinterpret_cast<uint64_t>(&AllocationTrace::dump);
+		bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+		if (written && header.records) written = std::fwrite(records, sizeof(TraceRecord), header.records, file) == header.records;
+		return std::fclose(file) == 0 && written;
+	}
+
+	void AllocationTrace::sample(const void* allocator, size_t bytes, const void* site) {
+		if (!tracing.load(std::memory_order_acquire)) return; // Pairs with start, which publishes records before tracing
+		if (countdown > 1) {
+			--countdown;
+			return;
+		}
+		countdown = sample_period.load(std::memory_order_relaxed);
+		uint64_t index = next_record.fetch_add(1, std::memory_order_relaxed);
+		if (index >= record_capacity) {
+			dropped_records.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		TraceRecord& record = records[index];
+		record.time_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+		record.site = reinterpret_cast<uint64_t>(site);
+		record.allocator = reinterpret_cast<uint64_t>(allocator);
+		record.bytes = bytes;
+	}
+}
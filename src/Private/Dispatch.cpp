@@ -0,0 +1,282 @@
+#include "Dispatch.h"
+#include "Kernels.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace devsw::stl {
+	namespace {
+		void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+			int out[4];
+			__cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+			for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(out[i]);
+#else
+			__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		}
+
+		// XCR0, i.e. which register files the OS actually saves
+		uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t lo, hi;
+			__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+			return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+		}
+
+		CpuFeatures detect() {
+			CpuFeatures f;
+			uint32_t regs[4];
+			cpuid(0, 0, regs);
+			uint32_t max_leaf = regs[0];
+			if (max_leaf < 1) return f;
+
+			cpuid(1, 0, regs);
+			f.sse42 = (regs[2] >> 20) & 1;
+			f.popcnt = (regs[2] >> 23) & 1;
+			bool osxsave = (regs[2] >> 27) & 1;
+			bool avx = (regs[2] >> 28) & 1;
+			bool fma = (regs[2] >> 12) & 1;
+			bool f16c = (regs[2] >> 29) & 1;
+
+			uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+			bool ymm_state = (xcr0 & 0x6) == 0x6;       // XMM + YMM
+			bool zmm_state = (xcr0 & 0xE6) == 0xE6;     // + opmask, ZMM_Hi256, Hi16_ZMM
+
+			f.avx = avx && ymm_state;
+			f.fma = fma && f.avx;
+			f.f16c = f16c && f.avx;
+			if (max_leaf < 7) return f;
+
+			cpuid(7, 0, regs);
+			f.avx2 = ((regs[1] >> 5) & 1) && f.avx;
+			f.bmi2 = (regs[1] >> 8) & 1;
+			f.erms = (regs[1] >> 9) & 1;
+			f.fsrm = (regs[3] >> 4) & 1;
+			if (zmm_state) {
+				f.avx512f = (regs[1] >> 16) & 1;
+				f.avx512dq = (regs[1] >> 17) & 1;
+				f.avx512cd = (regs[1] >> 28) & 1;
+				f.avx512bw = (regs[1] >> 30) & 1;
+				f.avx512vl = (regs[1] >> 31) & 1;
+				f.avx512vnni = (regs[2] >> 11) & 1;
+			}
+			return f;
+		}
+
+		// Largest data or unified cache from the deterministic cache parameters, leaf 4 on Intel and 0x8000001D on AMD
+		// (which reports nothing under leaf 4). Each subleaf is one cache until the type field reads 0
+		size_t last_level_cache() {
+			uint32_t regs[4];
+			size_t largest = 0;
+			auto scan = [&](uint32_t leaf) {
+				for (uint32_t index = 0; index < 16; ++index) {
+					cpuid(leaf, index, regs);
+					uint32_t type = regs[0] & 0x1F;
+					if (type == 0) break;
+					if (type == 2) continue; // Instruction cache
+					size_t ways = ((regs[1] >> 22) & 0x3FF) + 1;
+					size_t partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+					size_t line = (regs[1] & 0xFFF) + 1;
+					size_t sets = static_cast<size_t>(regs[2]) + 1;
+					size_t bytes = ways * partitions * line * sets;
+					if (bytes > largest) largest = bytes;
+				}
+			};
+			cpuid(0, 0, regs);
+			if (regs[0] >= 4) scan(4);
+			if (largest == 0) {
+				cpuid(0x80000000, 0, regs);
+				if (regs[0] >= 0x8000001D) scan(0x8000001D);
+			}
+			return largest;
+		}
+
+		// Every extension a tier's kernels are compiled with (see CMakeLists.txt), or the table could raise SIGILL
+		SimdTier best_tier(const CpuFeatures& f) {
+			if (f.avx512f && f.avx512bw && f.avx512cd && f.avx512dq && f.avx512vl && f.avx2 && f.fma && f.f16c && f.bmi2) return SimdTier::AVX512;
+			if (f.avx2 && f.fma && f.f16c && f.bmi2) return SimdTier::AVX2;
+			if (f.sse42 && f.popcnt) return SimdTier::SSE42;
+			return SimdTier::Scalar;
+		}
+
+		bool parse_tier(const char* name, SimdTier& tier) {
+			struct { const char* name; SimdTier tier; } const names[] = {
+				{ "scalar", SimdTier::Scalar }, { "sse42", SimdTier::SSE42 }, { "sse4.2", SimdTier::SSE42 },
+				{ "avx2", SimdTier::AVX2 }, { "avx512", SimdTier::AVX512 },
+			};
+			for (const auto& entry : names) {
+				if (std::strcmp(name, entry.name) == 0) {
+					tier = entry.tier;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// StoreMode::Auto threshold when CPUID reports no cache sizes
+		constexpr size_t DEFAULT_STREAMING_THRESHOLD = size_t(32) << 20;
+
+		std::once_flag detect_once;
+		CpuFeatures cpu_features;
+		SimdTier host_tier = SimdTier::Scalar;
+		std::atomic<SimdTier> current_tier{ SimdTier::Scalar };
+		std::atomic<size_t> streaming_bytes{ DEFAULT_STREAMING_THRESHOLD };
+
+		template <typename T>
+		std::atomic<const KernelTable<T>*> bound_table{ nullptr };
+
+		template <typename T>
+		const KernelTable<T>* table_for(SimdTier tier) {
+			static const KernelTable<T> tables[] = {
+				kernels::scalar_table<T>(),
+				kernels::sse42_table<T>(),
+				kernels::avx2_table<T>(),
+				kernels::avx512_table<T>(),
+			};
+			return &tables[static_cast<size_t>(tier)];
+		}
+
+		std::atomic<const ConvertTable*> bound_conversions{ nullptr };
+		std::atomic<const MemoryTable*> bound_memory{ nullptr };
+
+		const ConvertTable* conversions_for(SimdTier tier) {
+			static const ConvertTable tables[] = {
+				kernels::scalar_convert_table(),
+				kernels::sse42_convert_table(),
+				kernels::avx2_convert_table(),
+				kernels::avx512_convert_table(),
+			};
+			static const ConvertTable vnni = kernels::avx512_vnni_convert_table();
+			if (tier == SimdTier::AVX512 && cpu_features.avx512vnni) return &vnni;
+			return &tables[static_cast<size_t>(tier)];
+		}
+
+		const MemoryTable* memory_for(SimdTier tier) {
+			static const MemoryTable tables[] = {
+				kernels::scalar_memory_table(cpu_features.erms),
+				kernels::sse42_memory_table(cpu_features.erms),
+				kernels::avx2_memory_table(cpu_features.erms),
+				kernels::avx512_memory_table(cpu_features.erms),
+			};
+			return &tables[static_cast<size_t>(tier)];
+		}
+
+		void bind(SimdTier tier) {
+			current_tier.store(tier, std::memory_order_relaxed);
+#define DEVSW_BIND_TABLE(T) bound_table<T>.store(table_for<T>(tier), std::memory_order_release);
+			DEVSW_KERNEL_TYPES(DEVSW_BIND_TABLE)
+#undef DEVSW_BIND_TABLE
+			bound_conversions.store(conversions_for(tier), std::memory_order_release);
+			bound_memory.store(memory_for(tier), std::memory_order_release);
+		}
+
+		void detect_host() {
+			std::call_once(detect_once, [] {
+				cpu_features = detect();
+				cpu_features.last_level_cache = last_level_cache();
+				host_tier = best_tier(cpu_features);
+				size_t threshold = cpu_features.last_level_cache ? cpu_features.last_level_cache : DEFAULT_STREAMING_THRESHOLD;
+				if (const char* forced = std::getenv("DEVSW_STREAMING_THRESHOLD")) {
+					char* end;
+					unsigned long long bytes = std::strtoull(forced, &end, 10);
+					if (end != forced) threshold = static_cast<size_t>(bytes);
+				}
+				streaming_bytes.store(threshold, std::memory_order_relaxed);
+			});
+		}
+	}
+
+	void Dispatch::init() {
+		detect_host();
+		SimdTier tier = host_tier;
+		if (const char* forced = std::getenv("DEVSW_SIMD_TIER")) {
+			SimdTier requested;
+			if (parse_tier(forced, requested) && requested < tier) tier = requested;
+		}
+		bind(tier);
+	}
+
+	const CpuFeatures& Dispatch::features() {
+		detect_host();
+		return cpu_features;
+	}
+
+	SimdTier Dispatch::detected_tier() {
+		detect_host();
+		return host_tier;
+	}
+
+	SimdTier Dispatch::active_tier() {
+		if (!bound_table<float>.load(std::memory_order_acquire)) init();
+		return current_tier.load(std::memory_order_relaxed);
+	}
+
+	void Dispatch::set_tier(SimdTier tier) {
+		detect_host();
+		bind(tier < host_tier ? tier : host_tier);
+	}
+
+	const char* Dispatch::tier_name(SimdTier tier) {
+		switch (tier) {
+		case SimdTier::Scalar: return "scalar";
+		case SimdTier::SSE42: return "sse42";
+		case SimdTier::AVX2: return "avx2";
+		case SimdTier::AVX512: return "avx512";
+		}
+		return "unknown";
+	}
+
+	template <typename T>
+	const KernelTable<T>& Dispatch::kernels() {
+		const KernelTable<T>* table = bound_table<T>.load(std::memory_order_acquire);
+		if (!table) {
+			init();
+			table = bound_table<T>.load(std::memory_order_acquire);
+		}
+		return *table;
+	}
+
+	const ConvertTable& Dispatch::conversions() {
+		const ConvertTable* table = bound_conversions.load(std::memory_order_acquire);
+		if (!table) {
+			init();
+			table = bound_conversions.load(std::memory_order_acquire);
+		}
+		return *table;
+	}
+
+	const MemoryTable& Dispatch::memory() {
+		const MemoryTable* table = bound_memory.load(std::memory_order_acquire);
+		if (!table) {
+			init();
+			table = bound_memory.load(std::memory_order_acquire);
+		}
+		return *table;
+	}
+
+	size_t Dispatch::streaming_threshold() {
+		detect_host();
+		return streaming_bytes.load(std::memory_order_relaxed);
+	}
+
+	void Dispatch::set_streaming_threshold(size_t bytes) {
+		detect_host();
+		streaming_bytes.store(bytes, std::memory_order_relaxed);
+	}
+
+#define DEVSW_INSTANTIATE_KERNELS(T) template const KernelTable<T>& Dispatch::kernels<T>();
+	DEVSW_KERNEL_TYPES(DEVSW_INSTANTIATE_KERNELS)
+#undef DEVSW_INSTANTIATE_KERNELS
+}
@@ -0,0 +1,66 @@
+#include "FrameArena.h"
+
+namespace devsw::stl {
+	FrameArena::FrameArena(size_t block_size) : block_size_(block_size > 4 * sizeof(Block) ? block_size : 4 * sizeof(Block)), finalizers_(nullptr), used_(0) {
+		head_ = static_cast<Block*>(::operator new(block_size_, std::align_val_t(BLOCK_ALIGNMENT)));
+		head_->next = nullptr;
+		head_->size = block_size_;
+		stats_.on_reserve(block_size_);
+		enter(head_);
+	}
+
+	FrameArena::~FrameArena() {
+		reset();
+		current_ = head_;
+		trim();
+		stats_.on_release(head_->size);
+		::operator delete(head_, std::align_val_t(BLOCK_ALIGNMENT));
+	}
+
+	void FrameArena::rewind(const Marker& marker) {
+		while (finalizers_ != marker.finalizers) {
+			Finalizer* finalizer = finalizers_;
+			finalizers_ = finalizer->previous;
+			finalizer->destroy(finalizer->objects, finalizer->count);
+		}
+		if (used_ != marker.used) stats_.on_deallocate(used_ - marker.used);
+		used_ = marker.used;
+		enter(marker.block);
+		top_ = marker.top;
+	}
+
+	void FrameArena::trim() {
+		Block* block = current_->next;
+		current_->next = nullptr;
+		while (block) {
+			Block* next = block->next;
+			stats_.on_release(block->size);
+			::operator delete(block, std::align_val_t(BLOCK_ALIGNMENT));
+			block = next;
+		}
+	}
+
+	void* FrameArena::grow(size_t bytes, size_t alignment) {
+		if (alignment > SIZE_MAX - sizeof(Block) || bytes > SIZE_MAX - sizeof(Block) - alignment) throw std::bad_alloc();
+		size_t needed = sizeof(Block) + bytes + alignment;
+		// The next block was used by an earlier, deeper frame. One too small for this request stays in the chain after the new one
+		Block* next = current_->next;
+		if (!next || next->size < needed) {
+			size_t size = needed > block_size_ ? needed : block_size_;
+			Block* block = static_cast<Block*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT)));
+			block->next = next;
+			block->size = size;
+			current_->next = block;
+			next = block;
+			stats_.on_reserve(size);
+		}
+		enter(next);
+		return allocate(bytes, alignment);
+	}
+
+	void FrameArena::enter(Block* block) {
+		current_ = block;
+		top_ = first_top(block);
+		end_ = reinterpret_cast<uintptr_t>(block) + block->size;
+	}
+}
@@ -0,0 +1,211 @@
+#pragma once
+#include <cstddef>
+
+#include "Simd.h"
+#include "Scratch.h"
+
+namespace devsw::stl::kernels {
+	/**
+	* Blocked GEMM in the usual five-loop layout: C is walked in NC-wide column blocks, k in KC-deep slices, and A in
+	* MC-tall row blocks. Each B slice (KC x NC) and A block (MC x KC) is packed into micro-panels so the micro-kernel
+	* streams both operands with unit stride. The micro-kernel keeps an MR x NR tile of C in registers (NR = two
+	* vectors) and does one broadcast and two FMAs per row per k step.
+	* Block sizes are derived from the tier: the B micro-panel (KC x NR) stays in L1 across the A panels, an A block
+	* fits in about 128 KiB of L2, and a packed B slice in about 2 MiB of L3.
+	* @note Serial by design. Intrinsics::gemm(par, ...) splits C into column slabs and runs one call per slab, each with
+	* its own thread_local packing buffers.
+	*/
+	template <typename S>
+	struct GemmShape {
+		using T = typename S::value_type;
+		// Accumulators plus two B vectors and the A broadcast have to fit the register file: 32 zmm, 16 ymm/xmm
+		static constexpr size_t MR = sizeof(typename S::reg) == 64 ? 12 : (sizeof(typename S::reg) >= 16 ? 6 : 4);
+		static constexpr size_t NR = 2 * S::lanes;
+		static constexpr size_t KC = (16 * 1024) / (NR * sizeof(T));
+		static constexpr size_t MC = ((128 * 1024) / (KC * sizeof(T))) / MR * MR;
+		static constexpr size_t NC = ((2 * 1024 * 1024) / (KC * sizeof(T))) / NR * NR;
+	};
+
+	// Ap[panel][p][r] = A[ic + panel * MR + r][pc + p], rows past m zero filled
+	template <typename S>
+	void pack_a(typename S::value_type* packed, const typename S::value_type* a, size_t lda, size_t mc, size_t kc) {
+		using T = typename S::value_type;
+		constexpr size_t MR = GemmShape<S>::MR;
+		for (size_t ir = 0; ir < mc; ir += MR) {
+			size_t rows = mc - ir < MR ? mc - ir : MR;
+			T* panel = packed + ir * kc;
+			for (size_t r = 0; r < rows; ++r) {
+				const T* src = a + (ir + r) * lda;
+				for (size_t p = 0; p < kc; ++p) panel[p * MR + r] = src[p];
+			}
+			for (size_t r = rows; r < MR; ++r)
+				for (size_t p = 0; p < kc; ++p) panel[p * MR + r] = T(0);
+		}
+	}
+
+	// Bp[panel][p][j] = B[pc + p][jc + panel * NR + j], columns past n zero filled
+	template <typename S>
+	void pack_b(typename S::value_type* packed, const typename S::value_type* b, size_t ldb, size_t kc, size_t nc) {
+		using T = typename S::value_type;
+		constexpr size_t NR = GemmShape<S>::NR;
+		for (size_t jr = 0; jr < nc; jr += NR) {
+			size_t cols = nc - jr < NR ? nc - jr : NR;
+			T* panel = packed + jr * kc;
+			for (size_t p = 0; p < kc; ++p) {
+				const T* src = b + p * ldb + jr;
+				T* dst = panel + p * NR;
+				if (cols == NR) {
+					S::storeu(dst, S::loadu(src));
+					S::storeu(dst + S::lanes, S::loadu(src + S::lanes));
+				}
+				else {
+					size_t low = cols < S::lanes ? cols : S::lanes;
+					S::storeu(dst, S::load_partial(src, low));
+					S::storeu(dst + S::lanes, cols > S::lanes ? S::load_partial(src + S::lanes, cols - S::lanes) : S::zero());
+				}
+			}
+		}
+	}
+
+	// C[0, mr) x [0, nr) = alpha * Ap * Bp + beta * C. beta == 0 never reads C, so it may hold NaNs
+	template <typename S>
+	FORCEINLINE void gemm_micro_kernel(size_t kc, const typename S::value_type* ap, const typename S::value_type* bp,
+		typename S::value_type* c, size_t ldc, typename S::value_type alpha, typename S::value_type beta, size_t mr, size_t nr) {
+		using T = typename S::value_type;
+		using reg = typename S::reg;
+		constexpr size_t MR = GemmShape<S>::MR;
+		constexpr size_t NR = GemmShape<S>::NR;
+
+		reg acc0[MR];
+		reg acc1[MR];
+		for (size_t r = 0; r < MR; ++r) acc0[r] = acc1[r] = S::zero();
+		for (size_t p = 0; p < kc; ++p) {
+			reg b0 = S::load(bp);
+			reg b1 = S::load(bp + S::lanes);
+			for (size_t r = 0; r < MR; ++r) {
+				reg a = S::set1(ap[r]);
+				acc0[r] = S::fmadd(a, b0, acc0[r]);
+				acc1[r] = S::fmadd(a, b1, acc1[r]);
+			}
+			ap += MR;
+			bp += NR;
+		}
+
+		reg va = S::set1(alpha);
+		if (mr == MR && nr == NR) {
+			reg vb = S::set1(beta);
+			for (size_t r = 0; r < MR; ++r) {
+				T* line = c + r * ldc;
+				if (beta == T(0)) {
+					S::storeu(line, S::mul(va, acc0[r]));
+					S::storeu(line + S::lanes, S::mul(va, acc1[r]));
+				}
+				else {
+					S::storeu(line, S::fmadd(va, acc0[r], S::mul(vb, S::loadu(line))));
+					S::storeu(line + S::lanes, S::fmadd(va, acc1[r], S::mul(vb, S::loadu(line + S::lanes))));
+				}
+			}
+			return;
+		}
+		// Edge tile, spill and copy the part that exists
+		alignas(64) T tile[MR * NR];
+		for (size_t r = 0; r < MR; ++r) {
+			S::storeu(tile + r * NR, S::mul(va, acc0[r]));
+			S::storeu(tile + r * NR + S::lanes, S::mul(va, acc1[r]));
+		}
+		for (size_t r = 0; r < mr; ++r) {
+			T* line = c + r * ldc;
+			for (size_t j = 0; j < nr; ++j) line[j] = beta == T(0) ? tile[r * NR + j] : tile[r * NR + j] + beta * line[j];
+		}
+	}
+
+	// C = alpha * A * B + beta * C, all row-major with leading dimensions lda, ldb, ldc. A is m x k, B is k x n
+	template <template <typename> class V, typename T>
+	void gemm(size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc) {
+		using S = V<T>;
+		using Shape = GemmShape<S>;
+		if (m == 0 || n == 0) return;
+		if (k == 0 || alpha == T(0)) {
+			for (size_t i = 0; i < m; ++i)
+				for (size_t j = 0; j < n; ++j) c[i * ldc + j] = beta == T(0) ? T(0) : beta * c[i * ldc + j];
+			return;
+		}
+
+		thread_local Scratch<S> packed_a;
+		thread_local Scratch<S> packed_b;
+		size_t kc_max = k < Shape::KC ? k : Shape::KC;
+		size_t mc_max = m < Shape::MC ? m : Shape::MC;
+		size_t nc_max = n < Shape::NC ? n : Shape::NC;
+		packed_a.reserve(((mc_max + Shape::MR - 1) / Shape::MR) * Shape::MR * kc_max);
+		packed_b.reserve(((nc_max + Shape::NR - 1) / Shape::NR) * Shape::NR * kc_max);
+		T* ap = packed_a.begin();
+		T* bp = packed_b.begin();
+
+		for (size_t jc = 0; jc < n; jc += Shape::NC) {
+			size_t nc = n - jc < Shape::NC ? n - jc : Shape::NC;
+			for (size_t pc = 0; pc < k; pc += Shape::KC) {
+				size_t kc = k - pc < Shape::KC ? k - pc : Shape::KC;
+				// Later k slices accumulate onto what the first one wrote
+				T beta_slice = pc == 0 ? beta : T(1);
+				pack_b<S>(bp, b + pc * ldb + jc, ldb, kc, nc);
+				for (size_t ic = 0; ic < m; ic += Shape::MC) {
+					size_t mc = m - ic < Shape::MC ? m - ic : Shape::MC;
+					pack_a<S>(ap, a + ic * lda + pc, lda, mc, kc);
+					for (size_t jr = 0; jr < nc; jr += Shape::NR) {
+						size_t nr = nc - jr < Shape::NR ? nc - jr : Shape::NR;
+						for (size_t ir = 0; ir < mc; ir += Shape::MR) {
+							size_t mr = mc - ir < Shape::MR ? mc - ir : Shape::MR;
+							gemm_micro_kernel<S>(kc, ap + ir * kc, bp + jr * kc, c + (ic + ir) * ldc + jc + jr, ldc, alpha, beta_slice, mr, nr);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// y = alpha * A * x + beta * y, A row-major m x n. Four rows share every load of x
+	template <template <typename> class V, typename T>
+	void gemv(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) {
+		using S = V<T>;
+		using reg = typename S::reg;
+		constexpr size_t ROWS = 4;
+		size_t simd_end = n & ~(S::lanes - 1);
+		auto finish = [&](size_t i, T dot) { y[i] = beta == T(0) ? alpha * dot : alpha * dot + beta * y[i]; };
+		size_t i = 0;
+		for (; i + ROWS <= m; i += ROWS) {
+			const T* a0 = a + i * lda;
+			const T* a1 = a0 + lda;
+			const T* a2 = a1 + lda;
+			const T* a3 = a2 + lda;
+			reg acc0 = S::zero(), acc1 = S::zero(), acc2 = S::zero(), acc3 = S::zero();
+			size_t j = 0;
+			for (; j < simd_end; j += S::lanes) {
+				reg xv = S::loadu(x + j);
+				acc0 = S::fmadd(S::loadu(a0 + j), xv, acc0);
+				acc1 = S::fmadd(S::loadu(a1 + j), xv, acc1);
+				acc2 = S::fmadd(S::loadu(a2 + j), xv, acc2);
+				acc3 = S::fmadd(S::loadu(a3 + j), xv, acc3);
+			}
+			if (j < n) {
+				size_t rest = n - j;
+				reg xv = S::load_partial(x + j, rest);
+				acc0 = S::fmadd(S::load_partial(a0 + j, rest), xv, acc0);
+				acc1 = S::fmadd(S::load_partial(a1 + j, rest), xv, acc1);
+				acc2 = S::fmadd(S::load_partial(a2 + j, rest), xv, acc2);
+				acc3 = S::fmadd(S::load_partial(a3 + j, rest), xv, acc3);
+			}
+			finish(i, S::reduce_add(acc0));
+			finish(i + 1, S::reduce_add(acc1));
+			finish(i + 2, S::reduce_add(acc2));
+			finish(i + 3, S::reduce_add(acc3));
+		}
+		for (; i < m; ++i) {
+			const T* a0 = a + i * lda;
+			reg acc = S::zero();
+			size_t j = 0;
+			for (; j < simd_end; j += S::lanes) acc = S::fmadd(S::loadu(a0 + j), S::loadu(x + j), acc);
+			if (j < n) acc = S::fmadd(S::load_partial(a0 + j, n - j), S::load_partial(x + j, n - j), acc);
+			finish(i, S::reduce_add(acc));
+		}
+	}
+}
@@ -0,0 +1,1160 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#include "Dispatch.h"
+#include "Simd.h"
+#include "SimdMath.h"
+#include "Gemm.h"
+#include "Sort.h"
+#include "Scratch.h"
+
+// Element types every tier instantiates its kernel table for
+#define DEVSW_KERNEL_TYPES(X) \
+	X(float) X(double) \
+	X(int8_t) X(uint8_t) X(int16_t) X(uint16_t) \
+	X(int32_t) X(uint32_t) X(int64_t) X(uint64_t)
+
+namespace devsw::stl::kernels {
+	/**
+	* Tier-agnostic kernel bodies. V is one of SimdScalar/SimdSSE42/SimdAVX2/SimdAVX512 and every function here is
+	* templated on it, so each tier translation unit (built with its own -m or /arch flags) gets its own symbols.
+	* The last n % lanes elements are one masked step (load_partial/store_partial) rather than a scalar loop, which is
+	* most of the win on the 17-100 element vectors that dominate some workloads.
+	* @note Nothing in this header may be instantiated outside a Kernels*.cpp file.
+	*/
+
+	// Elements before dest reaches a register boundary, done as one masked step so the stores of the main loop never
+	// split a cache line. Always 0 on AlignedVector storage, and on pointers not even aligned to sizeof(T)
+	template <typename S>
+	FORCEINLINE size_t peel(const typename S::value_type* dest, size_t n) {
+		constexpr size_t bytes = S::lanes * sizeof(typename S::value_type);
+		size_t offset = reinterpret_cast<uintptr_t>(dest) % bytes;
+		if (offset == 0 || offset % sizeof(typename S::value_type)) return 0;
+		size_t count = (bytes - offset) / sizeof(typename S::value_type);
+		return count < n ? count : n;
+	}
+
+	// Main loop of the element-wise kernels, dest[i, end) = f(i) one whole register at a time from a register boundary.
+	// Non-temporal when stream is set and dest + i really is register aligned (peel gives up on pointers not even
+	// aligned to sizeof(T)), so a pass over more data than the cache holds does not leave it full of dest lines
+	template <typename S, typename F>
+	FORCEINLINE size_t store_run(typename S::value_type* dest, size_t i, size_t end, bool stream, F&& f) {
+		if (stream && reinterpret_cast<uintptr_t>(dest + i) % (S::lanes * sizeof(typename S::value_type)) == 0) {
+			for (; i < end; i += S::lanes)
+				S::stream(dest + i, f(i));
+			S::fence();
+		}
+		else {
+			for (; i < end; i += S::lanes)
+				S::storeu(dest + i, f(i));
+		}
+		return i;
+	}
+
+	// dest[i] = Op(dest[i], src[i])
+	template <template <typename> class V, typename T, typename Op>
+	void binary(T* dest, const T* src, size_t n, bool stream) {
+		using S = V<T>;
+		size_t i = peel<S>(dest, n);
+		if (i) S::store_partial(dest, Op::template apply<S>(S::load_partial(dest, i), S::load_partial(src, i)), i);
+		size_t simd_end = i + ((n - i) & ~(S::lanes - 1));
+		i = store_run<S>(dest, i, simd_end, stream, [&](size_t j) { return Op::template apply<S>(S::loadu(dest + j), S::loadu(src + j)); });
+		if (i < n) {
+			size_t rest = n - i;
+			S::store_partial(dest + i, Op::template apply<S>(S::load_partial(dest + i, rest), S::load_partial(src + i, rest)), rest);
+		}
+	}
+
+	// dest[i] = Op(dest[i])
+	template <template <typename> class V, typename T, typename Op>
+	void unary(T* dest, size_t n, bool stream) {
+		using S = V<T>;
+		size_t i = peel<S>(dest, n);
+		if (i) S::store_partial(dest, Op::template apply<S>(S::load_partial(dest, i)), i);
+		size_t simd_end = i + ((n - i) & ~(S::lanes - 1));
+		i = store_run<S>(dest, i, simd_end, stream, [&](size_t j) { return Op::template apply<S>(S::loadu(dest + j)); });
+		if (i < n) S::store_partial(dest + i, Op::template apply<S>(S::load_partial(dest + i, n - i)), n - i);
+	}
+
+	template <template <typename> class V, typename T>
+	T dot_product(const T* a, const T* b, size_t n) {
+		using S = V<T>;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		typename S::reg sum = S::zero();
+		for (; i < simd_end; i += S::lanes)
+			sum = S::fmadd(S::loadu(a + i), S::loadu(b + i), sum);
+		// Zero filled lanes add nothing
+		if (i < n) sum = S::fmadd(S::load_partial(a + i, n - i), S::load_partial(b + i, n - i), sum);
+		return S::reduce_add(sum);
+	}
+
+	// dest[i] = a[i] * b[i] + dest[i]
+	template <template <typename> class V, typename T>
+	void fmadd(T* dest, const T* a, const T* b, size_t n, bool stream) {
+		using S = V<T>;
+		size_t i = peel<S>(dest, n);
+		if (i) S::store_partial(dest, S::fmadd(S::load_partial(a, i), S::load_partial(b, i), S::load_partial(dest, i)), i);
+		size_t simd_end = i + ((n - i) & ~(S::lanes - 1));
+		i = store_run<S>(dest, i, simd_end, stream, [&](size_t j) { return S::fmadd(S::loadu(a + j), S::loadu(b + j), S::loadu(dest + j)); });
+		if (i < n) {
+			size_t rest = n - i;
+			S::store_partial(dest + i, S::fmadd(S::load_partial(a + i, rest), S::load_partial(b + i, rest), S::load_partial(dest + i, rest)), rest);
+		}
+	}
+
+	// ================= Reductions =================
+	// Four independent accumulators per loop so the add/fma latency chain does not bound throughput
+	constexpr size_t ACCUMULATORS = 4;
+	// Leaf size of the pairwise sum, small enough that the flat sum below it keeps its error in check
+	constexpr size_t PAIRWISE_BLOCK = 256;
+	// Elements reduced per block while searching for argmin/argmax, only the winning block is rescanned
+	constexpr size_t ARG_BLOCK = 1024;
+
+	// One vector folded into the accumulator lanes, integer lanes are widened to 64 bits first
+	template <template <typename> class V, typename T>
+	FORCEINLINE typename V<sum_t<T>>::reg widen(typename V<T>::reg v) {
+		if constexpr (std::is_floating_point_v<T>) return v;
+		else return V<T>::sum_wide(v);
+	}
+
+	template <template <typename> class V, typename T>
+	sum_t<T> sum(const T* src, size_t n) {
+		using S = V<T>;
+		using A = V<sum_t<T>>;
+		constexpr size_t step = S::lanes * ACCUMULATORS;
+		size_t unrolled_end = n - n % step;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		typename A::reg acc0 = A::zero(), acc1 = A::zero(), acc2 = A::zero(), acc3 = A::zero();
+		for (; i < unrolled_end; i += step) {
+			acc0 = A::add(acc0, widen<V, T>(S::loadu(src + i)));
+			acc1 = A::add(acc1, widen<V, T>(S::loadu(src + i + S::lanes)));
+			acc2 = A::add(acc2, widen<V, T>(S::loadu(src + i + 2 * S::lanes)));
+			acc3 = A::add(acc3, widen<V, T>(S::loadu(src + i + 3 * S::lanes)));
+		}
+		for (; i < simd_end; i += S::lanes)
+			acc0 = A::add(acc0, widen<V, T>(S::loadu(src + i)));
+		if (i < n) acc1 = A::add(acc1, widen<V, T>(S::load_partial(src + i, n - i)));
+		return A::reduce_add(A::add(A::add(acc0, acc1), A::add(acc2, acc3)));
+	}
+
+	// Recursive halving, error grows with log(n) instead of n
+	template <template <typename> class V, typename T>
+	T sum_pairwise(const T* src, size_t n) {
+		if (n <= PAIRWISE_BLOCK) return sum<V, T>(src, n);
+		size_t half = (n / 2) & ~(V<T>::lanes - 1);
+		return sum_pairwise<V, T>(src, half) + sum_pairwise<V, T>(src + half, n - half);
+	}
+
+	// Kahan summation per lane, the lanes are then folded with a scalar Kahan pass
+	template <template <typename> class V, typename T>
+	T sum_kahan(const T* src, size_t n) {
+		using S = V<T>;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		typename S::reg total = S::zero(), compensation = S::zero();
+		auto accumulate_lanes = [&](typename S::reg value) {
+			typename S::reg y = S::sub(value, compensation);
+			typename S::reg t = S::add(total, y);
+			compensation = S::sub(S::sub(t, total), y);
+			total = t;
+		};
+		for (; i < simd_end; i += S::lanes) accumulate_lanes(S::loadu(src + i));
+		// Zero filled lanes past n leave the running sums alone
+		if (i < n) accumulate_lanes(S::load_partial(src + i, n - i));
+		alignas(64) T lane_total[S::lanes];
+		alignas(64) T lane_compensation[S::lanes];
+		S::storeu(lane_total, total);
+		S::storeu(lane_compensation, compensation);
+
+		T result = 0, c = 0;
+		auto accumulate = [&](T value) {
+			T y = value - c;
+			T t = result + y;
+			c = (t - result) - y;
+			result = t;
+		};
+		for (size_t lane = 0; lane < S::lanes; ++lane) {
+			accumulate(lane_total[lane]);
+			accumulate(-lane_compensation[lane]);
+		}
+		return result;
+	}
+
+	// Op is SimdMin or SimdMax, n > 0
+	template <template <typename> class V, typename T, typename Op>
+	T reduce(const T* src, size_t n) {
+		using S = V<T>;
+		if (n < S::lanes) {
+			T result = src[0];
+			for (size_t i = 1; i < n; ++i) result = Op::template apply<SimdScalar<T>>(result, src[i]);
+			return result;
+		}
+		constexpr size_t step = S::lanes * ACCUMULATORS;
+		size_t unrolled_end = n - n % step;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		// Seeding every accumulator with the first vector avoids needing an identity value per type
+		typename S::reg acc0 = S::loadu(src), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+		for (; i < unrolled_end; i += step) {
+			acc0 = Op::template apply<S>(acc0, S::loadu(src + i));
+			acc1 = Op::template apply<S>(acc1, S::loadu(src + i + S::lanes));
+			acc2 = Op::template apply<S>(acc2, S::loadu(src + i + 2 * S::lanes));
+			acc3 = Op::template apply<S>(acc3, S::loadu(src + i + 3 * S::lanes));
+		}
+		for (; i < simd_end; i += S::lanes)
+			acc0 = Op::template apply<S>(acc0, S::loadu(src + i));
+		typename S::reg folded = Op::template apply<S>(Op::template apply<S>(acc0, acc1), Op::template apply<S>(acc2, acc3));
+		// min/max are idempotent, so the tail is just the last full vector again, overlapping what was already seen
+		if (i < n) folded = Op::template apply<S>(folded, S::loadu(src + n - S::lanes));
+		if constexpr (std::is_same_v<Op, SimdMin>) return S::reduce_min(folded);
+		else return S::reduce_max(folded);
+	}
+
+	// First index of the extreme value: SIMD-reduce fixed blocks, then rescan only the block that won
+	template <template <typename> class V, typename T, typename Op>
+	size_t arg_reduce(const T* src, size_t n) {
+		auto improves = [](T candidate, T best) {
+			if constexpr (std::is_same_v<Op, SimdMin>) return candidate < best;
+			else return candidate > best;
+		};
+		T best = reduce<V, T, Op>(src, n < ARG_BLOCK ? n : ARG_BLOCK);
+		size_t best_block = 0;
+		for (size_t start = ARG_BLOCK; start < n; start += ARG_BLOCK) {
+			T candidate = reduce<V, T, Op>(src + start, n - start < ARG_BLOCK ? n - start : ARG_BLOCK);
+			if (improves(candidate, best)) {
+				best = candidate;
+				best_block = start;
+			}
+		}
+		size_t end = n - best_block < ARG_BLOCK ? n : best_block + ARG_BLOCK;
+		for (size_t i = best_block; i < end; ++i) {
+			if (src[i] == best) return i;
+		}
+		return best_block; // Only reachable with NaNs in the block
+	}
+
+	// sum((x - center)^2) in real_t<T>, integers are converted a block at a time into a stack buffer
+	template <template <typename> class V, typename T>
+	real_t<T> sum_squared_deviation(const T* src, size_t n, real_t<T> center) {
+		using R = real_t<T>;
+		using S = V<R>;
+		if constexpr (!std::is_same_v<T, R>) {
+			constexpr size_t block = 256;
+			alignas(64) R buffer[block];
+			R result = 0;
+			for (size_t start = 0; start < n; start += block) {
+				size_t count = n - start < block ? n - start : block;
+				for (size_t j = 0; j < count; ++j) buffer[j] = static_cast<R>(src[start + j]);
+				result += sum_squared_deviation<V, R>(buffer, count, center);
+			}
+			return result;
+		}
+		else {
+			constexpr size_t step = S::lanes * ACCUMULATORS;
+			size_t unrolled_end = n - n % step;
+			size_t simd_end = n & ~(S::lanes - 1);
+			size_t i = 0;
+			typename S::reg c = S::set1(center);
+			typename S::reg acc0 = S::zero(), acc1 = S::zero(), acc2 = S::zero(), acc3 = S::zero();
+			for (; i < unrolled_end; i += step) {
+				typename S::reg d0 = S::sub(S::loadu(src + i), c);
+				typename S::reg d1 = S::sub(S::loadu(src + i + S::lanes), c);
+				typename S::reg d2 = S::sub(S::loadu(src + i + 2 * S::lanes), c);
+				typename S::reg d3 = S::sub(S::loadu(src + i + 3 * S::lanes), c);
+				acc0 = S::fmadd(d0, d0, acc0);
+				acc1 = S::fmadd(d1, d1, acc1);
+				acc2 = S::fmadd(d2, d2, acc2);
+				acc3 = S::fmadd(d3, d3, acc3);
+			}
+			for (; i < simd_end; i += S::lanes) {
+				typename S::reg d = S::sub(S::loadu(src + i), c);
+				acc0 = S::fmadd(d, d, acc0);
+			}
+			// Lanes past n are filled with the center, so their deviation is exactly zero
+			if (i < n) {
+				typename S::reg d = S::sub(S::load_partial(src + i, n - i, c), c);
+				acc1 = S::fmadd(d, d, acc1);
+			}
+			return S::reduce_add(S::add(S::add(acc0, acc1), S::add(acc2, acc3)));
+		}
+	}
+
+	// ================= Compare =================
+	// Right-hand operands of compare: another array, or one value broadcast once
+	template <typename S>
+	struct ArrayOperand {
+		const typename S::value_type* data;
+		FORCEINLINE typename S::reg load(size_t i) const { return S::loadu(data + i); }
+		FORCEINLINE typename S::reg load_partial(size_t i, size_t count) const { return S::load_partial(data + i, count); }
+	};
+
+	template <typename S>
+	struct BroadcastOperand {
+		typename S::reg value;
+		FORCEINLINE typename S::reg load(size_t) const { return value; }
+		FORCEINLINE typename S::reg load_partial(size_t, size_t) const { return value; }
+	};
+
+	// One 64-bit word per 64 elements, built from 64 / lanes bitmasks (no tier has more than 64 lanes). The last
+	// partial word is cleared above n so a popcount over the bitset never sees the padding
+	template <typename S, typename Op, typename Rhs>
+	void compare_words(uint64_t* bits, const typename S::value_type* a, const Rhs& rhs, size_t n) {
+		constexpr size_t per_word = 64 / S::lanes;
+		size_t words = n / 64;
+		for (size_t w = 0; w < words; ++w) {
+			size_t base = w * 64;
+			uint64_t word = 0;
+			for (size_t k = 0; k < per_word; ++k) {
+				size_t i = base + k * S::lanes;
+				word |= S::bitmask(Op::template apply<S>(S::loadu(a + i), rhs.load(i))) << (k * S::lanes);
+			}
+			bits[w] = word;
+		}
+		size_t base = words * 64;
+		if (base == n) return;
+		uint64_t word = 0;
+		for (size_t i = base; i < n; i += S::lanes) {
+			size_t count = n - i < S::lanes ? n - i : S::lanes;
+			word |= S::bitmask(Op::template apply<S>(S::load_partial(a + i, count), rhs.load_partial(i, count))) << (i - base);
+		}
+		bits[words] = word & ((uint64_t(1) << (n - base)) - 1);
+	}
+
+	// The predicate is switched on once per call, each case is its own loop
+	template <typename S, typename Rhs>
+	void compare_with(uint64_t* bits, const typename S::value_type* a, const Rhs& rhs, size_t n, Comparison op) {
+		switch (op) {
+		case Comparison::Equal: compare_words<S, SimdCmpEq>(bits, a, rhs, n); break;
+		case Comparison::NotEqual: compare_words<S, SimdCmpNe>(bits, a, rhs, n); break;
+		case Comparison::Less: compare_words<S, SimdCmpLt>(bits, a, rhs, n); break;
+		case Comparison::LessEqual: compare_words<S, SimdCmpLe>(bits, a, rhs, n); break;
+		case Comparison::Greater: compare_words<S, SimdCmpGt>(bits, a, rhs, n); break;
+		case Comparison::GreaterEqual: compare_words<S, SimdCmpGe>(bits, a, rhs, n); break;
+		}
+	}
+
+	template <template <typename> class V, typename T>
+	void compare(uint64_t* bits, const T* a, const T* b, size_t n, Comparison op) {
+		compare_with<V<T>>(bits, a, ArrayOperand<V<T>>{ b }, n, op);
+	}
+
+	template <template <typename> class V, typename T>
+	void compare_scalar(uint64_t* bits, const T* a, T value, size_t n, Comparison op) {
+		compare_with<V<T>>(bits, a, BroadcastOperand<V<T>>{ V<T>::set1(value) }, n, op);
+	}
+
+	// ================= Compress =================
+	// dest[count++] = src[i] for every selected i. mask_of(i, v) gives the selection bits of the vector at i. Each store
+	// lands at dest + count with count <= i, so dest may be src and never needs room beyond n
+	template <typename S, typename MaskOf>
+	size_t compress_loop(typename S::value_type* dest, const typename S::value_type* src, size_t n, MaskOf&& mask_of) {
+		size_t count = 0;
+		size_t i = 0;
+		for (; i + S::lanes <= n; i += S::lanes) {
+			typename S::reg v = S::loadu(src + i);
+			uint64_t m = mask_of(i, v);
+			if constexpr (S::compressible) {
+				S::storeu(dest + count, S::compress(v, m));
+				count += std::popcount(m);
+			}
+			else {
+				// Byte and word lanes: store every lane, advance only past the selected ones. No branch to mispredict
+				for (size_t k = 0; k < S::lanes; ++k) {
+					dest[count] = src[i + k];
+					count += (m >> k) & 1;
+				}
+			}
+		}
+		if (i < n) {
+			size_t rest = n - i;
+			typename S::reg v = S::load_partial(src + i, rest);
+			uint64_t m = mask_of(i, v) & ((uint64_t(2) << (rest - 1)) - 1);
+			if constexpr (S::compressible) {
+				size_t selected = std::popcount(m);
+				S::store_partial(dest + count, S::compress(v, m), selected);
+				count += selected;
+			}
+			else {
+				for (size_t k = 0; k < rest; ++k) {
+					dest[count] = src[i + k];
+					count += (m >> k) & 1;
+				}
+			}
+		}
+		return count;
+	}
+
+	// Selection from a bitset as written by compare
+	template <template <typename> class V, typename T>
+	size_t compress(T* dest, const T* src, const uint64_t* bits, size_t n) {
+		using S = V<T>;
+		constexpr uint64_t lane_bits = S::lanes == 64 ? ~uint64_t(0) : (uint64_t(1) << S::lanes) - 1;
+		return compress_loop<S>(dest, src, n, [bits](size_t i, typename S::reg) { return (bits[i / 64] >> (i % 64)) & lane_bits; });
+	}
+
+	template <typename S, typename Op>
+	size_t compress_where(typename S::value_type* dest, const typename S::value_type* src, typename S::value_type value, size_t n) {
+		typename S::reg rhs = S::set1(value);
+		return compress_loop<S>(dest, src, n, [rhs](size_t, typename S::reg v) { return S::bitmask(Op::template apply<S>(v, rhs)); });
+	}
+
+	// Compare and compress fused, the predicate never round-trips through memory
+	template <template <typename> class V, typename T>
+	size_t compress_scalar(T* dest, const T* src, T value, size_t n, Comparison op) {
+		using S = V<T>;
+		switch (op) {
+		case Comparison::Equal: return compress_where<S, SimdCmpEq>(dest, src, value, n);
+		case Comparison::NotEqual: return compress_where<S, SimdCmpNe>(dest, src, value, n);
+		case Comparison::Less: return compress_where<S, SimdCmpLt>(dest, src, value, n);
+		case Comparison::LessEqual: return compress_where<S, SimdCmpLe>(dest, src, value, n);
+		case Comparison::Greater: return compress_where<S, SimdCmpGt>(dest, src, value, n);
+		case Comparison::GreaterEqual: return compress_where<S, SimdCmpGe>(dest, src, value, n);
+		}
+		return 0;
+	}
+
+	// ================= Scans =================
+	// Each vector is scanned in registers with log2(lanes) shift-and-combine steps, then the carry (the previous
+	// vector's top lane, broadcast) is folded in. The in-register part does not depend on the carry, so the
+	// loop-carried chain is one op and one broadcast per vector
+
+	template <typename T, typename Op>
+	constexpr T scan_identity() {
+		if constexpr (is_same_v<Op, SimdMin>) return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+		else if constexpr (is_same_v<Op, SimdMax>) return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+		else return T(0);
+	}
+
+	template <typename S, typename Op, size_t Shift = 1>
+	FORCEINLINE typename S::reg scan_register(typename S::reg v, typename S::reg identity) {
+		if constexpr (Shift < S::lanes)
+			return scan_register<S, Op, Shift * 2>(Op::template apply<S>(v, S::template shift_up<Shift>(v, identity)), identity);
+		else
+			return v;
+	}
+
+	// dest[i] = init op src[0] op ... op src[i], or up to src[i - 1] when Exclusive. dest may be src
+	template <template <typename> class V, typename T, typename Op, bool Exclusive>
+	void scan(T* dest, const T* src, size_t n, T init) {
+		using S = V<T>;
+		using reg = typename S::reg;
+		reg identity = S::set1(scan_identity<T, Op>());
+		reg carry = S::set1(init);
+		auto step = [&](reg v) {
+			reg inclusive = Op::template apply<S>(scan_register<S, Op>(v, identity), carry);
+			reg out = Exclusive ? S::template shift_up<1>(inclusive, carry) : inclusive;
+			carry = S::broadcast_top(inclusive);
+			return out;
+		};
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		for (; i < simd_end; i += S::lanes) S::storeu(dest + i, step(S::loadu(src + i)));
+		if (i < n) S::store_partial(dest + i, step(S::load_partial(src + i, n - i, identity)), n - i);
+	}
+
+	// ================= Histograms =================
+	// Values are resolved to bin indices on the fly, anything outside [0, bins) landing on the overflow index bins.
+	// Few bins: a run of equal values is a chain of dependent increments on one counter, so consecutive elements go to
+	// HISTOGRAM_COPIES interleaved sub-histograms (each with its own overflow slot) that are summed at the end.
+	// Many bins: the copies no longer fit in L1 and the chains are rare, so counts is updated in place, a block of
+	// indices at a time through vpconflictd where the tier has it
+	constexpr size_t HISTOGRAM_BLOCK = 256;
+	constexpr size_t HISTOGRAM_COPIES = 4;
+	constexpr size_t HISTOGRAM_SUB_BINS = 2048;
+
+	// resolve(i) is the bin index of element i, or bins to skip it
+	template <template <typename> class V, typename Resolve>
+	void histogram_loop(uint32_t* counts, size_t bins, size_t n, Resolve&& resolve) {
+		using U = V<uint32_t>;
+		if (bins <= HISTOGRAM_SUB_BINS && n >= HISTOGRAM_COPIES * bins) {
+			size_t stride = bins + 1;
+			Scratch<U> copies(HISTOGRAM_COPIES * stride);
+			uint32_t* sub = copies.begin();
+			std::memset(sub, 0, HISTOGRAM_COPIES * stride * sizeof(uint32_t));
+			size_t i = 0;
+			for (; i + HISTOGRAM_COPIES <= n; i += HISTOGRAM_COPIES) {
+				++sub[resolve(i)];
+				++sub[stride + resolve(i + 1)];
+				++sub[2 * stride + resolve(i + 2)];
+				++sub[3 * stride + resolve(i + 3)];
+			}
+			for (; i < n; ++i) ++sub[resolve(i)];
+			for (size_t copy = 0; copy < HISTOGRAM_COPIES; ++copy)
+				binary<V, uint32_t, SimdAdd>(counts, sub + copy * stride, bins, false);
+		}
+		else if constexpr (U::scatter_increments) {
+			alignas(64) uint32_t index[HISTOGRAM_BLOCK];
+			typename U::reg limit = U::set1(static_cast<uint32_t>(bins));
+			for (size_t start = 0; start < n; start += HISTOGRAM_BLOCK) {
+				size_t count = n - start < HISTOGRAM_BLOCK ? n - start : HISTOGRAM_BLOCK;
+				for (size_t i = 0; i < count; ++i) index[i] = resolve(start + i);
+				size_t i = 0;
+				for (; i + U::lanes <= count; i += U::lanes) {
+					typename U::reg v = U::load(index + i);
+					U::increment(counts, v, U::cmp_lt(v, limit));
+				}
+				if (i < count) {
+					typename U::reg v = U::load_partial(index + i, count - i, limit);
+					U::increment(counts, v, U::cmp_lt(v, limit));
+				}
+			}
+		}
+		else {
+			for (size_t i = 0; i < n; ++i) {
+				uint32_t k = resolve(i);
+				if (k < bins) ++counts[k];
+			}
+		}
+	}
+
+	// counts[src[i]] += 1 for 0 <= src[i] < bins, other values are skipped
+	template <template <typename> class V, typename T>
+	void histogram(uint32_t* counts, size_t bins, const T* src, size_t n) {
+		histogram_loop<V>(counts, bins, n, [=](size_t i) {
+			// Negative values wrap to huge ones and fail the same bound as values past the end
+			uint64_t value = static_cast<uint64_t>(static_cast<sum_t<T>>(src[i]));
+			return value < bins ? static_cast<uint32_t>(value) : static_cast<uint32_t>(bins);
+		});
+	}
+
+	// bins equal-width buckets over [low, high), NaN and values outside the range are skipped
+	template <template <typename> class V, typename T>
+	void histogram_range(uint32_t* counts, size_t bins, const T* src, size_t n, T low, T high) {
+		T scale = static_cast<T>(bins) / (high - low);
+		T top = static_cast<T>(bins - 1);
+		histogram_loop<V>(counts, bins, n, [=](size_t i) {
+			T value = src[i];
+			// Rounding can push values just under high onto bins, so the bucket is clamped rather than the value
+			T bucket = (value - low) * scale;
+			bucket = bucket < top ? bucket : top;
+			return value >= low && value < high ? static_cast<uint32_t>(bucket) : static_cast<uint32_t>(bins);
+		});
+	}
+
+	// ================= Gather and Scatter =================
+	// vpgatherd*/vpscatterd* on the 32/64-bit integer lanes, float tables move their bits. Checked calls take the largest
+	// index of each block first and only fall back to a per-element bounds test in blocks that hold a bad one. Tables
+	// past GATHER_PREFETCH_BYTES miss cache on most lookups, so the rows GATHER_PREFETCH_DISTANCE elements ahead are
+	// prefetched while the current vector waits on its own
+	constexpr size_t GATHER_BLOCK = 256;
+	constexpr size_t GATHER_PREFETCH_BYTES = size_t(1) << 20;
+	constexpr size_t GATHER_PREFETCH_DISTANCE = 32;
+	// The instructions sign-extend their indices
+	constexpr size_t GATHER_MAX_TABLE = size_t(1) << 31;
+
+	template <template <typename> class V, typename T>
+	using IndexLanes = V<conditional_t<sizeof(T) == 4, uint32_t, conditional_t<sizeof(T) == 8, uint64_t, T>>>;
+
+	// Rows a checked call would reject are not touched, not even by a prefetch
+	template <typename T>
+	FORCEINLINE void prefetch_rows(const T* table, size_t table_size, const uint32_t* indices, size_t count) {
+		for (size_t k = 0; k < count; ++k)
+			if (indices[k] < table_size) AVXUtils::prefetch(table + indices[k]);
+	}
+
+	// n indices known to be in range. The prefetch may look up to ahead indices past the start of indices
+	template <template <typename> class V, typename T, bool Prefetch>
+	void gather_run(T* dest, const T* table, size_t table_size, const uint32_t* indices, size_t n, size_t ahead) {
+		using S = IndexLanes<V, T>;
+		using L = typename S::value_type;
+		size_t i = 0;
+		if constexpr (S::gatherable) {
+			if (table_size <= GATHER_MAX_TABLE) {
+				const L* base = reinterpret_cast<const L*>(table);
+				for (; i + S::lanes <= n; i += S::lanes) {
+					if constexpr (Prefetch)
+						if (i + GATHER_PREFETCH_DISTANCE + S::lanes <= ahead) prefetch_rows(table, table_size, indices + i + GATHER_PREFETCH_DISTANCE, S::lanes);
+					S::storeu(reinterpret_cast<L*>(dest + i), S::gather(base, indices + i));
+				}
+				if (i < n) {
+					// Padded with row 0, which exists whenever there is anything to gather
+					alignas(64) uint32_t pad[S::lanes] = {};
+					std::memcpy(pad, indices + i, (n - i) * sizeof(uint32_t));
+					S::store_partial(reinterpret_cast<L*>(dest + i), S::gather(base, pad), n - i);
+				}
+				return;
+			}
+		}
+		for (; i < n; ++i) {
+			if constexpr (Prefetch)
+				if (i + GATHER_PREFETCH_DISTANCE < ahead) prefetch_rows(table, table_size, indices + i + GATHER_PREFETCH_DISTANCE, 1);
+			dest[i] = table[indices[i]];
+		}
+	}
+
+	template <template <typename> class V, typename T, bool Prefetch>
+	void scatter_run(T* table, size_t table_size, const uint32_t* indices, const T* src, size_t n, size_t ahead) {
+		using S = IndexLanes<V, T>;
+		using L = typename S::value_type;
+		size_t i = 0;
+		if constexpr (S::scatterable) {
+			if (table_size <= GATHER_MAX_TABLE) {
+				L* base = reinterpret_cast<L*>(table);
+				for (; i + S::lanes <= n; i += S::lanes) {
+					if constexpr (Prefetch)
+						if (i + GATHER_PREFETCH_DISTANCE + S::lanes <= ahead) prefetch_rows(table, table_size, indices + i + GATHER_PREFETCH_DISTANCE, S::lanes);
+					S::scatter(base, indices + i, S::loadu(reinterpret_cast<const L*>(src + i)));
+				}
+			}
+		}
+		for (; i < n; ++i) {
+			if constexpr (Prefetch)
+				if (i + GATHER_PREFETCH_DISTANCE < ahead) prefetch_rows(table, table_size, indices + i + GATHER_PREFETCH_DISTANCE, 1);
+			table[indices[i]] = src[i];
+		}
+	}
+
+	template <template <typename> class V, typename T, bool Prefetch>
+	size_t gather_checked(T* dest, const T* table, size_t table_size, const uint32_t* indices, size_t n, BoundsCheck check) {
+		if (check == BoundsCheck::Unchecked) {
+			gather_run<V, T, Prefetch>(dest, table, table_size, indices, n, n);
+			return 0;
+		}
+		size_t misses = 0;
+		for (size_t start = 0; start < n; start += GATHER_BLOCK) {
+			size_t count = n - start < GATHER_BLOCK ? n - start : GATHER_BLOCK;
+			if (reduce<V, uint32_t, SimdMax>(indices + start, count) < table_size) {
+				gather_run<V, T, Prefetch>(dest + start, table, table_size, indices + start, count, n - start);
+				continue;
+			}
+			for (size_t i = start; i < start + count; ++i) {
+				bool hit = indices[i] < table_size;
+				dest[i] = hit ? table[indices[i]] : T();
+				misses += !hit;
+			}
+		}
+		return misses;
+	}
+
+	template <template <typename> class V, typename T, bool Prefetch>
+	size_t scatter_checked(T* table, size_t table_size, const uint32_t* indices, const T* src, size_t n, BoundsCheck check) {
+		if (check == BoundsCheck::Unchecked) {
+			scatter_run<V, T, Prefetch>(table, table_size, indices, src, n, n);
+			return 0;
+		}
+		size_t misses = 0;
+		for (size_t start = 0; start < n; start += GATHER_BLOCK) {
+			size_t count = n - start < GATHER_BLOCK ? n - start : GATHER_BLOCK;
+			if (reduce<V, uint32_t, SimdMax>(indices + start, count) < table_size) {
+				scatter_run<V, T, Prefetch>(table, table_size, indices + start, src + start, count, n - start);
+				continue;
+			}
+			for (size_t i = start; i < start + count; ++i) {
+				if (indices[i] < table_size) table[indices[i]] = src[i];
+				else ++misses;
+			}
+		}
+		return misses;
+	}
+
+	template <template <typename> class V, typename T>
+	size_t gather(T* dest, const T* table, size_t table_size, const uint32_t* indices, size_t n, BoundsCheck check) {
+		if (table_size * sizeof(T) >= GATHER_PREFETCH_BYTES) return gather_checked<V, T, true>(dest, table, table_size, indices, n, check);
+		return gather_checked<V, T, false>(dest, table, table_size, indices, n, check);
+	}
+
+	template <template <typename> class V, typename T>
+	size_t scatter(T* table, size_t table_size, const uint32_t* indices, const T* src, size_t n, BoundsCheck check) {
+		if (table_size * sizeof(T) >= GATHER_PREFETCH_BYTES) return scatter_checked<V, T, true>(table, table_size, indices, src, n, check);
+		return scatter_checked<V, T, false>(table, table_size, indices, src, n, check);
+	}
+
+	// ================= Strided Copies =================
+	// The two halves of a StridedView operand, a column of records packed into contiguous scratch and written back.
+	// One strided gather/scatter per vector, with the offsets i * stride built in the index register
+
+	// Strides whose (lanes - 1) * stride still fits the 32-bit offsets of the instructions
+	template <typename S>
+	constexpr bool strided_in_range(ptrdiff_t stride) {
+		constexpr ptrdiff_t limit = INT32_MAX / static_cast<ptrdiff_t>(S::lanes);
+		return stride <= limit && stride >= -limit;
+	}
+
+	template <template <typename> class V, typename T>
+	void load_strided(T* dest, const T* src, ptrdiff_t stride, size_t n) {
+		using S = IndexLanes<V, T>;
+		using L = typename S::value_type;
+		const char* from = reinterpret_cast<const char*>(src);
+		size_t i = 0;
+		if constexpr (S::gatherable) {
+			if (strided_in_range<S>(stride)) {
+				for (; i + S::lanes <= n; i += S::lanes, from += stride * static_cast<ptrdiff_t>(S::lanes))
+					S::storeu(reinterpret_cast<L*>(dest + i), S::gather_strided(from, static_cast<int32_t>(stride)));
+			}
+		}
+		for (; i < n; ++i, from += stride) std::memcpy(dest + i, from, sizeof(T));
+	}
+
+	template <template <typename> class V, typename T>
+	void store_strided(T* dest, ptrdiff_t stride, const T* src, size_t n) {
+		using S = IndexLanes<V, T>;
+		using L = typename S::value_type;
+		char* to = reinterpret_cast<char*>(dest);
+		size_t i = 0;
+		if constexpr (S::scatterable) {
+			if (strided_in_range<S>(stride)) {
+				for (; i + S::lanes <= n; i += S::lanes, to += stride * static_cast<ptrdiff_t>(S::lanes))
+					S::scatter_strided(to, static_cast<int32_t>(stride), S::loadu(reinterpret_cast<const L*>(src + i)));
+			}
+		}
+		for (; i < n; ++i, to += stride) std::memcpy(to, src + i, sizeof(T));
+	}
+
+	// ================= Conversions =================
+	// float against float16/bfloat16/int8/uint8 (Float16.h, ConvertTable). Whole vectors go straight to and from memory,
+	// the last n % lanes elements through a zeroed stack buffer of the narrow format
+
+	template <template <typename> class V, typename N, typename Widen>
+	void widen_loop(float* dest, const N* src, size_t n, Widen&& widen) {
+		using S = V<float>;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		for (; i < simd_end; i += S::lanes) S::storeu(dest + i, widen(src + i));
+		if (i < n) {
+			N buffer[S::lanes] = {};
+			std::memcpy(buffer, src + i, (n - i) * sizeof(N));
+			S::store_partial(dest + i, widen(buffer), n - i);
+		}
+	}
+
+	template <template <typename> class V, typename N, typename Narrow>
+	void narrow_loop(N* dest, const float* src, size_t n, Narrow&& narrow) {
+		using S = V<float>;
+		size_t simd_end = n & ~(S::lanes - 1);
+		size_t i = 0;
+		for (; i < simd_end; i += S::lanes) narrow(dest + i, S::loadu(src + i));
+		if (i < n) {
+			N buffer[S::lanes];
+			narrow(buffer, S::load_partial(src + i, n - i));
+			std::memcpy(dest + i, buffer, (n - i) * sizeof(N));
+		}
+	}
+
+	// float16 and bfloat16 are a bare uint16_t, the tiers work on the bits
+	template <template <typename> class V>
+	void f32_to_f16(float16* dest, const float* src, size_t n) {
+		narrow_loop<V>(reinterpret_cast<uint16_t*>(dest), src, n, [](uint16_t* out, typename V<float>::reg v) { V<float>::store_f16(out, v); });
+	}
+
+	template <template <typename> class V>
+	void f16_to_f32(float* dest, const float16* src, size_t n) {
+		widen_loop<V>(dest, reinterpret_cast<const uint16_t*>(src), n, [](const uint16_t* in) { return V<float>::load_f16(in); });
+	}
+
+	template <template <typename> class V>
+	void f32_to_bf16(bfloat16* dest, const float* src, size_t n) {
+		narrow_loop<V>(reinterpret_cast<uint16_t*>(dest), src, n, [](uint16_t* out, typename V<float>::reg v) { V<float>::store_bf16(out, v); });
+	}
+
+	template <template <typename> class V>
+	void bf16_to_f32(float* dest, const bfloat16* src, size_t n) {
+		widen_loop<V>(dest, reinterpret_cast<const uint16_t*>(src), n, [](const uint16_t* in) { return V<float>::load_bf16(in); });
+	}
+
+	// dest[i] = saturate(round(src[i] * (1 / scale)) + zero_point). The zero point is added after rounding, exactly
+	template <template <typename> class V, typename Q>
+	void quantize(Q* dest, const float* src, size_t n, float scale, int32_t zero_point) {
+		using S = V<float>;
+		typename S::reg inverse = S::set1(1.0f / scale);
+		typename S::reg offset = S::set1(static_cast<float>(zero_point));
+		narrow_loop<V>(dest, src, n, [=](Q* out, typename S::reg v) {
+			typename S::reg q = S::add(S::round(S::mul(v, inverse)), offset);
+			if constexpr (is_same_v<Q, int8_t>) S::store_i8(out, q);
+			else S::store_u8(out, q);
+		});
+	}
+
+	// dest[i] = (src[i] - zero_point) * scale
+	template <template <typename> class V, typename Q>
+	void dequantize(float* dest, const Q* src, size_t n, float scale, int32_t zero_point) {
+		using S = V<float>;
+		typename S::reg factor = S::set1(scale);
+		typename S::reg offset = S::set1(static_cast<float>(zero_point));
+		widen_loop<V>(dest, src, n, [=](const Q* in) {
+			if constexpr (is_same_v<Q, int8_t>) return S::mul(S::sub(S::load_i8(in), offset), factor);
+			else return S::mul(S::sub(S::load_u8(in), offset), factor);
+		});
+	}
+
+	// Byte dot product accumulated in 32-bit lanes (a read as uint8 when A is uint8_t). Two accumulators hide the
+	// latency of the widen-and-pmaddwd chain
+	template <template <typename> class V, typename A>
+	int32_t dot_bytes(const A* a, const int8_t* b, size_t n) {
+		using S = V<int8_t>;
+		using W = V<int32_t>;
+		const int8_t* bytes = reinterpret_cast<const int8_t*>(a);
+		auto step = [](typename W::reg acc, typename S::reg x, typename S::reg y) {
+			if constexpr (is_same_v<A, int8_t>) return S::dot_i8(acc, x, y);
+			else return S::dot_u8i8(acc, x, y);
+		};
+		size_t simd_end = n & ~(2 * S::lanes - 1);
+		size_t i = 0;
+		typename W::reg acc0 = W::zero(), acc1 = W::zero();
+		for (; i < simd_end; i += 2 * S::lanes) {
+			acc0 = step(acc0, S::loadu(bytes + i), S::loadu(b + i));
+			acc1 = step(acc1, S::loadu(bytes + i + S::lanes), S::loadu(b + i + S::lanes));
+		}
+		if (n - i >= S::lanes) {
+			acc0 = step(acc0, S::loadu(bytes + i), S::loadu(b + i));
+			i += S::lanes;
+		}
+		if (i < n) acc1 = step(acc1, S::load_partial(bytes + i, n - i), S::load_partial(b + i, n - i));
+		return static_cast<int32_t>(W::reduce_add(W::add(acc0, acc1)));
+	}
+
+	// ================= Memory =================
+	// Byte-level bulk primitives behind Memory.h, V<uint8_t> registers of bytes throughout
+	// Copies from this many bytes up go to rep movsb on hosts with ERMS, where the microcode moves whole lines at once
+	constexpr size_t REP_MOVSB_BYTES = 4096;
+
+	FORCEINLINE void rep_movsb(void* dest, const void* src, size_t bytes) {
+#if defined(_MSC_VER)
+		__movsb(static_cast<unsigned char*>(dest), static_cast<const unsigned char*>(src), bytes);
+#else
+		__asm__ volatile("rep movsb" : "+D"(dest), "+S"(src), "+c"(bytes) : : "memory");
+#endif
+	}
+
+	// Copies N <= bytes <= 2N bytes as two possibly overlapping N byte blocks, every load before any store
+	template <size_t N>
+	FORCEINLINE void copy_ends(uint8_t* d, const uint8_t* s, size_t bytes) {
+		struct Block { uint8_t b[N]; } head, tail;
+		std::memcpy(&head, s, N);
+		std::memcpy(&tail, s + bytes - N, N);
+		std::memcpy(d, &head, N);
+		std::memcpy(d + bytes - N, &tail, N);
+	}
+
+	// bytes < 64 without a loop or a branch per byte
+	FORCEINLINE void copy_small(uint8_t* d, const uint8_t* s, size_t bytes) {
+		if (bytes >= 32) copy_ends<32>(d, s, bytes);
+		else if (bytes >= 16) copy_ends<16>(d, s, bytes);
+		else if (bytes >= 8) copy_ends<8>(d, s, bytes);
+		else if (bytes >= 4) copy_ends<4>(d, s, bytes);
+		else if (bytes >= 2) copy_ends<2>(d, s, bytes);
+		else if (bytes) *d = *s;
+	}
+
+	// Non-overlapping copy, by size class: up to two registers as overlapping head and tail blocks, then aligned
+	// register stores with the ends done unaligned, and from REP_MOVSB_BYTES up rep movsb when Erms
+	template <template <typename> class V, bool Erms>
+	void copy(void* dest, const void* src, size_t bytes) {
+		using S = V<uint8_t>;
+		constexpr size_t L = S::lanes;
+		uint8_t* d = static_cast<uint8_t*>(dest);
+		const uint8_t* s = static_cast<const uint8_t*>(src);
+		if constexpr (L == 1) {
+			std::memcpy(d, s, bytes);
+		}
+		else {
+			if (bytes < 64) {
+				copy_small(d, s, bytes);
+				return;
+			}
+			if (bytes <= 2 * L) {
+				copy_ends<L>(d, s, bytes);
+				return;
+			}
+			if constexpr (Erms) {
+				if (bytes >= REP_MOVSB_BYTES) {
+					rep_movsb(d, s, bytes);
+					return;
+				}
+			}
+			typename S::reg head = S::loadu(s);
+			typename S::reg tail = S::loadu(s + bytes - L);
+			size_t i = peel<S>(d, bytes);
+			size_t end = bytes - L;
+			for (; i + 4 * L <= end; i += 4 * L) {
+				typename S::reg a = S::loadu(s + i), b = S::loadu(s + i + L), c = S::loadu(s + i + 2 * L), e = S::loadu(s + i + 3 * L);
+				S::store(d + i, a);
+				S::store(d + i + L, b);
+				S::store(d + i + 2 * L, c);
+				S::store(d + i + 3 * L, e);
+			}
+			for (; i < end; i += L)
+				S::store(d + i, S::loadu(s + i));
+			S::storeu(d, head);
+			S::storeu(d + end, tail);
+		}
+	}
+
+	// A register of size byte patterns, size a power of two no wider than the register. The integer tiers share one reg
+	// type across lane widths, so 1 to 8 byte patterns are a single broadcast
+	template <template <typename> class V>
+	FORCEINLINE typename V<uint8_t>::reg fill_pattern(const void* value, size_t size) {
+		switch (size) {
+		case 1: return V<uint8_t>::set1(*static_cast<const uint8_t*>(value));
+		case 2: { uint16_t x; std::memcpy(&x, value, 2); return V<uint16_t>::set1(x); }
+		case 4: { uint32_t x; std::memcpy(&x, value, 4); return V<uint32_t>::set1(x); }
+		case 8: { uint64_t x; std::memcpy(&x, value, 8); return V<uint64_t>::set1(x); }
+		default: {
+			alignas(64) uint8_t pattern[V<uint8_t>::lanes];
+			for (size_t j = 0; j < V<uint8_t>::lanes; j += size)
+				std::memcpy(pattern + j, value, size);
+			return V<uint8_t>::load(pattern);
+		}
+		}
+	}
+
+	// bytes / size copies of the size byte pattern at value, size a power of two of at most 64 that divides bytes.
+	// A register of the pattern stored at any multiple of its width from dest keeps the phase, so only the last store
+	// overlaps; when dest is aligned to size the stores between the ends are register aligned too
+	template <template <typename> class V>
+	void fill(void* dest, const void* value, size_t size, size_t bytes) {
+		using S = V<uint8_t>;
+		constexpr size_t L = S::lanes;
+		uint8_t* d = static_cast<uint8_t*>(dest);
+		if constexpr (L == 1) {
+			if (size == 1) std::memset(d, *static_cast<const uint8_t*>(value), bytes);
+			else for (size_t i = 0; i < bytes; i += size) std::memcpy(d + i, value, size);
+		}
+		else {
+			if (size > L) {
+				for (size_t i = 0; i < bytes; i += size) std::memcpy(d + i, value, size);
+				return;
+			}
+			typename S::reg v = fill_pattern<V>(value, size);
+			if (bytes < L) {
+				S::store_partial(d, v, bytes);
+				return;
+			}
+			S::storeu(d, v);
+			size_t i = reinterpret_cast<uintptr_t>(d) % size ? L : peel<S>(d, bytes);
+			size_t end = bytes - L;
+			for (; i + 4 * L <= end; i += 4 * L) {
+				S::storeu(d + i, v);
+				S::storeu(d + i + L, v);
+				S::storeu(d + i + 2 * L, v);
+				S::storeu(d + i + 3 * L, v);
+			}
+			for (; i < end; i += L)
+				S::storeu(d + i, v);
+			S::storeu(d + end, v);
+		}
+	}
+
+	// Offset of the first byte where a and b differ, bytes if none does. Four registers are compared per step and the
+	// lane masks and-ed, so the loop branches once per 4 registers. The scalar tier compares 8 byte words
+	template <template <typename> class V>
+	size_t mismatch(const void* a, const void* b, size_t bytes) {
+		using S = V<uint8_t>;
+		constexpr size_t L = S::lanes;
+		const uint8_t* x = static_cast<const uint8_t*>(a);
+		const uint8_t* y = static_cast<const uint8_t*>(b);
+		size_t i = 0;
+		if constexpr (L == 1) {
+			for (; i + 8 <= bytes; i += 8) {
+				uint64_t u, w;
+				std::memcpy(&u, x + i, 8);
+				std::memcpy(&w, y + i, 8);
+				if (u != w) return i + (std::countr_zero(u ^ w) >> 3); // Little endian, the lowest set bit is the first byte
+			}
+			for (; i < bytes; ++i)
+				if (x[i] != y[i]) return i;
+			return bytes;
+		}
+		else {
+			constexpr uint64_t all = L == 64 ? ~uint64_t(0) : (uint64_t(1) << L) - 1;
+			auto equal = [&](size_t at) { return S::bitmask(S::cmp_eq(S::loadu(x + at), S::loadu(y + at))); };
+			while (i + 4 * L <= bytes && (equal(i) & equal(i + L) & equal(i + 2 * L) & equal(i + 3 * L)) == all)
+				i += 4 * L;
+			// The differing register, if it was one of those four, is found again here
+			for (; i + L <= bytes; i += L) {
+				uint64_t eq = equal(i);
+				if (eq != all) return i + std::countr_zero(~eq);
+			}
+			if (i < bytes) {
+				size_t rest = bytes - i;
+				uint64_t eq = S::bitmask(S::cmp_eq(S::load_partial(x + i, rest), S::load_partial(y + i, rest)));
+				if (eq != all) return i + std::countr_zero(~eq);
+			}
+			return bytes;
+		}
+	}
+
+	// Whether all bytes are zero. Registers are or-ed together (max, for unsigned bytes) and tested once per 4
+	template <template <typename> class V>
+	bool is_zero(const void* src, size_t bytes) {
+		using S = V<uint8_t>;
+		constexpr size_t L = S::lanes;
+		const uint8_t* p = static_cast<const uint8_t*>(src);
+		size_t i = 0;
+		if constexpr (L == 1) {
+			uint64_t acc = 0;
+			for (; i + 8 <= bytes; i += 8) {
+				uint64_t u;
+				std::memcpy(&u, p + i, 8);
+				acc |= u;
+			}
+			for (; i < bytes; ++i)
+				acc |= p[i];
+			return acc == 0;
+		}
+		else {
+			constexpr uint64_t all = L == 64 ? ~uint64_t(0) : (uint64_t(1) << L) - 1;
+			typename S::reg zero = S::zero();
+			for (; i + 4 * L <= bytes; i += 4 * L) {
+				typename S::reg acc = S::max(S::max(S::loadu(p + i), S::loadu(p + i + L)), S::max(S::loadu(p + i + 2 * L), S::loadu(p + i + 3 * L)));
+				if (S::bitmask(S::cmp_eq(acc, zero)) != all) return false;
+			}
+			typename S::reg acc = zero;
+			for (; i + L <= bytes; i += L)
+				acc = S::max(acc, S::loadu(p + i));
+			if (i < bytes) acc = S::max(acc, S::load_partial(p + i, bytes - i));
+			return S::bitmask(S::cmp_eq(acc, zero)) == all;
+		}
+	}
+
+	// The non-temporal pair. The unaligned head and the tail go through memcpy, everything between is streamed.
+	// Scalar has no streaming store, so it is plain memcpy
+	template <template <typename> class V>
+	void stream_copy(void* dest, const void* src, size_t bytes) {
+		using S = V<uint8_t>;
+		uint8_t* d = static_cast<uint8_t*>(dest);
+		const uint8_t* s = static_cast<const uint8_t*>(src);
+		if constexpr (S::lanes == 1) {
+			std::memcpy(d, s, bytes);
+		}
+		else {
+			size_t i = peel<S>(d, bytes);
+			std::memcpy(d, s, i);
+			size_t simd_end = i + ((bytes - i) & ~(S::lanes - 1));
+			for (; i < simd_end; i += S::lanes)
+				S::stream(d + i, S::loadu(s + i));
+			S::fence();
+			std::memcpy(d + i, s + i, bytes - i);
+		}
+	}
+
+	// bytes / size copies of the size byte pattern at value. size is a power of two of at most 64 and divides bytes
+	template <template <typename> class V>
+	void stream_fill(void* dest, const void* value, size_t size, size_t bytes) {
+		using S = V<uint8_t>;
+		uint8_t* d = static_cast<uint8_t*>(dest);
+		size_t i = 0;
+		if constexpr (S::lanes > 1) {
+			// The pattern repeats every size bytes, so a register of it only lines up if dest is aligned to size
+			if (size <= S::lanes && reinterpret_cast<uintptr_t>(d) % size == 0) {
+				for (; i < bytes && reinterpret_cast<uintptr_t>(d + i) % S::lanes; i += size)
+					std::memcpy(d + i, value, size);
+				typename S::reg v = fill_pattern<V>(value, size);
+				size_t simd_end = i + ((bytes - i) & ~(S::lanes - 1));
+				for (; i < simd_end; i += S::lanes)
+					S::stream(d + i, v);
+				S::fence();
+			}
+		}
+		for (; i < bytes; i += size)
+			std::memcpy(d + i, value, size);
+	}
+
+	template <template <typename> class V, typename T>
+	KernelTable<T> make_table() {
+		KernelTable<T> table;
+		table.add = &binary<V, T, SimdAdd>;
+		table.subtract = &binary<V, T, SimdSub>;
+		table.multiply = &binary<V, T, SimdMul>;
+		table.min = &binary<V, T, SimdMin>;
+		table.max = &binary<V, T, SimdMax>;
+		table.dot_product = &dot_product<V, T>;
+		table.sum = &sum<V, T>;
+		table.reduce_min = &reduce<V, T, SimdMin>;
+		table.reduce_max = &reduce<V, T, SimdMax>;
+		table.argmin = &arg_reduce<V, T, SimdMin>;
+		table.argmax = &arg_reduce<V, T, SimdMax>;
+		table.sum_squared_deviation = &sum_squared_deviation<V, T>;
+		table.compare = &compare<V, T>;
+		table.compare_scalar = &compare_scalar<V, T>;
+		table.compress = &compress<V, T>;
+		table.compress_scalar = &compress_scalar<V, T>;
+		table.inclusive_scan = &scan<V, T, SimdAdd, false>;
+		table.exclusive_scan = &scan<V, T, SimdAdd, true>;
+		table.running_min = &scan<V, T, SimdMin, false>;
+		table.running_max = &scan<V, T, SimdMax, false>;
+		table.sort = &sort<V, T>;
+		table.argsort = &argsort<V, T>;
+		table.gather = &gather<V, T>;
+		table.scatter = &scatter<V, T>;
+		table.load_strided = &load_strided<V, T>;
+		table.store_strided = &store_strided<V, T>;
+		if constexpr (std::is_integral_v<T>) {
+			table.histogram = &histogram<V, T>;
+		}
+		if constexpr (std::is_signed_v<T>) {
+			table.abs = &unary<V, T, SimdAbs>;
+		}
+		if constexpr (std::is_floating_point_v<T>) {
+			table.divide = &binary<V, T, SimdDiv>;
+			table.sqrt = &unary<V, T, SimdSqrt>;
+			table.fmadd = &fmadd<V, T>;
+			table.sum_pairwise = &sum_pairwise<V, T>;
+			table.sum_kahan = &sum_kahan<V, T>;
+			table.exp = &unary<V, T, SimdExp>;
+			table.log = &unary<V, T, SimdLog>;
+			table.log2 = &unary<V, T, SimdLog2>;
+			table.sin = &unary<V, T, SimdSin>;
+			table.cos = &unary<V, T, SimdCos>;
+			table.tanh = &unary<V, T, SimdTanh>;
+			table.sigmoid = &unary<V, T, SimdSigmoid>;
+			table.erf = &unary<V, T, SimdErf>;
+			table.pow = &binary<V, T, SimdPow>;
+			table.gemm = &gemm<V, T>;
+			table.gemv = &gemv<V, T>;
+			table.histogram_range = &histogram_range<V, T>;
+		}
+		return table;
+	}
+
+	template <template <typename> class V>
+	ConvertTable make_convert_table() {
+		ConvertTable table;
+		table.f32_to_f16 = &f32_to_f16<V>;
+		table.f16_to_f32 = &f16_to_f32<V>;
+		table.f32_to_bf16 = &f32_to_bf16<V>;
+		table.bf16_to_f32 = &bf16_to_f32<V>;
+		table.quantize_i8 = &quantize<V, int8_t>;
+		table.quantize_u8 = &quantize<V, uint8_t>;
+		table.dequantize_i8 = &dequantize<V, int8_t>;
+		table.dequantize_u8 = &dequantize<V, uint8_t>;
+		table.dot_i8 = &dot_bytes<V, int8_t>;
+		table.dot_u8i8 = &dot_bytes<V, uint8_t>;
+		return table;
+	}
+
+	template <template <typename> class V, bool Erms>
+	MemoryTable make_memory_table() {
+		MemoryTable table;
+		table.copy = &copy<V, Erms>;
+		table.fill = &fill<V>;
+		table.mismatch = &mismatch<V>;
+		table.is_zero = &is_zero<V>;
+		table.stream_copy = &stream_copy<V>;
+		table.stream_fill = &stream_fill<V>;
+		return table;
+	}
+
+	// One per tier, each defined (and explicitly instantiated for DEVSW_KERNEL_TYPES) in its own Kernels*.cpp
+	template <typename T> KernelTable<T> scalar_table();
+	template <typename T> KernelTable<T> sse42_table();
+	template <typename T> KernelTable<T> avx2_table();
+	template <typename T> KernelTable<T> avx512_table();
+	ConvertTable scalar_convert_table();
+	ConvertTable sse42_convert_table();
+	ConvertTable avx2_convert_table();
+	ConvertTable avx512_convert_table();
+	// erms picks the copy that hands large sizes to rep movsb
+	MemoryTable scalar_memory_table(bool erms);
+	MemoryTable sse42_memory_table(bool erms);
+	MemoryTable avx2_memory_table(bool erms);
+	MemoryTable avx512_memory_table(bool erms);
+	// AVX-512 table with the byte dot products on vpdpbusd, KernelsVNNI.cpp. Bound only when CPUID reports VNNI
+	ConvertTable avx512_vnni_convert_table();
+}
@@ -0,0 +1,14 @@
+// Built with -mavx2 -mfma -mbmi2 -mf16c or /arch:AVX2 (see CMakeLists.txt)
+#include "Kernels.h"
+
+namespace devsw::stl::kernels {
+	template <typename T>
+	KernelTable<T> avx2_table() { return make_table<SimdAVX2, T>(); }
+
+	ConvertTable avx2_convert_table() { return make_convert_table<SimdAVX2>(); }
+	MemoryTable avx2_memory_table(bool erms) { return erms ? make_memory_table<SimdAVX2, true>() : make_memory_table<SimdAVX2, false>(); }
+
+#define DEVSW_INSTANTIATE_TABLE(T) template KernelTable<T> avx2_table<T>();
+	DEVSW_KERNEL_TYPES(DEVSW_INSTANTIATE_TABLE)
+#undef DEVSW_INSTANTIATE_TABLE
+}
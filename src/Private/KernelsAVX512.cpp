@@ -0,0 +1,14 @@
+// Built with -mavx512f/bw/cd/dq/vl -mavx2 -mfma -mbmi2 -mf16c or /arch:AVX512 (see CMakeLists.txt)
+#include "Kernels.h"
+
+namespace devsw::stl::kernels {
+	template <typename T>
+	KernelTable<T> avx512_table() { return make_table<SimdAVX512, T>(); }
+
+	ConvertTable avx512_convert_table() { return make_convert_table<SimdAVX512>(); }
+	MemoryTable avx512_memory_table(bool erms) { return erms ? make_memory_table<SimdAVX512, true>() : make_memory_table<SimdAVX512, false>(); }
+
+#define DEVSW_INSTANTIATE_TABLE(T) template KernelTable<T> avx512_table<T>();
+	DEVSW_KERNEL_TYPES(DEVSW_INSTANTIATE_TABLE)
+#undef DEVSW_INSTANTIATE_TABLE
+}
@@ -0,0 +1,14 @@
+// Built with -msse4.2 -mpopcnt (see CMakeLists.txt)
+#include "Kernels.h"
+
+namespace devsw::stl::kernels {
+	template <typename T>
+	KernelTable<T> sse42_table() { return make_table<SimdSSE42, T>(); }
+
+	ConvertTable sse42_convert_table() { return make_convert_table<SimdSSE42>(); }
+	MemoryTable sse42_memory_table(bool erms) { return erms ? make_memory_table<SimdSSE42, true>() : make_memory_table<SimdSSE42, false>(); }
+
+#define DEVSW_INSTANTIATE_TABLE(T) template KernelTable<T> sse42_table<T>();
+	DEVSW_KERNEL_TYPES(DEVSW_INSTANTIATE_TABLE)
+#undef DEVSW_INSTANTIATE_TABLE
+}
@@ -0,0 +1,14 @@
+// Plain C++, built without extra ISA flags
+#include "Kernels.h"
+
+namespace devsw::stl::kernels {
+	template <typename T>
+	KernelTable<T> scalar_table() { return make_table<SimdScalar, T>(); }
+
+	ConvertTable scalar_convert_table() { return make_convert_table<SimdScalar>(); }
+	MemoryTable scalar_memory_table(bool erms) { return erms ? make_memory_table<SimdScalar, true>() : make_memory_table<SimdScalar, false>(); }
+
+#define DEVSW_INSTANTIATE_TABLE(T) template KernelTable<T> scalar_table<T>();
+	DEVSW_KERNEL_TYPES(DEVSW_INSTANTIATE_TABLE)
+#undef DEVSW_INSTANTIATE_TABLE
+}
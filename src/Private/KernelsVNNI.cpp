@@ -0,0 +1,52 @@
+// Built with the AVX-512 flags plus -mavx512vnni, or /arch:AVX512 (see CMakeLists.txt)
+#include "Kernels.h"
+
+namespace devsw::stl::kernels {
+	namespace {
+		// vpdpbusd multiplies unsigned a by signed b. For signed a the bytes are biased to a + 128 and the excess,
+		// 128 * sum(b), is taken back out at the end (sum(b) is one more vpdpbusd against a vector of ones)
+		template <bool SignedA>
+		int32_t dot_vnni(const uint8_t* a, const int8_t* b, size_t n) {
+			const __m512i bias = _mm512_set1_epi8(static_cast<char>(0x80));
+			const __m512i ones = _mm512_set1_epi8(1);
+			__m512i acc = _mm512_setzero_si512();
+			__m512i sum_b = _mm512_setzero_si512();
+			size_t i = 0;
+			for (; i + 64 <= n; i += 64) {
+				__m512i x = _mm512_loadu_si512(a + i);
+				__m512i y = _mm512_loadu_si512(b + i);
+				if constexpr (SignedA) {
+					x = _mm512_xor_si512(x, bias);
+					sum_b = AVXUtils::dpbusd_512(sum_b, ones, y);
+				}
+				acc = AVXUtils::dpbusd_512(acc, x, y);
+			}
+			if (i < n) {
+				// Masked off lanes of b are zero, so whatever the bias leaves in a multiplies to nothing
+				__mmask64 m = (uint64_t(1) << (n - i)) - 1;
+				__m512i x = _mm512_maskz_loadu_epi8(m, a + i);
+				__m512i y = _mm512_maskz_loadu_epi8(m, b + i);
+				if constexpr (SignedA) {
+					x = _mm512_xor_si512(x, bias);
+					sum_b = AVXUtils::dpbusd_512(sum_b, ones, y);
+				}
+				acc = AVXUtils::dpbusd_512(acc, x, y);
+			}
+			uint32_t total = static_cast<uint32_t>(_mm512_reduce_add_epi32(acc));
+			if constexpr (SignedA) total -= 128u * static_cast<uint32_t>(_mm512_reduce_add_epi32(sum_b));
+			return static_cast<int32_t>(total);
+		}
+
+		int32_t dot_i8_vnni(const int8_t* a, const int8_t* b, size_t n) { return dot_vnni<true>(reinterpret_cast<const uint8_t*>(a), b, n); }
+		int32_t dot_u8i8_vnni(const uint8_t* a, const int8_t* b, size_t n) { return dot_vnni<false>(a, b, n); }
+	}
+
+	// Starts from the AVX-512 table rather than instantiating make_convert_table here: kernels built with VNNI enabled
+	// must not share symbols with the ones plain AVX-512 hosts run
+	ConvertTable avx512_vnni_convert_table() {
+		ConvertTable table = avx512_convert_table();
+		table.dot_i8 = &dot_i8_vnni;
+		table.dot_u8i8 = &dot_u8i8_vnni;
+		return table;
+	}
+}
@@ -0,0 +1,168 @@
+#include "MappedVector.h"
+
+#if defined(_MSC_VER)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace devsw::stl {
+	namespace {
+#if !defined(_MSC_VER)
+		int advice_flag(MapAdvice advice) {
+			switch (advice) {
+			case MapAdvice::Normal: return MADV_NORMAL;
+			case MapAdvice::Sequential: return MADV_SEQUENTIAL;
+			case MapAdvice::Random: return MADV_RANDOM;
+			case MapAdvice::WillNeed: return MADV_WILLNEED;
+#if defined(MADV_HUGEPAGE)
+			case MapAdvice::HugePage: return MADV_HUGEPAGE;
+#endif
+			case MapAdvice::DontNeed: return MADV_DONTNEED;
+			default: return -1;
+			}
+		}
+#endif
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: data_(other.data_), size_(other.size_), mode_(other.mode_), handle_(other.handle_) {
+		other.data_ = nullptr;
+		other.size_ = 0;
+		other.handle_ = nullptr;
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			close();
+			data_ = other.data_;
+			size_ = other.size_;
+			mode_ = other.mode_;
+			handle_ = other.handle_;
+			other.data_ = nullptr;
+			other.size_ = 0;
+			other.handle_ = nullptr;
+		}
+		return *this;
+	}
+
+#if defined(_MSC_VER)
+	bool MappedFile::open(const char* path, MapMode mode) {
+		close();
+		DWORD access = mode == MapMode::ReadWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+		HANDLE file = CreateFileA(path, access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER length;
+		if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		DWORD protect = mode == MapMode::ReadOnly ? PAGE_READONLY : mode == MapMode::ReadWrite ? PAGE_READWRITE : PAGE_WRITECOPY;
+		DWORD view = mode == MapMode::ReadOnly ? FILE_MAP_READ : mode == MapMode::ReadWrite ? FILE_MAP_WRITE : FILE_MAP_COPY;
+		HANDLE mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			return false;
+		}
+		void* data = MapViewOfFile(mapping, view, 0, 0, 0);
+		CloseHandle(mapping); // The view keeps the mapping alive
+		if (!data) {
+			CloseHandle(file);
+			return false;
+		}
+		data_ = static_cast<char*>(data);
+		size_ = static_cast<size_t>(length.QuadPart);
+		mode_ = mode;
+		handle_ = file;
+		return true;
+	}
+
+	bool MappedFile::create(const char* path, size_t bytes) {
+		close();
+		HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER length;
+		length.QuadPart = static_cast<LONGLONG>(bytes);
+		bool sized = SetFilePointerEx(file, length, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+		CloseHandle(file);
+		return sized && open(path, MapMode::ReadWrite);
+	}
+
+	void MappedFile::close() {
+		if (data_) UnmapViewOfFile(data_);
+		if (handle_) CloseHandle(static_cast<HANDLE>(handle_));
+		data_ = nullptr;
+		size_ = 0;
+		handle_ = nullptr;
+	}
+
+	void MappedFile::advise(MapAdvice advice, size_t offset, size_t length) const {
+		if (!data_ || offset >= size_ || advice != MapAdvice::WillNeed) return; // The only hint Windows takes
+		if (length > size_ - offset) length = size_ - offset;
+		WIN32_MEMORY_RANGE_ENTRY range = { data_ + offset, length };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	void MappedFile::flush() const {
+		if (!data_ || mode_ != MapMode::ReadWrite) return;
+		FlushViewOfFile(data_, 0);
+		FlushFileBuffers(static_cast<HANDLE>(handle_));
+	}
+#else
+	bool MappedFile::open(const char* path, MapMode mode) {
+		close();
+		int fd = ::open(path, mode == MapMode::ReadWrite ? O_RDWR : O_RDONLY);
+		if (fd < 0) return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+		int protect = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+		int flags = mode == MapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+		void* data = mmap(nullptr, static_cast<size_t>(info.st_size), protect, flags, fd, 0);
+		::close(fd); // The mapping holds its own reference to the file
+		if (data == MAP_FAILED) return false;
+		data_ = static_cast<char*>(data);
+		size_ = static_cast<size_t>(info.st_size);
+		mode_ = mode;
+		return true;
+	}
+
+	bool MappedFile::create(const char* path, size_t bytes) {
+		close();
+		int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) return false;
+		bool sized = ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+		::close(fd);
+		return sized && open(path, MapMode::ReadWrite);
+	}
+
+	void MappedFile::close() {
+		if (data_) munmap(data_, size_);
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	void MappedFile::advise(MapAdvice advice, size_t offset, size_t length) const {
+		int flag = advice_flag(advice);
+		if (!data_ || offset >= size_ || flag < 0) return;
+		if (length > size_ - offset) length = size_ - offset;
+		// madvise wants a page-aligned start
+		size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		size_t start = offset & ~(page - 1);
+		madvise(data_ + start, length + (offset - start), flag);
+	}
+
+	void MappedFile::flush() const {
+		if (!data_ || mode_ != MapMode::ReadWrite) return;
+		msync(data_, size_, MS_SYNC);
+	}
+#endif
+}
@@ -0,0 +1,156 @@
+#include "Memory.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace devsw::stl {
+	namespace {
+		HugePages initial_policy() {
+			const char* forced = std::getenv("DEVSW_HUGE_PAGES");
+			if (!forced) return HugePages::Transparent;
+			if (std::strcmp(forced, "off") == 0) return HugePages::Off;
+			if (std::strcmp(forced, "explicit") == 0) return HugePages::Explicit;
+			return HugePages::Transparent;
+		}
+
+		std::atomic<HugePages>& policy() {
+			static std::atomic<HugePages> value(initial_policy());
+			return value;
+		}
+
+#if !defined(_MSC_VER)
+		void advise_huge(void* ptr, size_t bytes) {
+#if defined(MADV_HUGEPAGE)
+			if (Pages::huge_pages() != HugePages::Off && bytes >= Pages::HUGE_PAGE) madvise(ptr, bytes, MADV_HUGEPAGE);
+#else
+			(void)ptr;
+			(void)bytes;
+#endif
+		}
+#endif
+	}
+
+	HugePages Pages::huge_pages() {
+		return policy().load(std::memory_order_relaxed);
+	}
+
+	void Pages::set_huge_pages(HugePages value) {
+		policy().store(value, std::memory_order_relaxed);
+	}
+
+	size_t Pages::round(size_t bytes) {
+		size_t unit = huge_pages() != HugePages::Off && bytes >= HUGE_PAGE ? HUGE_PAGE : page_size();
+		return (bytes + unit - 1) & ~(unit - 1);
+	}
+
+#if defined(_MSC_VER)
+	size_t Pages::page_size() {
+		static const size_t size = [] {
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return static_cast<size_t>(info.dwPageSize);
+		}();
+		return size;
+	}
+
+	void* Pages::map(size_t bytes) {
+		if (bytes == 0) return nullptr;
+		// Large pages need SeLockMemoryPrivilege and a multiple of GetLargePageMinimum, either may be missing
+		size_t large = GetLargePageMinimum();
+		if (huge_pages() == HugePages::Explicit && large && bytes % large == 0) {
+			void* ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (ptr) return ptr;
+		}
+		return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	void* Pages::map_aligned(size_t bytes, size_t alignment) {
+		if (alignment <= page_size()) return map(bytes);
+		// Reserve enough to find an aligned start, give it back, then ask for exactly that address. Another thread can
+		// take it in between, so try a few times
+		for (int attempt = 0; attempt < 8; ++attempt) {
+			void* probe = VirtualAlloc(nullptr, bytes + alignment, MEM_RESERVE, PAGE_NOACCESS);
+			if (!probe) return nullptr;
+			uintptr_t start = (reinterpret_cast<uintptr_t>(probe) + alignment - 1) & ~(alignment - 1);
+			VirtualFree(probe, 0, MEM_RELEASE);
+			void* ptr = VirtualAlloc(reinterpret_cast<void*>(start), bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if (ptr) return ptr;
+		}
+		return nullptr;
+	}
+
+	void* Pages::remap(void*, size_t, size_t) {
+		return nullptr; // No mremap, the caller copies
+	}
+
+	void Pages::unmap(void* ptr, size_t) {
+		if (ptr) VirtualFree(ptr, 0, MEM_RELEASE);
+	}
+#else
+	size_t Pages::page_size() {
+		static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		return size;
+	}
+
+	void* Pages::map(size_t bytes) {
+		if (bytes == 0) return nullptr;
+#if defined(MAP_HUGETLB)
+		if (huge_pages() == HugePages::Explicit && bytes % HUGE_PAGE == 0) {
+			void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (ptr != MAP_FAILED) return ptr;
+		}
+#endif
+		void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ptr == MAP_FAILED) return nullptr;
+		advise_huge(ptr, bytes);
+		return ptr;
+	}
+
+	void* Pages::map_aligned(size_t bytes, size_t alignment) {
+		if (alignment <= page_size()) return map(bytes);
+		// Over-map by the alignment and unmap what sticks out on either side
+		size_t span = bytes + alignment;
+		void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED) return nullptr;
+		uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+		uintptr_t aligned = (start + alignment - 1) & ~(alignment - 1);
+		if (aligned != start) munmap(raw, aligned - start);
+		if (start + span != aligned + bytes) munmap(reinterpret_cast<void*>(aligned + bytes), start + span - (aligned + bytes));
+		advise_huge(reinterpret_cast<void*>(aligned), bytes);
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	void* Pages::remap(void* ptr, size_t old_bytes, size_t new_bytes) {
+#if defined(__linux__)
+		if (!ptr || new_bytes == 0) return nullptr;
+		if (new_bytes == old_bytes) return ptr;
+		// Grows in place when the address space after the mapping is free, otherwise moves the page table entries.
+		// A MAP_HUGETLB mapping fails this on kernels before 5.16 and the caller copies
+		void* moved = mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+		if (moved == MAP_FAILED) return nullptr;
+		if (new_bytes > old_bytes) advise_huge(moved, new_bytes);
+		return moved;
+#else
+		(void)ptr;
+		(void)old_bytes;
+		(void)new_bytes;
+		return nullptr;
+#endif
+	}
+
+	void Pages::unmap(void* ptr, size_t bytes) {
+		if (ptr) munmap(ptr, bytes);
+	}
+#endif
+}
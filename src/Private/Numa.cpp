@@ -0,0 +1,148 @@
+#include "Memory.h"
+
+#include <cstdio>
+
+#if defined(_MSC_VER)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace devsw::stl {
+#if defined(_MSC_VER)
+	int Numa::node_count() {
+		static const int count = [] {
+			ULONG highest = 0;
+			return GetNumaHighestNodeNumber(&highest) ? static_cast<int>(highest) + 1 : 1;
+		}();
+		return count;
+	}
+
+	int Numa::current_node() {
+		if (node_count() < 2) return 0;
+		PROCESSOR_NUMBER processor;
+		GetCurrentProcessorNumberEx(&processor);
+		USHORT node = 0;
+		return GetNumaProcessorNodeEx(&processor, &node) && node < node_count() ? static_cast<int>(node) : 0;
+	}
+
+	// Windows places at allocation time only, see map
+	bool Numa::place(void*, size_t, int) {
+		return false;
+	}
+
+	bool Numa::prefer(int) {
+		return false;
+	}
+
+	void* Numa::map(size_t bytes, int node) {
+		if (node < 0 || node >= node_count() || node_count() < 2) return Pages::map(bytes);
+		return VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, static_cast<DWORD>(node));
+	}
+#elif defined(__linux__)
+	namespace {
+		// linux/mempolicy.h, not included for four constants
+		constexpr int POLICY_DEFAULT = 0;
+		constexpr int POLICY_PREFERRED = 1;
+		constexpr int POLICY_INTERLEAVE = 3;
+		constexpr size_t MASK_WORDS = 16; // Up to 1024 nodes
+		constexpr unsigned long MASK_BITS = MASK_WORDS * 64;
+
+		// Highest node in /sys/devices/system/node/online ("0", "0-1", "0,2-3") plus one
+		int detect_nodes() {
+			FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+			if (!file) return 1;
+			char list[256] = {};
+			size_t length = std::fread(list, 1, sizeof(list) - 1, file);
+			std::fclose(file);
+			int highest = 0, value = 0;
+			bool digits = false;
+			for (size_t i = 0; i <= length; ++i) {
+				char c = list[i];
+				if (c >= '0' && c <= '9') {
+					value = value * 10 + (c - '0');
+					digits = true;
+					continue;
+				}
+				if (digits && value > highest) highest = value;
+				value = 0;
+				digits = false;
+			}
+			return highest + 1 < static_cast<int>(MASK_BITS) ? highest + 1 : static_cast<int>(MASK_BITS);
+		}
+
+		// Kernel policy and node mask for node, false when there is nothing to apply
+		bool policy_for(int node, int& mode, unsigned long (&mask)[MASK_WORDS]) {
+			int count = Numa::node_count();
+			if (count < 2) return false;
+			if (node == Numa::INTERLEAVE) {
+				for (int n = 0; n < count; ++n) mask[n / 64] |= 1ul << (n % 64);
+				mode = POLICY_INTERLEAVE;
+				return true;
+			}
+			if (node < 0 || node >= count) return false;
+			mask[node / 64] |= 1ul << (node % 64);
+			mode = POLICY_PREFERRED; // Spill to other nodes rather than fail when this one is full
+			return true;
+		}
+	}
+
+	int Numa::node_count() {
+		static const int count = detect_nodes();
+		return count;
+	}
+
+	int Numa::current_node() {
+		if (node_count() < 2) return 0;
+		unsigned cpu = 0, node = 0;
+		if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+		return static_cast<int>(node) < node_count() ? static_cast<int>(node) : 0;
+	}
+
+	bool Numa::place(void* ptr, size_t bytes, int node) {
+		unsigned long mask[MASK_WORDS] = {};
+		int mode;
+		if (!ptr || !bytes || !policy_for(node, mode, mask)) return false;
+		return syscall(SYS_mbind, ptr, bytes, mode, mask, MASK_BITS + 1, 0u) == 0;
+	}
+
+	bool Numa::prefer(int node) {
+		if (node_count() < 2) return false;
+		if (node == ANY) return syscall(SYS_set_mempolicy, POLICY_DEFAULT, nullptr, 0ul) == 0;
+		unsigned long mask[MASK_WORDS] = {};
+		int mode;
+		if (!policy_for(node, mode, mask)) return false;
+		return syscall(SYS_set_mempolicy, mode, mask, MASK_BITS + 1) == 0;
+	}
+
+	void* Numa::map(size_t bytes, int node) {
+		void* ptr = Pages::map(bytes);
+		if (ptr && node != ANY) place(ptr, bytes, node); // Before anything touches the pages
+		return ptr;
+	}
+#else
+	int Numa::node_count() {
+		return 1;
+	}
+
+	int Numa::current_node() {
+		return 0;
+	}
+
+	bool Numa::place(void*, size_t, int) {
+		return false;
+	}
+
+	bool Numa::prefer(int) {
+		return false;
+	}
+
+	void* Numa::map(size_t bytes, int) {
+		return Pages::map(bytes);
+	}
+#endif
+}
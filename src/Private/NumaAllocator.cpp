@@ -0,0 +1,132 @@
+#include "NumaAllocator.h"
+
+namespace devsw::stl {
+	struct NumaArena::Chunk {
+		Chunk* next;
+		size_t size;    // Mapped bytes, header included
+		size_t used;    // From the start of the chunk
+		bool dedicated; // One oversized request, unmapped by reset instead of pooled
+	};
+
+	namespace {
+		constexpr size_t align_up(size_t value, size_t alignment) {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	NumaArena::NumaArena(size_t chunk_size)
+		: chunk_size_(chunk_size > Pages::page_size() ? chunk_size : Pages::page_size()), nodes_(Numa::node_count()),
+		pools_(new Pool[nodes_ + 1]) {
+		for (int i = 0; i <= nodes_; ++i) pools_[i] = { nullptr, nullptr };
+	}
+
+	NumaArena::~NumaArena() {
+		trim();
+		for (int i = 0; i <= nodes_; ++i) {
+			for (Chunk* chunk = pools_[i].active; chunk;) {
+				Chunk* next = chunk->next;
+				Pages::unmap(chunk, chunk->size);
+				chunk = next;
+			}
+		}
+		delete[] pools_;
+	}
+
+	NumaArena::Pool& NumaArena::pool_for(int node) {
+		return node == Numa::INTERLEAVE ? pools_[nodes_] : pools_[node];
+	}
+
+	// Placed before the header is written, so even the first page lands on the node
+	NumaArena::Chunk* NumaArena::new_chunk(size_t size, int node) {
+		size = Pages::round(size);
+		Chunk* chunk = static_cast<Chunk*>(Numa::map(size, node));
+		if (!chunk) return nullptr;
+		chunk->next = nullptr;
+		chunk->size = size;
+		chunk->used = sizeof(Chunk);
+		chunk->dedicated = false;
+		stats_.on_reserve(size);
+		return chunk;
+	}
+
+	void* NumaArena::allocate(size_t bytes, int node, size_t alignment) {
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > Pages::page_size()) {
+			//TODO Errors...
+			return nullptr;
+		}
+		if (node != Numa::INTERLEAVE && (node < 0 || node >= nodes_)) node = Numa::current_node();
+		Pool& pool = pool_for(node);
+		Chunk* chunk = pool.active;
+
+		// Large requests, and any a fresh chunk could not hold once aligned (start <= page size <= chunk_size_)
+		if (bytes > chunk_size_ / 4 || bytes > chunk_size_ - align_up(sizeof(Chunk), alignment)) {
+			if (bytes > SIZE_MAX - sizeof(Chunk) - alignment - Pages::HUGE_PAGE) return nullptr;
+			Chunk* own = new_chunk(sizeof(Chunk) + alignment + bytes, node);
+			if (!own) return nullptr;
+			own->dedicated = true;
+			size_t start = align_up(sizeof(Chunk), alignment);
+			own->used = start + bytes;
+			// Behind the current chunk, which keeps serving small requests
+			if (chunk) {
+				own->next = chunk->next;
+				chunk->next = own;
+			}
+			else {
+				pool.active = own;
+			}
+			stats_.on_allocate(own->used - sizeof(Chunk), DEVSW_ALLOCATION_SITE());
+			return reinterpret_cast<char*>(own) + start;
+		}
+
+		size_t start = chunk ? align_up(chunk->used, alignment) : 0;
+		if (!chunk || chunk->dedicated || start + bytes > chunk->size) {
+			chunk = pool.free;
+			if (chunk) {
+				pool.free = chunk->next;
+			}
+			else {
+				chunk = new_chunk(chunk_size_, node);
+				if (!chunk) return nullptr;
+			}
+			chunk->next = pool.active;
+			pool.active = chunk;
+			start = align_up(chunk->used, alignment);
+		}
+		stats_.on_allocate(start + bytes - chunk->used, DEVSW_ALLOCATION_SITE());
+		chunk->used = start + bytes;
+		return reinterpret_cast<char*>(chunk) + start;
+	}
+
+	void NumaArena::reset() {
+		for (int i = 0; i <= nodes_; ++i) {
+			Pool& pool = pools_[i];
+			for (Chunk* chunk = pool.active; chunk;) {
+				Chunk* next = chunk->next;
+				stats_.on_deallocate(chunk->used - sizeof(Chunk));
+				if (chunk->dedicated) {
+					stats_.on_release(chunk->size);
+					Pages::unmap(chunk, chunk->size);
+				}
+				else {
+					chunk->used = sizeof(Chunk);
+					chunk->next = pool.free;
+					pool.free = chunk;
+				}
+				chunk = next;
+			}
+			pool.active = nullptr;
+		}
+	}
+
+	void NumaArena::trim() {
+		for (int i = 0; i <= nodes_; ++i) {
+			for (Chunk* chunk = pools_[i].free; chunk;) {
+				Chunk* next = chunk->next;
+				stats_.on_release(chunk->size);
+				Pages::unmap(chunk, chunk->size);
+				chunk = next;
+			}
+			pools_[i].free = nullptr;
+		}
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "Memory.h"
+
+namespace devsw::stl::kernels {
+	/**
+	* Uninitialized, cache line aligned scratch memory for the kernels. reserve grows it and does not keep the contents.
+	* S is the tier's SIMD type, so every Kernels*.cpp gets members of its own built with its own flags. AlignedVector's
+	* would be one weak symbol per element type across all of them, and the linker keeps whichever copy it meets first.
+	* The memory itself comes from outside the tiers: the heap, or Pages::map from Pages::MAP_THRESHOLD bytes up.
+	*/
+	template <typename S, typename T = typename S::value_type>
+	class Scratch {
+	public:
+		Scratch() = default;
+		explicit Scratch(size_t count) { reserve(count); }
+		~Scratch() { release(); }
+		Scratch(const Scratch&) = delete;
+		Scratch& operator=(const Scratch&) = delete;
+
+		void reserve(size_t count) {
+			if (count <= capacity_) return;
+			if (count > SIZE_MAX / sizeof(T) - ALIGNMENT) throw std::bad_alloc();
+			release();
+			size_t bytes = (count * sizeof(T) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+			if (bytes >= Pages::MAP_THRESHOLD) {
+				bytes = Pages::round(bytes);
+				data_ = static_cast<T*>(Pages::map(bytes));
+				if (!data_) throw std::bad_alloc();
+			}
+			else {
+				data_ = static_cast<T*>(::operator new(bytes, std::align_val_t(ALIGNMENT)));
+			}
+			bytes_ = bytes;
+			capacity_ = bytes / sizeof(T);
+		}
+
+		T* begin() const { return data_; }
+
+	private:
+		static constexpr size_t ALIGNMENT = 64;
+
+		void release() {
+			if (!data_) return;
+			if (bytes_ >= Pages::MAP_THRESHOLD) Pages::unmap(data_, bytes_);
+			else ::operator delete(data_, std::align_val_t(ALIGNMENT));
+			data_ = nullptr;
+			bytes_ = 0;
+			capacity_ = 0;
+		}
+
+		T* data_ = nullptr;
+		size_t bytes_ = 0;
+		size_t capacity_ = 0;
+	};
+}
@@ -0,0 +1,192 @@
+#include "SlabAllocator.h"
+#include "Memory.h"
+
+#include <bit>
+
+namespace devsw::stl {
+	namespace {
+		// Blocks of the 8 B class that fit in a slab, bounding every bitmap
+		constexpr size_t MAX_BLOCKS = SlabHeap::SLAB_SIZE / SlabHeap::MIN_SIZE;
+		constexpr size_t BITMAP_WORDS = MAX_BLOCKS / 64;
+		constexpr unsigned INVERSE_SHIFT = 40; // Exact block index from a multiply for any offset in a slab
+		constexpr size_t LARGE_HEADER = 64;
+
+		template <typename N>
+		void link(N*& head, N* node) {
+			node->prev = nullptr;
+			node->next = head;
+			if (head) head->prev = node;
+			head = node;
+		}
+
+		template <typename N>
+		void unlink(N*& head, N* node) {
+			if (node->prev) node->prev->next = node->next;
+			else head = node->next;
+			if (node->next) node->next->prev = node->prev;
+		}
+	}
+
+	struct SlabHeap::Slab {
+		Slab* prev;
+		Slab* next;
+		char* first;      // Block 0
+		uint64_t inverse; // ceil(2^INVERSE_SHIFT / block_size)
+		uint32_t size_class;
+		uint32_t block_size;
+		uint32_t capacity;
+		uint32_t used;
+		uint32_t hint;    // No clear bit below this bitmap word
+		uint64_t bits[BITMAP_WORDS]; // Set = allocated. The bits past capacity are set so they are never found
+	};
+
+	struct SlabHeap::Large {
+		Large* prev;
+		Large* next;
+		size_t mapped;
+	};
+
+	SlabHeap::SlabHeap() : large_(nullptr) {
+		for (SizeClass& c : classes_) c = { nullptr, nullptr, nullptr };
+	}
+
+	SlabHeap::~SlabHeap() {
+		for (SizeClass& c : classes_) {
+			for (Slab* list : { c.partial, c.full, c.spare }) {
+				while (list) {
+					Slab* next = list->next;
+					Pages::unmap(list, SLAB_SIZE);
+					stats_.on_release(SLAB_SIZE);
+					list = next;
+				}
+			}
+		}
+		while (large_) {
+			Large* next = large_->next;
+			stats_.on_release(large_->mapped);
+			Pages::unmap(large_, large_->mapped);
+			large_ = next;
+		}
+	}
+
+	void* SlabHeap::allocate(size_t bytes) {
+		if (bytes > MAX_SIZE) {
+			void* p = allocate_large(bytes);
+			if (p) stats_.on_allocate(bytes, DEVSW_ALLOCATION_SITE());
+			return p;
+		}
+		size_t index = size_class(bytes);
+		SizeClass& c = classes_[index];
+		Slab* slab = c.partial;
+		if (!slab) {
+			slab = new_slab(index);
+			if (!slab) return nullptr;
+		}
+		uint32_t word = slab->hint;
+		while (slab->bits[word] == ~uint64_t(0)) ++word;
+		uint32_t bit = static_cast<uint32_t>(std::countr_one(slab->bits[word]));
+		slab->bits[word] |= uint64_t(1) << bit;
+		slab->hint = word;
+		if (++slab->used == slab->capacity) {
+			unlink(c.partial, slab);
+			link(c.full, slab);
+		}
+		stats_.on_allocate(bytes, DEVSW_ALLOCATION_SITE());
+		return slab->first + (static_cast<size_t>(word) * 64 + bit) * slab->block_size;
+	}
+
+	void SlabHeap::deallocate(void* p, size_t bytes) {
+		if (!p) return;
+		if (bytes > MAX_SIZE) {
+			stats_.on_deallocate(bytes);
+			deallocate_large(p);
+			return;
+		}
+		Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p) & ~(SLAB_SIZE - 1));
+		size_t offset = static_cast<size_t>(static_cast<char*>(p) - slab->first);
+		size_t block = (offset * slab->inverse) >> INVERSE_SHIFT;
+		uint32_t word = static_cast<uint32_t>(block / 64);
+		uint64_t mask = uint64_t(1) << (block % 64);
+		if (!(slab->bits[word] & mask)) {
+			//TODO Errors... (double free, or not a block of this heap)
+			return;
+		}
+		stats_.on_deallocate(bytes);
+		slab->bits[word] &= ~mask;
+		if (word < slab->hint) slab->hint = word;
+		SizeClass& c = classes_[slab->size_class];
+		if (slab->used-- == slab->capacity) {
+			unlink(c.full, slab);
+			link(c.partial, slab);
+		}
+		if (slab->used == 0) {
+			unlink(c.partial, slab);
+			release(slab);
+		}
+	}
+
+	// A slab for class index on its partial list: the spare if there is one, otherwise fresh pages. Only the header is
+	// written, the blocks are left for first touch
+	SlabHeap::Slab* SlabHeap::new_slab(size_t index) {
+		SizeClass& c = classes_[index];
+		Slab* slab = c.spare;
+		if (slab) {
+			c.spare = nullptr;
+		}
+		else {
+			slab = static_cast<Slab*>(Pages::map_aligned(SLAB_SIZE, SLAB_SIZE));
+			if (!slab) return nullptr;
+			stats_.on_reserve(SLAB_SIZE);
+			size_t size = class_size(index);
+			size_t align = size & (~size + 1); // Largest power of two dividing the class size
+			if (align > 4096) align = 4096;
+			size_t start = (sizeof(Slab) + align - 1) & ~(align - 1);
+			slab->first = reinterpret_cast<char*>(slab) + start;
+			slab->block_size = static_cast<uint32_t>(size);
+			slab->inverse = ((uint64_t(1) << INVERSE_SHIFT) + size - 1) / size;
+			slab->size_class = static_cast<uint32_t>(index);
+			slab->capacity = static_cast<uint32_t>((SLAB_SIZE - start) / size);
+			// Fresh pages are zero, so only the words at and past the end of the blocks need bits
+			size_t last = slab->capacity / 64;
+			if (last < BITMAP_WORDS) {
+				slab->bits[last] = ~uint64_t(0) << (slab->capacity % 64);
+				for (size_t w = last + 1; w < BITMAP_WORDS; ++w) slab->bits[w] = ~uint64_t(0);
+			}
+		}
+		slab->used = 0;
+		slab->hint = 0;
+		link(c.partial, slab);
+		return slab;
+	}
+
+	// Empty slab: becomes the class spare, or goes back to the OS when there already is one
+	void SlabHeap::release(Slab* slab) {
+		SizeClass& c = classes_[slab->size_class];
+		if (!c.spare) {
+			slab->next = nullptr;
+			c.spare = slab;
+			return;
+		}
+		Pages::unmap(slab, SLAB_SIZE);
+		stats_.on_release(SLAB_SIZE);
+	}
+
+	void* SlabHeap::allocate_large(size_t bytes) {
+		static_assert(sizeof(Large) <= LARGE_HEADER, "The large object header must fit its cache line");
+		if (bytes > SIZE_MAX - LARGE_HEADER - Pages::HUGE_PAGE) return nullptr;
+		size_t mapped = Pages::round(bytes + LARGE_HEADER);
+		Large* large = static_cast<Large*>(Pages::map(mapped));
+		if (!large) return nullptr;
+		large->mapped = mapped;
+		link(large_, large);
+		stats_.on_reserve(mapped);
+		return reinterpret_cast<char*>(large) + LARGE_HEADER;
+	}
+
+	void SlabHeap::deallocate_large(void* p) {
+		Large* large = reinterpret_cast<Large*>(static_cast<char*>(p) - LARGE_HEADER);
+		unlink(large_, large);
+		stats_.on_release(large->mapped);
+		Pages::unmap(large, large->mapped);
+	}
+}
@@ -0,0 +1,343 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+#include "Simd.h"
+#include "Scratch.h"
+
+namespace devsw::stl::kernels {
+	/**
+	* Ascending sort in size classes.
+	* Up to one register of keys: a bitonic network in registers. Up to SortShape::MSD_MIN keys: every register sorted by
+	* the network, then bottom-up merge passes where each step merges the next register of either run into the running
+	* top register, again with a network (two sorted registers in, the lower half out). Past that, one radix pass on the
+	* most significant byte the keys disagree on splits them into 256 buckets, and every bucket small enough to stay in
+	* cache is sorted on its own; bigger ones split again on the next byte.
+	* Tiers without the network sort the small buckets with LSD radix sort on 8-bit digits instead: every histogram in one
+	* read, and passes whose digit is the same for every key skipped, so small integers in wide lanes take one or two.
+	* Floating point keys are sorted as signed integers after flipping the magnitude bits of the negative values. That
+	* is a total order: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN.
+	* @note argsort is LSD radix only, with the index riding along, which also makes it stable.
+	*/
+	template <typename S>
+	struct SortShape {
+		// About 256 KiB of keys, an L2 sized bucket. Below that the merge passes beat a scatter through memory
+		static constexpr size_t MSD_MIN = (256 * 1024) / sizeof(typename S::value_type);
+	};
+
+	// Below this many keys a tier without the network uses insertion sort, and argsort always does
+	constexpr size_t INSERTION_MAX = 32;
+
+	template <typename T> using sort_key_t = conditional_t<std::is_floating_point_v<T>, conditional_t<sizeof(T) == 4, int32_t, int64_t>, T>;
+
+	// Floating point bits to signed integers in the same order, or back: it is its own inverse
+	template <template <typename> class V, typename I>
+	void flip_float_keys(I* keys, size_t n) {
+		using U = std::make_unsigned_t<I>;
+		for (size_t i = 0; i < n; ++i) {
+			U negative = static_cast<U>(keys[i] >> (sizeof(I) * 8 - 1));
+			keys[i] = static_cast<I>(static_cast<U>(keys[i]) ^ (negative >> 1));
+		}
+	}
+
+	// Order preserving unsigned radix key, the sign bit flipped for signed types
+	template <typename T>
+	FORCEINLINE std::make_unsigned_t<T> radix_key(T key) {
+		using U = std::make_unsigned_t<T>;
+		constexpr U bias = std::is_signed_v<T> ? static_cast<U>(U(1) << (sizeof(T) * 8 - 1)) : U(0);
+		return static_cast<U>(static_cast<U>(key) ^ bias);
+	}
+
+	template <template <typename> class V, typename T>
+	void insertion_sort(T* data, size_t n) {
+		for (size_t i = 1; i < n; ++i) {
+			T v = data[i];
+			size_t j = i;
+			for (; j > 0 && v < data[j - 1]; --j) data[j] = data[j - 1];
+			data[j] = v;
+		}
+	}
+
+	// ================= Bitonic Network =================
+
+	// Lanes that keep the max of a compare-exchange against lane i ^ Xor: the upper lane of each pair
+	template <size_t Lanes, size_t Xor>
+	constexpr uint64_t upper_lanes() {
+		uint64_t bits = 0;
+		for (size_t i = 0; i < Lanes; ++i)
+			if (i & std::bit_floor(Xor)) bits |= uint64_t(1) << i;
+		return bits;
+	}
+
+	template <typename S, size_t Xor>
+	FORCEINLINE typename S::reg exchange(typename S::reg v) {
+		typename S::reg partner = S::template permute_xor<Xor>(v);
+		return S::template blend_lanes<upper_lanes<S::lanes, Xor>()>(S::min(v, partner), S::max(v, partner));
+	}
+
+	// Half cleaners Xor, Xor / 2, ..., 1, sorts every bitonic block of 2 * Xor lanes
+	template <typename S, size_t Xor>
+	FORCEINLINE typename S::reg clean(typename S::reg v) {
+		v = exchange<S, Xor>(v);
+		if constexpr (Xor > 1) return clean<S, Xor / 2>(v);
+		else return v;
+	}
+
+	// Blocks of Block lanes, each the merge of two sorted halves: the flip (lane i against i ^ (Block - 1)) turns
+	// both halves bitonic, the cleaners finish them
+	template <typename S, size_t Block = 2>
+	FORCEINLINE typename S::reg sort_register(typename S::reg v) {
+		v = exchange<S, Block - 1>(v);
+		if constexpr (Block > 2) v = clean<S, Block / 4>(v);
+		if constexpr (Block < S::lanes) return sort_register<S, Block * 2>(v);
+		else return v;
+	}
+
+	// Two sorted registers in, lo gets the lower half of the union and hi the upper, both sorted
+	template <typename S>
+	FORCEINLINE void merge_registers(typename S::reg& lo, typename S::reg& hi) {
+		typename S::reg reversed = S::template permute_xor<S::lanes - 1>(hi);
+		typename S::reg low = S::min(lo, reversed);
+		typename S::reg high = S::max(lo, reversed);
+		lo = clean<S, S::lanes / 2>(low);
+		hi = clean<S, S::lanes / 2>(high);
+	}
+
+	// ================= Merge Sort =================
+
+	// Sorted runs a[0, na) and b[0, nb), whole registers each, into out. The run whose next register starts lower
+	// feeds the network, which emits the lowest lanes registers of everything seen so far
+	template <typename S>
+	void merge_runs(typename S::value_type* out, const typename S::value_type* a, size_t na, const typename S::value_type* b, size_t nb) {
+		using T = typename S::value_type;
+		using reg = typename S::reg;
+		const T* a_end = a + na;
+		const T* b_end = b + nb;
+		reg lo = S::loadu(a);
+		reg hi = S::loadu(b);
+		a += S::lanes;
+		b += S::lanes;
+		merge_registers<S>(lo, hi);
+		S::storeu(out, lo);
+		out += S::lanes;
+		while (a < a_end || b < b_end) {
+			bool take_a = b == b_end || (a < a_end && *a <= *b);
+			lo = S::loadu(take_a ? a : b);
+			a += take_a ? S::lanes : 0;
+			b += take_a ? 0 : S::lanes;
+			merge_registers<S>(lo, hi);
+			S::storeu(out, lo);
+			out += S::lanes;
+		}
+		S::storeu(out, hi);
+	}
+
+	// Padded to whole registers with the largest key, which sorts to the end and is cut off again. buffer is grown to
+	// twice the padded size and can be handed to the next call
+	template <typename S>
+	void merge_sort(typename S::value_type* data, size_t n, Scratch<S>& buffer) {
+		using T = typename S::value_type;
+		constexpr size_t L = S::lanes;
+		size_t padded = (n + L - 1) / L * L;
+		buffer.reserve(2 * padded);
+		T* src = buffer.begin();
+		T* dst = src + padded;
+		typename S::reg pad = S::set1(std::numeric_limits<T>::max());
+		for (size_t i = 0; i < padded; i += L) {
+			typename S::reg v = n - i >= L ? S::loadu(data + i) : S::load_partial(data + i, n - i, pad);
+			S::storeu(src + i, sort_register<S>(v));
+		}
+		for (size_t run = L; run < padded; run *= 2) {
+			for (size_t i = 0; i < padded; i += 2 * run) {
+				size_t na = padded - i < run ? padded - i : run;
+				size_t nb = padded - i - na < run ? padded - i - na : run;
+				if (nb == 0) std::memcpy(dst + i, src + i, na * sizeof(T));
+				else merge_runs<S>(dst + i, src + i, na, src + i + na, nb);
+			}
+			T* swap = src;
+			src = dst;
+			dst = swap;
+		}
+		std::memcpy(data, src, n * sizeof(T));
+	}
+
+	// ================= Radix Sort =================
+
+	// One byte keys: a histogram is the whole sort
+	template <template <typename> class V, typename T>
+	void counting_sort(T* data, size_t n) {
+		size_t counts[256] = {};
+		for (size_t i = 0; i < n; ++i) ++counts[radix_key(data[i])];
+		size_t out = 0;
+		for (size_t digit = 0; digit < 256; ++digit) {
+			std::memset(data + out, static_cast<int>(radix_key(static_cast<T>(digit))), counts[digit]);
+			out += counts[digit];
+		}
+	}
+
+	// Counts to starting offsets, in place
+	FORCEINLINE void radix_offsets(size_t* counts) {
+		size_t total = 0;
+		for (size_t digit = 0; digit < 256; ++digit) {
+			size_t count = counts[digit];
+			counts[digit] = total;
+			total += count;
+		}
+	}
+
+	// LSD, least significant byte first. buffer is grown to n
+	template <template <typename> class V, typename T>
+	void radix_sort(T* data, size_t n, Scratch<V<T>>& buffer) {
+		constexpr size_t DIGITS = sizeof(T);
+		size_t counts[DIGITS][256] = {};
+		for (size_t i = 0; i < n; ++i) {
+			auto key = radix_key(data[i]);
+			for (size_t d = 0; d < DIGITS; ++d) ++counts[d][(key >> (8 * d)) & 0xFF];
+		}
+		buffer.reserve(n);
+		T* src = data;
+		T* dst = buffer.begin();
+		for (size_t d = 0; d < DIGITS; ++d) {
+			size_t* offsets = counts[d];
+			size_t shift = 8 * d;
+			if (offsets[(radix_key(src[0]) >> shift) & 0xFF] == n) continue;
+			radix_offsets(offsets);
+			for (size_t i = 0; i < n; ++i) dst[offsets[(radix_key(src[i]) >> shift) & 0xFF]++] = src[i];
+			T* swap = src;
+			src = dst;
+			dst = swap;
+		}
+		if (src != data) std::memcpy(data, src, n * sizeof(T));
+	}
+
+	// Integer keys below the MSD cutoff
+	template <template <typename> class V, typename T>
+	void sort_small(T* data, size_t n, Scratch<V<T>>& buffer) {
+		using S = V<T>;
+		if (n < 2) return;
+		if constexpr (S::sortable) {
+			if (n <= S::lanes) S::store_partial(data, sort_register<S>(S::load_partial(data, n, S::set1(std::numeric_limits<T>::max()))), n);
+			else merge_sort<S>(data, n, buffer);
+		}
+		else {
+			if (n <= INSERTION_MAX) insertion_sort<V>(data, n);
+			else radix_sort<V>(data, n, buffer);
+		}
+	}
+
+	// MSD, one scatter through memory on byte Digit (the bytes above it are the same for every key), then each bucket
+	// on its own. partition holds n keys, buffer is the small sorts' scratch
+	template <template <typename> class V, typename T>
+	void msd_sort(T* data, size_t n, size_t digit, T* partition, Scratch<V<T>>& buffer) {
+		size_t counts[256];
+		size_t shift;
+		for (;; --digit) {
+			shift = 8 * digit;
+			std::memset(counts, 0, sizeof(counts));
+			for (size_t i = 0; i < n; ++i) ++counts[(radix_key(data[i]) >> shift) & 0xFF];
+			if (counts[(radix_key(data[0]) >> shift) & 0xFF] != n) break;
+			if (digit == 0) return; // Every key equal
+		}
+		size_t starts[256];
+		radix_offsets(counts);
+		std::memcpy(starts, counts, sizeof(starts));
+		for (size_t i = 0; i < n; ++i) partition[counts[(radix_key(data[i]) >> shift) & 0xFF]++] = data[i];
+		std::memcpy(data, partition, n * sizeof(T));
+		if (digit == 0) return;
+		for (size_t bucket = 0; bucket < 256; ++bucket) {
+			size_t begin = starts[bucket];
+			size_t size = counts[bucket] - begin;
+			if (size < SortShape<V<T>>::MSD_MIN) sort_small<V>(data + begin, size, buffer);
+			else msd_sort<V>(data + begin, size, digit - 1, partition + begin, buffer);
+		}
+	}
+
+	// Stable, index[k] is the position in keys of the k-th smallest. Works on a copy of the radix keys
+	template <template <typename> class V, typename T>
+	void radix_argsort(size_t* index, const T* keys, size_t n) {
+		using K = sort_key_t<T>;
+		using U = std::make_unsigned_t<K>;
+		constexpr size_t DIGITS = sizeof(T);
+		Scratch<V<U>> key_buffer(2 * n);
+		U* key_src = key_buffer.begin();
+		U* key_dst = key_src + n;
+		std::memcpy(key_src, keys, n * sizeof(T));
+		if constexpr (std::is_floating_point_v<T>) flip_float_keys<V>(reinterpret_cast<K*>(key_src), n);
+		size_t counts[DIGITS][256] = {};
+		for (size_t i = 0; i < n; ++i) {
+			U key = radix_key(static_cast<K>(key_src[i]));
+			key_src[i] = key;
+			index[i] = i;
+			for (size_t d = 0; d < DIGITS; ++d) ++counts[d][(key >> (8 * d)) & 0xFF];
+		}
+		if (n <= INSERTION_MAX) {
+			for (size_t i = 1; i < n; ++i) {
+				U key = key_src[i];
+				size_t j = i;
+				for (; j > 0 && key < key_src[j - 1]; --j) {
+					key_src[j] = key_src[j - 1];
+					index[j] = index[j - 1];
+				}
+				key_src[j] = key;
+				index[j] = i;
+			}
+			return;
+		}
+		Scratch<V<U>, size_t> index_buffer(n);
+		size_t* index_src = index;
+		size_t* index_dst = index_buffer.begin();
+		for (size_t d = 0; d < DIGITS; ++d) {
+			size_t* offsets = counts[d];
+			size_t shift = 8 * d;
+			if (offsets[(key_src[0] >> shift) & 0xFF] == n) continue;
+			radix_offsets(offsets);
+			for (size_t i = 0; i < n; ++i) {
+				size_t slot = offsets[(key_src[i] >> shift) & 0xFF]++;
+				key_dst[slot] = key_src[i];
+				index_dst[slot] = index_src[i];
+			}
+			U* key_swap = key_src;
+			key_src = key_dst;
+			key_dst = key_swap;
+			size_t* index_swap = index_src;
+			index_src = index_dst;
+			index_dst = index_swap;
+		}
+		if (index_src != index) std::memcpy(index, index_src, n * sizeof(size_t));
+	}
+
+	// ================= Entry Points =================
+
+	template <template <typename> class V, typename T>
+	void sort(T* data, size_t n) {
+		if constexpr (std::is_floating_point_v<T>) {
+			using I = sort_key_t<T>;
+			I* keys = reinterpret_cast<I*>(data);
+			flip_float_keys<V>(keys, n);
+			sort<V, I>(keys, n);
+			flip_float_keys<V>(keys, n);
+		}
+		else if constexpr (sizeof(T) == 1) {
+			if (n <= INSERTION_MAX) insertion_sort<V>(data, n);
+			else counting_sort<V>(data, n);
+		}
+		else {
+			Scratch<V<T>> buffer;
+			if (n < SortShape<V<T>>::MSD_MIN) {
+				sort_small<V>(data, n, buffer);
+				return;
+			}
+			Scratch<V<T>> partition(n);
+			msd_sort<V>(data, n, sizeof(T) - 1, partition.begin(), buffer);
+		}
+	}
+
+	template <template <typename> class V, typename T>
+	void argsort(size_t* index, const T* keys, size_t n) {
+		radix_argsort<V>(index, keys, n);
+	}
+}
@@ -0,0 +1,158 @@
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace devsw::stl {
+	namespace {
+		thread_local bool inside_task = false;
+
+		class Pool {
+		public:
+			~Pool() { stop(); }
+
+			void run(size_t chunks, ThreadPool::Task task, void* context) {
+				std::lock_guard<std::mutex> job_guard(job_mutex_);
+				start();
+				{
+					// A worker that woke up too late for the previous job may still be draining its counter
+					std::unique_lock<std::mutex> lock(mutex_);
+					done_.wait(lock, [this] { return active_ == 0; });
+					task_ = task;
+					context_ = context;
+					chunks_ = chunks;
+					next_.store(0, std::memory_order_relaxed);
+					remaining_ = chunks;
+					++generation_;
+				}
+				wake_.notify_all();
+
+				inside_task = true;
+				work(task, context, chunks);
+				inside_task = false;
+
+				// Every worker that joined this generation has to leave before the next job can reuse the counters
+				std::unique_lock<std::mutex> lock(mutex_);
+				done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0; });
+			}
+
+			size_t concurrency() {
+				std::lock_guard<std::mutex> job_guard(job_mutex_);
+				start();
+				return workers_.size() + 1;
+			}
+
+			void set_concurrency(size_t threads) {
+				std::lock_guard<std::mutex> job_guard(job_mutex_);
+				stop();
+				requested_ = threads ? threads : 1;
+				start();
+			}
+
+		private:
+			void start() {
+				if (started_) return;
+				size_t threads = requested_;
+				if (!threads) {
+					if (const char* forced = std::getenv("DEVSW_THREADS")) threads = std::strtoul(forced, nullptr, 10);
+					if (!threads) threads = std::thread::hardware_concurrency();
+					if (!threads) threads = 1;
+				}
+				stopping_ = false;
+				workers_.reserve(threads - 1);
+				for (size_t i = 1; i < threads; ++i) workers_.emplace_back([this] { worker(); });
+				started_ = true;
+			}
+
+			void stop() {
+				if (!started_) return;
+				{
+					std::lock_guard<std::mutex> guard(mutex_);
+					stopping_ = true;
+				}
+				wake_.notify_all();
+				for (std::thread& thread : workers_) thread.join();
+				workers_.clear();
+				started_ = false;
+			}
+
+			void worker() {
+				inside_task = true;
+				uint64_t seen = 0;
+				std::unique_lock<std::mutex> lock(mutex_);
+				for (;;) {
+					wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+					if (stopping_) return;
+					seen = generation_;
+					ThreadPool::Task task = task_;
+					void* context = context_;
+					size_t chunks = chunks_;
+					++active_;
+					lock.unlock();
+
+					work(task, context, chunks);
+
+					lock.lock();
+					if (--active_ == 0 && remaining_ == 0) done_.notify_all();
+				}
+			}
+
+			void work(ThreadPool::Task task, void* context, size_t chunks) {
+				size_t finished = 0;
+				for (size_t chunk = next_.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+					chunk = next_.fetch_add(1, std::memory_order_relaxed)) {
+					task(context, chunk);
+					++finished;
+				}
+				if (!finished) return;
+				std::lock_guard<std::mutex> guard(mutex_);
+				remaining_ -= finished;
+				if (remaining_ == 0 && active_ == 0) done_.notify_all();
+			}
+
+			std::mutex job_mutex_; // One job at a time
+			std::mutex mutex_;
+			std::condition_variable wake_;
+			std::condition_variable done_;
+			std::vector<std::thread> workers_;
+			size_t requested_ = 0;
+			bool started_ = false;
+			bool stopping_ = false;
+
+			uint64_t generation_ = 0;
+			ThreadPool::Task task_ = nullptr;
+			void* context_ = nullptr;
+			size_t chunks_ = 0;
+			std::atomic<size_t> next_{ 0 };
+			size_t remaining_ = 0;
+			size_t active_ = 0;
+		};
+
+		Pool& pool() {
+			static Pool instance;
+			return instance;
+		}
+	}
+
+	void ThreadPool::run(size_t chunks, Task task, void* context) {
+		if (chunks == 0) return;
+		if (chunks == 1 || inside_task) {
+			for (size_t chunk = 0; chunk < chunks; ++chunk) task(context, chunk);
+			return;
+		}
+		pool().run(chunks, task, context);
+	}
+
+	size_t ThreadPool::concurrency() {
+		return pool().concurrency();
+	}
+
+	void ThreadPool::set_concurrency(size_t threads) {
+		pool().set_concurrency(threads);
+	}
+}
@@ -1,2 +1,6 @@
 #include "devswSTL.h"
-void devswSTL Init() {}
+#include "Dispatch.h"
+
+void devswSTL Init() {
+	devsw::stl::Dispatch::init();
+}
@@ -4,17 +4,267 @@
 #include "devswSTL.h"
 #include <immintrin.h>
 
+#ifndef FORCEINLINE
+#if defined(_MSC_VER)
+#define FORCEINLINE __forceinline
+#else
+#define FORCEINLINE inline __attribute__((always_inline))
+#endif
+#endif
+
 #ifndef FUNC
-#define FUNC static inline
+#define FUNC static FORCEINLINE
 #endif
 
 
 namespace devsw::stl {
+    /**
+    * Shuffle controls for left-packing the lanes selected by a mask (stream compaction) on tiers without vpcompress.
+    * Row m moves the set lanes of m to the bottom in order; the lanes above are don't-care.
+    */
+    struct CompressTables {
+        alignas(32) uint32_t dword8[256][8];  // vpermd, 8 x 32-bit lanes
+        alignas(32) uint32_t qword4[16][8];   // vpermd on dword pairs, 4 x 64-bit lanes
+        alignas(16) uint8_t dword4[16][16];   // pshufb, 4 x 32-bit lanes
+        alignas(16) uint8_t qword2[4][16];    // pshufb, 2 x 64-bit lanes
+
+        static constexpr CompressTables build() {
+            CompressTables t{};
+            for (uint32_t m = 0; m < 256; ++m) {
+                uint32_t k = 0;
+                for (uint32_t lane = 0; lane < 8; ++lane)
+                    if (m >> lane & 1) t.dword8[m][k++] = lane;
+            }
+            for (uint32_t m = 0; m < 16; ++m) {
+                uint32_t k = 0;
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if (!(m >> lane & 1)) continue;
+                    t.qword4[m][2 * k] = 2 * lane;
+                    t.qword4[m][2 * k + 1] = 2 * lane + 1;
+                    for (uint32_t byte = 0; byte < 4; ++byte) t.dword4[m][4 * k + byte] = static_cast<uint8_t>(4 * lane + byte);
+                    ++k;
+                }
+            }
+            for (uint32_t m = 0; m < 4; ++m) {
+                uint32_t k = 0;
+                for (uint32_t lane = 0; lane < 2; ++lane) {
+                    if (!(m >> lane & 1)) continue;
+                    for (uint32_t byte = 0; byte < 8; ++byte) t.qword2[m][8 * k + byte] = static_cast<uint8_t>(8 * lane + byte);
+                    ++k;
+                }
+            }
+            return t;
+        }
+    };
+
+    inline constexpr CompressTables compress_tables = CompressTables::build();
+
     struct devswSTL AVXUtils {
+        // ================= SSE4.2 Floating-Point Operations (128-bit) =================
+        // Single-precision (f32)
+        FUNC __m128 load_f32_128(const float* ptr) { return _mm_load_ps(ptr); }
+        FUNC void store_f32_128(float* ptr, __m128 vec) { _mm_store_ps(ptr, vec); }
+        FUNC __m128 loadu_f32_128(const float* ptr) { return _mm_loadu_ps(ptr); }
+        FUNC void storeu_f32_128(float* ptr, __m128 vec) { _mm_storeu_ps(ptr, vec); }
+        FUNC void stream_f32_128(float* ptr, __m128 vec) { _mm_stream_ps(ptr, vec); }
+        FUNC __m128 add_f32_128(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+        FUNC __m128 sub_f32_128(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+        FUNC __m128 mul_f32_128(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+        FUNC __m128 div_f32_128(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+        FUNC __m128 min_f32_128(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+        FUNC __m128 max_f32_128(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+        FUNC __m128 abs_f32_128(__m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        FUNC __m128 sqrt_f32_128(__m128 a) { return _mm_sqrt_ps(a); }
+        FUNC __m128 fmadd_f32_128(__m128 a, __m128 b, __m128 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); } // No FMA before AVX2, rounds twice
+
+        // Double-precision (f64)
+        FUNC __m128d load_f64_128(const double* ptr) { return _mm_load_pd(ptr); }
+        FUNC void store_f64_128(double* ptr, __m128d vec) { _mm_store_pd(ptr, vec); }
+        FUNC __m128d loadu_f64_128(const double* ptr) { return _mm_loadu_pd(ptr); }
+        FUNC void storeu_f64_128(double* ptr, __m128d vec) { _mm_storeu_pd(ptr, vec); }
+        FUNC void stream_f64_128(double* ptr, __m128d vec) { _mm_stream_pd(ptr, vec); }
+        FUNC __m128d add_f64_128(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+        FUNC __m128d sub_f64_128(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+        FUNC __m128d mul_f64_128(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+        FUNC __m128d div_f64_128(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+        FUNC __m128d min_f64_128(__m128d a, __m128d b) { return _mm_min_pd(a, b); }
+        FUNC __m128d max_f64_128(__m128d a, __m128d b) { return _mm_max_pd(a, b); }
+        FUNC __m128d abs_f64_128(__m128d a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+        FUNC __m128d sqrt_f64_128(__m128d a) { return _mm_sqrt_pd(a); }
+        FUNC __m128d fmadd_f64_128(__m128d a, __m128d b, __m128d c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+        // ================= SSE4.2 Integer Operations (128-bit) =================
+        // Loads and stores are width agnostic, the typed names keep call sites readable
+        FUNC __m128i load_i128(const void* ptr) { return _mm_load_si128((const __m128i*)ptr); }
+        FUNC void store_i128(void* ptr, __m128i vec) { _mm_store_si128((__m128i*)ptr, vec); }
+        FUNC __m128i loadu_i128(const void* ptr) { return _mm_loadu_si128((const __m128i*)ptr); }
+        FUNC void storeu_i128(void* ptr, __m128i vec) { _mm_storeu_si128((__m128i*)ptr, vec); }
+        // Non-temporal stores: aligned, write-combined straight to memory without reading the line in first.
+        // Weakly ordered, so a run of them ends with sfence before anything else may rely on the data
+        FUNC void stream_i128(void* ptr, __m128i vec) { _mm_stream_si128((__m128i*)ptr, vec); }
+        FUNC void sfence() { _mm_sfence(); }
+
+        // 8-bit (i8/u8)
+        FUNC __m128i add_i8_128(__m128i a, __m128i b) { return _mm_add_epi8(a, b); }
+        FUNC __m128i sub_i8_128(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+        FUNC __m128i mul_i8_128(__m128i a, __m128i b) {
+            __m128i even = _mm_mullo_epi16(a, b);
+            __m128i odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+            return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi16(0xFF)), _mm_slli_epi16(odd, 8));
+        }
+        FUNC __m128i min_i8_128(__m128i a, __m128i b) { return _mm_min_epi8(a, b); }
+        FUNC __m128i max_i8_128(__m128i a, __m128i b) { return _mm_max_epi8(a, b); }
+        FUNC __m128i min_u8_128(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+        FUNC __m128i max_u8_128(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+        FUNC __m128i abs_i8_128(__m128i a) { return _mm_abs_epi8(a); }
+
+        // 16-bit (i16/u16)
+        FUNC __m128i add_i16_128(__m128i a, __m128i b) { return _mm_add_epi16(a, b); }
+        FUNC __m128i sub_i16_128(__m128i a, __m128i b) { return _mm_sub_epi16(a, b); }
+        FUNC __m128i mul_i16_128(__m128i a, __m128i b) { return _mm_mullo_epi16(a, b); }
+        FUNC __m128i min_i16_128(__m128i a, __m128i b) { return _mm_min_epi16(a, b); }
+        FUNC __m128i max_i16_128(__m128i a, __m128i b) { return _mm_max_epi16(a, b); }
+        FUNC __m128i min_u16_128(__m128i a, __m128i b) { return _mm_min_epu16(a, b); }
+        FUNC __m128i max_u16_128(__m128i a, __m128i b) { return _mm_max_epu16(a, b); }
+        FUNC __m128i abs_i16_128(__m128i a) { return _mm_abs_epi16(a); }
+
+        // 32-bit (i32/u32)
+        FUNC __m128i add_i32_128(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+        FUNC __m128i sub_i32_128(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+        FUNC __m128i mul_i32_128(__m128i a, __m128i b) { return _mm_mullo_epi32(a, b); }
+        FUNC __m128i min_i32_128(__m128i a, __m128i b) { return _mm_min_epi32(a, b); }
+        FUNC __m128i max_i32_128(__m128i a, __m128i b) { return _mm_max_epi32(a, b); }
+        FUNC __m128i min_u32_128(__m128i a, __m128i b) { return _mm_min_epu32(a, b); }
+        FUNC __m128i max_u32_128(__m128i a, __m128i b) { return _mm_max_epu32(a, b); }
+        FUNC __m128i abs_i32_128(__m128i a) { return _mm_abs_epi32(a); }
+
+        // 64-bit (i64/u64)
+        FUNC __m128i add_i64_128(__m128i a, __m128i b) { return _mm_add_epi64(a, b); }
+        FUNC __m128i sub_i64_128(__m128i a, __m128i b) { return _mm_sub_epi64(a, b); }
+        FUNC __m128i mul_i64_128(__m128i a, __m128i b) {
+            __m128i lo = _mm_mul_epu32(a, b);
+            __m128i mid1 = _mm_mul_epu32(a, _mm_srli_epi64(b, 32));
+            __m128i mid2 = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+            return _mm_add_epi64(lo, _mm_slli_epi64(_mm_add_epi64(mid1, mid2), 32));
+        }
+        FUNC __m128i min_i64_128(__m128i a, __m128i b) { return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(a, b)); }
+        FUNC __m128i max_i64_128(__m128i a, __m128i b) { return _mm_blendv_epi8(b, a, _mm_cmpgt_epi64(a, b)); }
+        FUNC __m128i min_u64_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi64x(INT64_MIN);
+            return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)));
+        }
+        FUNC __m128i max_u64_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi64x(INT64_MIN);
+            return _mm_blendv_epi8(b, a, _mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)));
+        }
+        FUNC __m128i abs_i64_128(__m128i a) {
+            __m128i sign = _mm_cmpgt_epi64(_mm_setzero_si128(), a);
+            return _mm_sub_epi64(_mm_xor_si128(a, sign), sign);
+        }
+
+        // ================= SSE4.2 Compare, Blend and Movemask (128-bit) =================
+        // Compares give all-ones lanes. There is only a signed greater-than, unsigned lanes flip the sign bit first
+        FUNC __m128i cmpeq_i8_128(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+        FUNC __m128i cmpeq_i16_128(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+        FUNC __m128i cmpeq_i32_128(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+        FUNC __m128i cmpeq_i64_128(__m128i a, __m128i b) { return _mm_cmpeq_epi64(a, b); }
+        FUNC __m128i cmpgt_i8_128(__m128i a, __m128i b) { return _mm_cmpgt_epi8(a, b); }
+        FUNC __m128i cmpgt_i16_128(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+        FUNC __m128i cmpgt_i32_128(__m128i a, __m128i b) { return _mm_cmpgt_epi32(a, b); }
+        FUNC __m128i cmpgt_i64_128(__m128i a, __m128i b) { return _mm_cmpgt_epi64(a, b); }
+        FUNC __m128i cmpgt_u8_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi8(char(0x80));
+            return _mm_cmpgt_epi8(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        }
+        FUNC __m128i cmpgt_u16_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi16(short(0x8000));
+            return _mm_cmpgt_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        }
+        FUNC __m128i cmpgt_u32_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi32(INT32_MIN);
+            return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        }
+        FUNC __m128i cmpgt_u64_128(__m128i a, __m128i b) {
+            __m128i bias = _mm_set1_epi64x(INT64_MIN);
+            return _mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        }
+        FUNC __m128i not_i128(__m128i a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+        // Lanes of a where mask is set, b elsewhere
+        FUNC __m128i blend_i128(__m128i mask, __m128i a, __m128i b) { return _mm_blendv_epi8(b, a, mask); }
+        FUNC __m128 blend_f32_128(__m128 mask, __m128 a, __m128 b) { return _mm_blendv_ps(b, a, mask); }
+        FUNC __m128d blend_f64_128(__m128d mask, __m128d a, __m128d b) { return _mm_blendv_pd(b, a, mask); }
+        // One bit per lane, lane 0 in bit 0. 16-bit lanes are narrowed with a saturating pack first
+        FUNC uint32_t movemask_i8_128(__m128i mask) { return static_cast<uint32_t>(_mm_movemask_epi8(mask)); }
+        FUNC uint32_t movemask_i16_128(__m128i mask) { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(mask, _mm_setzero_si128()))); }
+        FUNC uint32_t movemask_i32_128(__m128i mask) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(mask))); }
+        FUNC uint32_t movemask_i64_128(__m128i mask) { return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(mask))); }
+        FUNC uint32_t movemask_f32_128(__m128 mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+        FUNC uint32_t movemask_f64_128(__m128d mask) { return static_cast<uint32_t>(_mm_movemask_pd(mask)); }
+        // Selected lanes packed to the bottom, mask holds one bit per lane
+        FUNC __m128i compress_i32_128(__m128i v, uint32_t mask) { return _mm_shuffle_epi8(v, _mm_load_si128((const __m128i*)compress_tables.dword4[mask])); }
+        FUNC __m128i compress_i64_128(__m128i v, uint32_t mask) { return _mm_shuffle_epi8(v, _mm_load_si128((const __m128i*)compress_tables.qword2[mask])); }
+
+        // Into every cache level. SSE, so even the scalar tier can hide a random table access behind the loop
+        FUNC void prefetch(const void* ptr) { _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0); }
+
+        // ================= SSE4.2 Lane Shifts (128-bit) =================
+        // v moved up by Bytes towards the top lane, the vacated bottom filled from the top of fill (a broadcast).
+        // The shift-and-combine step of an in-register prefix scan
+        template <int Bytes> FUNC __m128i shift_up_128(__m128i v, __m128i fill) { return _mm_alignr_epi8(v, fill, 16 - Bytes); }
+        // Every Bytes wide lane set to the top lane of v, the carry into the next vector of a scan
+        template <int Bytes> FUNC __m128i broadcast_top_128(__m128i v) {
+            if constexpr (Bytes == 8) return _mm_shuffle_epi32(v, 0xEE);
+            else if constexpr (Bytes == 4) return _mm_shuffle_epi32(v, 0xFF);
+            else if constexpr (Bytes == 2) return _mm_shuffle_epi8(v, _mm_set1_epi16(0x0F0E));
+            else return _mm_shuffle_epi8(v, _mm_set1_epi8(15));
+        }
+
+        // ================= SSE4.2 Conversions and Int8 Dot (128-bit) =================
+        // 4 f32 lanes against 4 narrow elements in memory. Narrowing to 8 bits rounds to nearest even and saturates
+        FUNC __m128 cvt_i8_f32_128(const int8_t* ptr) { return _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_loadu_si32(ptr))); }
+        FUNC __m128 cvt_u8_f32_128(const uint8_t* ptr) { return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_loadu_si32(ptr))); }
+        FUNC void cvt_f32_i8_128(int8_t* ptr, __m128 v) {
+            __m128i narrow = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-128.0f)), _mm_set1_ps(127.0f)));
+            narrow = _mm_packs_epi32(narrow, narrow);
+            _mm_storeu_si32(ptr, _mm_packs_epi16(narrow, narrow));
+        }
+        FUNC void cvt_f32_u8_128(uint8_t* ptr, __m128 v) {
+            __m128i narrow = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+            narrow = _mm_packs_epi32(narrow, narrow);
+            _mm_storeu_si32(ptr, _mm_packus_epi16(narrow, narrow));
+        }
+        FUNC __m128 cvt_bf16_f32_128(const uint16_t* ptr) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)ptr)), 16)); }
+        // Round to nearest even on the 16 dropped bits, NaNs are quieted instead so they cannot round into infinity
+        FUNC __m128i round_f32_bf16_128(__m128 v) {
+            __m128i bits = _mm_castps_si128(v);
+            __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+            __m128i rounded = _mm_srli_epi32(_mm_add_epi32(bits, _mm_add_epi32(odd, _mm_set1_epi32(0x7FFF))), 16);
+            __m128i quiet = _mm_or_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x40));
+            return _mm_blendv_epi8(rounded, quiet, _mm_castps_si128(_mm_cmpunord_ps(v, v)));
+        }
+        FUNC void cvt_f32_bf16_128(uint16_t* ptr, __m128 v) {
+            __m128i rounded = round_f32_bf16_128(v);
+            _mm_storel_epi64((__m128i*)ptr, _mm_packus_epi32(rounded, rounded));
+        }
+        // acc (4 x i32) += sums of 4 adjacent byte products. Widened to 16 bits and pmaddwd'd, so nothing saturates
+        FUNC __m128i dot_i8_i32_128(__m128i acc, __m128i a, __m128i b) {
+            __m128i lo = _mm_madd_epi16(_mm_cvtepi8_epi16(a), _mm_cvtepi8_epi16(b));
+            __m128i hi = _mm_madd_epi16(_mm_cvtepi8_epi16(_mm_unpackhi_epi64(a, a)), _mm_cvtepi8_epi16(_mm_unpackhi_epi64(b, b)));
+            return _mm_add_epi32(acc, _mm_add_epi32(lo, hi));
+        }
+        FUNC __m128i dot_u8i8_i32_128(__m128i acc, __m128i a, __m128i b) {
+            __m128i lo = _mm_madd_epi16(_mm_cvtepu8_epi16(a), _mm_cvtepi8_epi16(b));
+            __m128i hi = _mm_madd_epi16(_mm_cvtepu8_epi16(_mm_unpackhi_epi64(a, a)), _mm_cvtepi8_epi16(_mm_unpackhi_epi64(b, b)));
+            return _mm_add_epi32(acc, _mm_add_epi32(lo, hi));
+        }
+
         // ================= AVX2 Floating-Point Operations (256-bit) =================
         // Single-precision (f32)
         FUNC __m256 load_f32(const float* ptr) { return _mm256_load_ps(ptr); }
         FUNC void store_f32(float* ptr, __m256 vec) { _mm256_store_ps(ptr, vec); }
+        FUNC __m256 loadu_f32(const float* ptr) { return _mm256_loadu_ps(ptr); }
+        FUNC void storeu_f32(float* ptr, __m256 vec) { _mm256_storeu_ps(ptr, vec); }
+        FUNC void stream_f32(float* ptr, __m256 vec) { _mm256_stream_ps(ptr, vec); }
         FUNC __m256 add_f32(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
         FUNC __m256 sub_f32(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
         FUNC __m256 mul_f32(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
@@ -31,6 +281,9 @@ namespace devsw::stl {
         // Double-precision (f64)
         FUNC __m256d load_f64(const double* ptr) { return _mm256_load_pd(ptr); }
         FUNC void store_f64(double* ptr, __m256d vec) { _mm256_store_pd(ptr, vec); }
+        FUNC __m256d loadu_f64(const double* ptr) { return _mm256_loadu_pd(ptr); }
+        FUNC void storeu_f64(double* ptr, __m256d vec) { _mm256_storeu_pd(ptr, vec); }
+        FUNC void stream_f64(double* ptr, __m256d vec) { _mm256_stream_pd(ptr, vec); }
         FUNC __m256d add_f64(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
         FUNC __m256d sub_f64(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
         FUNC __m256d mul_f64(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
@@ -47,8 +300,13 @@ namespace devsw::stl {
         // 8-bit (i8/u8)
         FUNC __m256i load_i8(const int8_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_i8(int8_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_i8(const int8_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_i8(int8_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
+        FUNC void stream_i256(void* ptr, __m256i vec) { _mm256_stream_si256((__m256i*)ptr, vec); }
         FUNC __m256i load_u8(const uint8_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_u8(uint8_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_u8(const uint8_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_u8(uint8_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i add_i8(__m256i a, __m256i b) { return _mm256_add_epi8(a, b); }
         FUNC __m256i add_u8(__m256i a, __m256i b) { return _mm256_add_epi8(a, b); }
         FUNC __m256i sub_i8(__m256i a, __m256i b) { return _mm256_sub_epi8(a, b); }
@@ -68,8 +326,12 @@ namespace devsw::stl {
         // 16-bit (i16/u16)
         FUNC __m256i load_i16(const int16_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_i16(int16_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_i16(const int16_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_i16(int16_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i load_u16(const uint16_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_u16(uint16_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_u16(const uint16_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_u16(uint16_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i add_i16(__m256i a, __m256i b) { return _mm256_add_epi16(a, b); }
         FUNC __m256i add_u16(__m256i a, __m256i b) { return _mm256_add_epi16(a, b); }
         FUNC __m256i sub_i16(__m256i a, __m256i b) { return _mm256_sub_epi16(a, b); }
@@ -85,8 +347,12 @@ namespace devsw::stl {
         // 32-bit (i32/u32)
         FUNC __m256i load_i32(const int32_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_i32(int32_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_i32(const int32_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_i32(int32_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i load_u32(const uint32_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_u32(uint32_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_u32(const uint32_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_u32(uint32_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i add_i32(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
         FUNC __m256i add_u32(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
         FUNC __m256i sub_i32(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
@@ -102,8 +368,12 @@ namespace devsw::stl {
         // 64-bit (i64/u64)
         FUNC __m256i load_i64(const int64_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_i64(int64_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_i64(const int64_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_i64(int64_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i load_u64(const uint64_t* ptr) { return _mm256_load_si256((__m256i*)ptr); }
         FUNC void store_u64(uint64_t* ptr, __m256i vec) { _mm256_store_si256((__m256i*)ptr, vec); }
+        FUNC __m256i loadu_u64(const uint64_t* ptr) { return _mm256_loadu_si256((__m256i*)ptr); }
+        FUNC void storeu_u64(uint64_t* ptr, __m256i vec) { _mm256_storeu_si256((__m256i*)ptr, vec); }
         FUNC __m256i add_i64(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
         FUNC __m256i add_u64(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
         FUNC __m256i sub_i64(__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); }
@@ -114,24 +384,164 @@ namespace devsw::stl {
             __m256i a_hi = _mm256_srli_epi64(a, 32);
             __m256i b_hi = _mm256_srli_epi64(b, 32);
             __m256i lo = _mm256_mul_epu32(a_lo, b_lo);
-            __m256i hi = _mm256_mul_epu32(a_hi, b_hi);
             __m256i mid1 = _mm256_mul_epu32(a_lo, b_hi);
             __m256i mid2 = _mm256_mul_epu32(a_hi, b_lo);
             __m256i mid = _mm256_add_epi64(mid1, mid2);
-            return _mm256_add_epi64(lo, _mm256_slli_epi64(_mm256_add_epi64(mid, hi), 32));
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(mid, 32)); // a_hi * b_hi lands above bit 63
         }
         FUNC __m256i mul_u64(__m256i a, __m256i b) { return mul_i64(a, b); }
+#ifdef __AVX512VL__
         FUNC __m256i min_i64(__m256i a, __m256i b) { return _mm256_min_epi64(a, b); }
         FUNC __m256i max_i64(__m256i a, __m256i b) { return _mm256_max_epi64(a, b); }
         FUNC __m256i min_u64(__m256i a, __m256i b) { return _mm256_min_epu64(a, b); }
         FUNC __m256i max_u64(__m256i a, __m256i b) { return _mm256_max_epu64(a, b); }
         FUNC __m256i abs_i64(__m256i a) { return _mm256_abs_epi64(a); }
+#else
+        // Plain AVX2 has no 64-bit min/max/abs, those are AVX-512VL encodings
+        FUNC __m256i min_i64(__m256i a, __m256i b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+        FUNC __m256i max_i64(__m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+        FUNC __m256i min_u64(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias)));
+        }
+        FUNC __m256i max_u64(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias)));
+        }
+        FUNC __m256i abs_i64(__m256i a) {
+            __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+            return _mm256_sub_epi64(_mm256_xor_si256(a, sign), sign);
+        }
+#endif
+
+        // ================= AVX2 Compare, Blend and Movemask (256-bit) =================
+        FUNC __m256i cmpeq_i8(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+        FUNC __m256i cmpeq_i16(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+        FUNC __m256i cmpeq_i32(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+        FUNC __m256i cmpeq_i64(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+        FUNC __m256i cmpgt_i8(__m256i a, __m256i b) { return _mm256_cmpgt_epi8(a, b); }
+        FUNC __m256i cmpgt_i16(__m256i a, __m256i b) { return _mm256_cmpgt_epi16(a, b); }
+        FUNC __m256i cmpgt_i32(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); }
+        FUNC __m256i cmpgt_i64(__m256i a, __m256i b) { return _mm256_cmpgt_epi64(a, b); }
+        FUNC __m256i cmpgt_u8(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi8(char(0x80));
+            return _mm256_cmpgt_epi8(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+        }
+        FUNC __m256i cmpgt_u16(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi16(short(0x8000));
+            return _mm256_cmpgt_epi16(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+        }
+        FUNC __m256i cmpgt_u32(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi32(INT32_MIN);
+            return _mm256_cmpgt_epi32(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+        }
+        FUNC __m256i cmpgt_u64(__m256i a, __m256i b) {
+            __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+        }
+        FUNC __m256i not_i256(__m256i a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+        FUNC __m256i blend_i256(__m256i mask, __m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, mask); }
+        FUNC __m256 blend_f32(__m256 mask, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+        FUNC __m256d blend_f64(__m256d mask, __m256d a, __m256d b) { return _mm256_blendv_pd(b, a, mask); }
+        // packs works per 128-bit half, so 16-bit lanes are narrowed half against half instead
+        FUNC uint32_t movemask_i8(__m256i mask) { return static_cast<uint32_t>(_mm256_movemask_epi8(mask)); }
+        FUNC uint32_t movemask_i16(__m256i mask) {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(mask), _mm256_extracti128_si256(mask, 1))));
+        }
+        FUNC uint32_t movemask_i32(__m256i mask) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))); }
+        FUNC uint32_t movemask_i64(__m256i mask) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask))); }
+        FUNC uint32_t movemask_f32(__m256 mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+        FUNC uint32_t movemask_f64(__m256d mask) { return static_cast<uint32_t>(_mm256_movemask_pd(mask)); }
+        FUNC __m256i compress_i32(__m256i v, uint32_t mask) { return _mm256_permutevar8x32_epi32(v, _mm256_load_si256((const __m256i*)compress_tables.dword8[mask])); }
+        FUNC __m256i compress_i64(__m256i v, uint32_t mask) { return _mm256_permutevar8x32_epi32(v, _mm256_load_si256((const __m256i*)compress_tables.qword4[mask])); }
+
+        // ================= AVX2 Lane Shifts (256-bit) =================
+        // palignr works per 128-bit half, so the lower half of v is first moved into the upper half of the carry-in
+        // register. Bytes is at most 16, half a register, which is all a scan needs
+        template <int Bytes> FUNC __m256i shift_up(__m256i v, __m256i fill) {
+            __m256i below = _mm256_permute2x128_si256(fill, v, 0x20); // [fill.lo, v.lo]
+            if constexpr (Bytes == 16) return below;
+            else return _mm256_alignr_epi8(v, below, 16 - Bytes);
+        }
+        template <int Bytes> FUNC __m256i broadcast_top(__m256i v) {
+            if constexpr (Bytes == 8) return _mm256_permute4x64_epi64(v, 0xFF);
+            else if constexpr (Bytes == 4) return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+            else if constexpr (Bytes == 2) return _mm256_shuffle_epi8(_mm256_permute4x64_epi64(v, 0xFF), _mm256_set1_epi16(0x0706));
+            else return _mm256_shuffle_epi8(_mm256_permute4x64_epi64(v, 0xFF), _mm256_set1_epi8(7));
+        }
+
+        // ================= AVX2 Lane Permutes (256-bit) =================
+        // Lane i takes lane i ^ Xor, the partner exchange of a sorting network step. In-lane pshufd where it can,
+        // a half swap for dword 4, vpermd otherwise
+        template <int Xor> FUNC __m256i permute_xor_i32(__m256i v) {
+            if constexpr (Xor < 4) return _mm256_shuffle_epi32(v, (0 ^ Xor) | ((1 ^ Xor) << 2) | ((2 ^ Xor) << 4) | ((3 ^ Xor) << 6));
+            else if constexpr (Xor == 4) return _mm256_permute2x128_si256(v, v, 0x01);
+            else return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ Xor, 1 ^ Xor, 2 ^ Xor, 3 ^ Xor, 4 ^ Xor, 5 ^ Xor, 6 ^ Xor, 7 ^ Xor));
+        }
+        template <int Xor> FUNC __m256i permute_xor_i64(__m256i v) { return _mm256_permute4x64_epi64(v, (0 ^ Xor) | ((1 ^ Xor) << 2) | ((2 ^ Xor) << 4) | ((3 ^ Xor) << 6)); }
+        // Lanes set in Bits from b, the rest from a. Immediate blends, no mask register
+        template <int Bits> FUNC __m256i blend_lanes_i32(__m256i a, __m256i b) { return _mm256_blend_epi32(a, b, Bits); }
+        template <int Bits> FUNC __m256i blend_lanes_i64(__m256i a, __m256i b) {
+            return _mm256_blend_epi32(a, b, ((Bits & 1) ? 0x03 : 0) | ((Bits & 2) ? 0x0C : 0) | ((Bits & 4) ? 0x30 : 0) | ((Bits & 8) ? 0xC0 : 0));
+        }
+
+        // ================= AVX2 Gather (256-bit) =================
+        // ptr[indices[i]] into lane i, for any 32/64-bit element (float tables gather their bits). Indices are 32-bit and
+        // sign-extended by vpgatherd*, so the table is at most 2^31 elements. 64-bit lanes take four indices from a 128-bit load
+        FUNC __m256i gather_i32(const void* ptr, const uint32_t* indices) { return _mm256_i32gather_epi32((const int*)ptr, _mm256_loadu_si256((const __m256i*)indices), 4); }
+        FUNC __m256i gather_i64(const void* ptr, const uint32_t* indices) { return _mm256_i32gather_epi64((const long long*)ptr, _mm_loadu_si128((const __m128i*)indices), 8); }
+        // Lane i from ptr + i * stride bytes, a column of packed records. (lanes - 1) * stride must fit in int32
+        FUNC __m256i gather_stride_i32(const void* ptr, int32_t stride) {
+            return _mm256_i32gather_epi32((const int*)ptr, _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride)), 1);
+        }
+        FUNC __m256i gather_stride_i64(const void* ptr, int32_t stride) {
+            return _mm256_i32gather_epi64((const long long*)ptr, _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(stride)), 1);
+        }
+
+        // ================= AVX2 Conversions and Int8 Dot (256-bit) =================
+        // 8 f32 lanes against 8 narrow elements in memory. float16 needs F16C, which every AVX2 CPU has
+        FUNC __m256 cvt_i8_f32(const int8_t* ptr) { return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)ptr))); }
+        FUNC __m256 cvt_u8_f32(const uint8_t* ptr) { return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)ptr))); }
+        FUNC void cvt_f32_i8(int8_t* ptr, __m256 v) {
+            __m256i wide = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-128.0f)), _mm256_set1_ps(127.0f)));
+            __m128i narrow = _mm_packs_epi32(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+            _mm_storel_epi64((__m128i*)ptr, _mm_packs_epi16(narrow, narrow));
+        }
+        FUNC void cvt_f32_u8(uint8_t* ptr, __m256 v) {
+            __m256i wide = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)));
+            __m128i narrow = _mm_packs_epi32(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+            _mm_storel_epi64((__m128i*)ptr, _mm_packus_epi16(narrow, narrow));
+        }
+        FUNC __m256 cvt_bf16_f32(const uint16_t* ptr) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)ptr)), 16)); }
+        FUNC void cvt_f32_bf16(uint16_t* ptr, __m256 v) {
+            __m256i bits = _mm256_castps_si256(v);
+            __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+            __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF))), 16);
+            __m256i quiet = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+            rounded = _mm256_blendv_epi8(rounded, quiet, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+            _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi32(_mm256_castsi256_si128(rounded), _mm256_extracti128_si256(rounded, 1)));
+        }
+        FUNC __m256 cvt_f16_f32(const uint16_t* ptr) { return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)ptr)); }
+        FUNC void cvt_f32_f16(uint16_t* ptr, __m256 v) { _mm_storeu_si128((__m128i*)ptr, _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); }
+        FUNC __m256i dot_i8_i32(__m256i acc, __m256i a, __m256i b) {
+            __m256i lo = _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_castsi256_si128(a)), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(b)));
+            __m256i hi = _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_extracti128_si256(a, 1)), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(b, 1)));
+            return _mm256_add_epi32(acc, _mm256_add_epi32(lo, hi));
+        }
+        FUNC __m256i dot_u8i8_i32(__m256i acc, __m256i a, __m256i b) {
+            __m256i lo = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(b)));
+            __m256i hi = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(b, 1)));
+            return _mm256_add_epi32(acc, _mm256_add_epi32(lo, hi));
+        }
 
 #ifdef __AVX512F__
         // ================= AVX-512 Floating-Point Operations (512-bit) =================
         // Single-precision (f32)
         FUNC __m512 load_f32_512(const float* ptr) { return _mm512_load_ps(ptr); }
         FUNC void store_f32_512(float* ptr, __m512 vec) { _mm512_store_ps(ptr, vec); }
+        FUNC __m512 loadu_f32_512(const float* ptr) { return _mm512_loadu_ps(ptr); }
+        FUNC void storeu_f32_512(float* ptr, __m512 vec) { _mm512_storeu_ps(ptr, vec); }
+        FUNC void stream_f32_512(float* ptr, __m512 vec) { _mm512_stream_ps(ptr, vec); }
         FUNC __m512 add_f32_512(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
         FUNC __m512 sub_f32_512(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
         FUNC __m512 mul_f32_512(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
@@ -147,6 +557,9 @@ namespace devsw::stl {
         // Double-precision (f64)
         FUNC __m512d load_f64_512(const double* ptr) { return _mm512_load_pd(ptr); }
         FUNC void store_f64_512(double* ptr, __m512d vec) { _mm512_store_pd(ptr, vec); }
+        FUNC __m512d loadu_f64_512(const double* ptr) { return _mm512_loadu_pd(ptr); }
+        FUNC void storeu_f64_512(double* ptr, __m512d vec) { _mm512_storeu_pd(ptr, vec); }
+        FUNC void stream_f64_512(double* ptr, __m512d vec) { _mm512_stream_pd(ptr, vec); }
         FUNC __m512d add_f64_512(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
         FUNC __m512d sub_f64_512(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
         FUNC __m512d mul_f64_512(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
@@ -163,8 +576,13 @@ namespace devsw::stl {
         // 8-bit (i8/u8)
         FUNC __m512i load_i8_512(const int8_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_i8_512(int8_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_i8_512(const int8_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_i8_512(int8_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
+        FUNC void stream_i512(void* ptr, __m512i vec) { _mm512_stream_si512((__m512i*)ptr, vec); }
         FUNC __m512i load_u8_512(const uint8_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_u8_512(uint8_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_u8_512(const uint8_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_u8_512(uint8_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i add_i8_512(__m512i a, __m512i b) { return _mm512_add_epi8(a, b); }
         FUNC __m512i add_u8_512(__m512i a, __m512i b) { return _mm512_add_epi8(a, b); }
         FUNC __m512i sub_i8_512(__m512i a, __m512i b) { return _mm512_sub_epi8(a, b); }
@@ -184,8 +602,12 @@ namespace devsw::stl {
         // 16-bit (i16/u16)
         FUNC __m512i load_i16_512(const int16_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_i16_512(int16_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_i16_512(const int16_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_i16_512(int16_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i load_u16_512(const uint16_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_u16_512(uint16_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_u16_512(const uint16_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_u16_512(uint16_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i add_i16_512(__m512i a, __m512i b) { return _mm512_add_epi16(a, b); }
         FUNC __m512i add_u16_512(__m512i a, __m512i b) { return _mm512_add_epi16(a, b); }
         FUNC __m512i sub_i16_512(__m512i a, __m512i b) { return _mm512_sub_epi16(a, b); }
@@ -201,8 +623,12 @@ namespace devsw::stl {
         // 32-bit (i32/u32)
         FUNC __m512i load_i32_512(const int32_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_i32_512(int32_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_i32_512(const int32_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_i32_512(int32_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i load_u32_512(const uint32_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_u32_512(uint32_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_u32_512(const uint32_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_u32_512(uint32_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i add_i32_512(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
         FUNC __m512i add_u32_512(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
         FUNC __m512i sub_i32_512(__m512i a, __m512i b) { return _mm512_sub_epi32(a, b); }
@@ -218,8 +644,12 @@ namespace devsw::stl {
         // 64-bit (i64/u64)
         FUNC __m512i load_i64_512(const int64_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_i64_512(int64_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_i64_512(const int64_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_i64_512(int64_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i load_u64_512(const uint64_t* ptr) { return _mm512_load_si512((__m512i*)ptr); }
         FUNC void store_u64_512(uint64_t* ptr, __m512i vec) { _mm512_store_si512((__m512i*)ptr, vec); }
+        FUNC __m512i loadu_u64_512(const uint64_t* ptr) { return _mm512_loadu_si512((__m512i*)ptr); }
+        FUNC void storeu_u64_512(uint64_t* ptr, __m512i vec) { _mm512_storeu_si512((__m512i*)ptr, vec); }
         FUNC __m512i add_i64_512(__m512i a, __m512i b) { return _mm512_add_epi64(a, b); }
         FUNC __m512i add_u64_512(__m512i a, __m512i b) { return _mm512_add_epi64(a, b); }
         FUNC __m512i sub_i64_512(__m512i a, __m512i b) { return _mm512_sub_epi64(a, b); }
@@ -231,6 +661,112 @@ namespace devsw::stl {
         FUNC __m512i min_u64_512(__m512i a, __m512i b) { return _mm512_min_epu64(a, b); }
         FUNC __m512i max_u64_512(__m512i a, __m512i b) { return _mm512_max_epu64(a, b); }
         FUNC __m512i abs_i64_512(__m512i a) { return _mm512_abs_epi64(a); }
+
+        // ================= AVX-512 Lane Shifts (512-bit) =================
+        // valignd shifts the whole register in dwords. Byte and word shifts within a dword go through palignr per
+        // 128-bit lane, against v moved up by one lane
+        template <int Bytes> FUNC __m512i shift_up_512(__m512i v, __m512i fill) {
+            if constexpr (Bytes % 4 == 0) return _mm512_alignr_epi32(v, fill, 16 - Bytes / 4);
+            else return _mm512_alignr_epi8(v, _mm512_alignr_epi32(v, fill, 12), 16 - Bytes);
+        }
+        template <int Bytes> FUNC __m512i broadcast_top_512(__m512i v) {
+            if constexpr (Bytes == 8) return _mm512_permutexvar_epi64(_mm512_set1_epi64(7), v);
+            else if constexpr (Bytes == 4) return _mm512_permutexvar_epi32(_mm512_set1_epi32(15), v);
+            else if constexpr (Bytes == 2) return _mm512_permutexvar_epi16(_mm512_set1_epi16(31), v);
+            else return _mm512_shuffle_epi8(_mm512_permutexvar_epi32(_mm512_set1_epi32(15), v), _mm512_set1_epi8(3));
+        }
+
+        // ================= AVX-512 Lane Permutes (512-bit) =================
+        // Lane i takes lane i ^ Xor. Exchanges inside a 128-bit lane are pshufd, whole 128-bit lane exchanges are
+        // vshufi32x4, anything mixing the two is vpermd/vpermq
+        template <int Xor> FUNC __m512i permute_xor_i32_512(__m512i v) {
+            if constexpr (Xor < 4) return _mm512_shuffle_epi32(v, static_cast<_MM_PERM_ENUM>((0 ^ Xor) | ((1 ^ Xor) << 2) | ((2 ^ Xor) << 4) | ((3 ^ Xor) << 6)));
+            else if constexpr (Xor % 4 == 0) {
+                constexpr int x = Xor / 4;
+                return _mm512_shuffle_i32x4(v, v, (0 ^ x) | ((1 ^ x) << 2) | ((2 ^ x) << 4) | ((3 ^ x) << 6));
+            }
+            else return _mm512_permutexvar_epi32(_mm512_setr_epi32(0 ^ Xor, 1 ^ Xor, 2 ^ Xor, 3 ^ Xor, 4 ^ Xor, 5 ^ Xor, 6 ^ Xor, 7 ^ Xor,
+                8 ^ Xor, 9 ^ Xor, 10 ^ Xor, 11 ^ Xor, 12 ^ Xor, 13 ^ Xor, 14 ^ Xor, 15 ^ Xor), v);
+        }
+        template <int Xor> FUNC __m512i permute_xor_i64_512(__m512i v) {
+            if constexpr (Xor == 1) return _mm512_shuffle_epi32(v, _MM_PERM_BADC);
+            else if constexpr (Xor % 2 == 0) {
+                constexpr int x = Xor / 2;
+                return _mm512_shuffle_i64x2(v, v, (0 ^ x) | ((1 ^ x) << 2) | ((2 ^ x) << 4) | ((3 ^ x) << 6));
+            }
+            else return _mm512_permutexvar_epi64(_mm512_setr_epi64(0 ^ Xor, 1 ^ Xor, 2 ^ Xor, 3 ^ Xor, 4 ^ Xor, 5 ^ Xor, 6 ^ Xor, 7 ^ Xor), v);
+        }
+        template <int Bits> FUNC __m512i blend_lanes_i32_512(__m512i a, __m512i b) { return _mm512_mask_blend_epi32(static_cast<__mmask16>(Bits), a, b); }
+        template <int Bits> FUNC __m512i blend_lanes_i64_512(__m512i a, __m512i b) { return _mm512_mask_blend_epi64(static_cast<__mmask8>(Bits), a, b); }
+
+        // ================= AVX-512 Gather and Scatter (512-bit) =================
+        // Same 32-bit index rules as the AVX2 gathers. Scatters write lane 0 first, so of several lanes on one
+        // index the highest wins, as a scalar loop would leave it
+        FUNC __m512i gather_i32_512(const void* ptr, const uint32_t* indices) { return _mm512_i32gather_epi32(_mm512_loadu_si512(indices), ptr, 4); }
+        FUNC __m512i gather_i64_512(const void* ptr, const uint32_t* indices) { return _mm512_i32gather_epi64(_mm256_loadu_si256((const __m256i*)indices), ptr, 8); }
+        FUNC void scatter_i32_512(void* ptr, const uint32_t* indices, __m512i v) { _mm512_i32scatter_epi32(ptr, _mm512_loadu_si512(indices), v, 4); }
+        FUNC void scatter_i64_512(void* ptr, const uint32_t* indices, __m512i v) { _mm512_i32scatter_epi64(ptr, _mm256_loadu_si256((const __m256i*)indices), v, 8); }
+        FUNC __m512i stride_offsets_i32_512(int32_t stride) { return _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(stride)); }
+        FUNC __m256i stride_offsets_i64_512(int32_t stride) { return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride)); }
+        FUNC __m512i gather_stride_i32_512(const void* ptr, int32_t stride) { return _mm512_i32gather_epi32(stride_offsets_i32_512(stride), ptr, 1); }
+        FUNC __m512i gather_stride_i64_512(const void* ptr, int32_t stride) { return _mm512_i32gather_epi64(stride_offsets_i64_512(stride), ptr, 1); }
+        FUNC void scatter_stride_i32_512(void* ptr, int32_t stride, __m512i v) { _mm512_i32scatter_epi32(ptr, stride_offsets_i32_512(stride), v, 1); }
+        FUNC void scatter_stride_i64_512(void* ptr, int32_t stride, __m512i v) { _mm512_i32scatter_epi64(ptr, stride_offsets_i64_512(stride), v, 1); }
+
+        // ================= AVX-512 Conversions and Int8 Dot (512-bit) =================
+        // 16 f32 lanes against 16 narrow elements in memory, narrowed with the saturating vpmov forms
+        FUNC __m512 cvt_i8_f32_512(const int8_t* ptr) { return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)ptr))); }
+        FUNC __m512 cvt_u8_f32_512(const uint8_t* ptr) { return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)ptr))); }
+        FUNC void cvt_f32_i8_512(int8_t* ptr, __m512 v) {
+            __m512i wide = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(v, _mm512_set1_ps(-128.0f)), _mm512_set1_ps(127.0f)));
+            _mm_storeu_si128((__m128i*)ptr, _mm512_cvtsepi32_epi8(wide));
+        }
+        FUNC void cvt_f32_u8_512(uint8_t* ptr, __m512 v) {
+            __m512i wide = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(v, _mm512_setzero_ps()), _mm512_set1_ps(255.0f)));
+            _mm_storeu_si128((__m128i*)ptr, _mm512_cvtusepi32_epi8(wide));
+        }
+        FUNC __m512 cvt_bf16_f32_512(const uint16_t* ptr) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)ptr)), 16)); }
+        FUNC void cvt_f32_bf16_512(uint16_t* ptr, __m512 v) {
+            __m512i bits = _mm512_castps_si512(v);
+            __m512i odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+            __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(odd, _mm512_set1_epi32(0x7FFF))), 16);
+            __m512i quiet = _mm512_or_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(0x40));
+            rounded = _mm512_mask_mov_epi32(rounded, _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), quiet);
+            _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtepi32_epi16(rounded));
+        }
+        FUNC __m512 cvt_f16_f32_512(const uint16_t* ptr) { return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)ptr)); }
+        FUNC void cvt_f32_f16_512(uint16_t* ptr, __m512 v) { _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)); }
+        FUNC __m512i dot_i8_i32_512(__m512i acc, __m512i a, __m512i b) {
+            __m512i lo = _mm512_madd_epi16(_mm512_cvtepi8_epi16(_mm512_castsi512_si256(a)), _mm512_cvtepi8_epi16(_mm512_castsi512_si256(b)));
+            __m512i hi = _mm512_madd_epi16(_mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(a, 1)), _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(b, 1)));
+            return _mm512_add_epi32(acc, _mm512_add_epi32(lo, hi));
+        }
+        FUNC __m512i dot_u8i8_i32_512(__m512i acc, __m512i a, __m512i b) {
+            __m512i lo = _mm512_madd_epi16(_mm512_cvtepu8_epi16(_mm512_castsi512_si256(a)), _mm512_cvtepi8_epi16(_mm512_castsi512_si256(b)));
+            __m512i hi = _mm512_madd_epi16(_mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(a, 1)), _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(b, 1)));
+            return _mm512_add_epi32(acc, _mm512_add_epi32(lo, hi));
+        }
+#ifdef __AVX512CD__
+        // ================= AVX-512 Conflict Detection (512-bit) =================
+        // counts[indices[i]] += 1 for the lanes in valid, lanes repeating an index included. vpconflictd gives every lane
+        // the earlier lanes holding its index, so each lane adds one plus that many, and the scatter, which writes
+        // overlapping lanes in order, keeps the last lane's total. No vpopcntd before Ice Lake, so a nibble table counts
+        FUNC void increment_i32_512(uint32_t* counts, __m512i indices, __mmask16 valid) {
+            __m512i conflicts = _mm512_maskz_conflict_epi32(valid, indices);
+            __m512i table = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+            __m512i nibbles = _mm512_set1_epi8(0x0F);
+            __m512i bytes = _mm512_add_epi8(_mm512_shuffle_epi8(table, _mm512_and_si512(conflicts, nibbles)),
+                _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(conflicts, 4), nibbles)));
+            __m512i earlier = _mm512_madd_epi16(_mm512_maddubs_epi16(bytes, _mm512_set1_epi8(1)), _mm512_set1_epi16(1));
+            __m512i gathered = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), valid, indices, counts, 4);
+            __m512i updated = _mm512_add_epi32(gathered, _mm512_add_epi32(earlier, _mm512_set1_epi32(1)));
+            _mm512_mask_i32scatter_epi32(counts, valid, indices, updated, 4);
+        }
+#endif
+#ifdef __AVX512VNNI__
+        // vpdpbusd, unsigned a times signed b. The signed x signed dot goes through it with a bias, see KernelsVNNI.cpp
+        FUNC __m512i dpbusd_512(__m512i acc, __m512i a, __m512i b) { return _mm512_dpbusd_epi32(acc, a, b); }
+#endif
 #endif
     };
 }
\ No newline at end of file
@@ -13,8 +13,11 @@ namespace devsw::stl {
 	public:
 		BoundedAllocator() noexcept : offset(0) {
 			static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+			this->stats_.on_reserve(sizeof(buffer));
 		}
 
+		using Allocator<T>::stats;
+
 		T* allocate(size_t size) override {
 			size_t total = sizeof(T) * size;
 			size_t aligned = (total + Alignment - 1) & ~(Alignment - 1);
@@ -24,10 +27,12 @@ namespace devsw::stl {
 			}
 
 			offset += aligned;
+			this->stats_.on_allocate(aligned, DEVSW_ALLOCATION_SITE());
 			return reinterpret_cast<T*>(buffer + offset - aligned);
 		}
 
 		void reset() noexcept {
+			this->stats_.on_deallocate(offset);
 			offset = 0;
 		}
 	};
@@ -53,8 +58,11 @@ namespace devsw::stl {
 				0,
 				nullptr
 			};
+			this->stats_.on_reserve(initialBytes);
 		}
 
+		using Allocator<T>::stats;
+
 		~UnboundedAllocator() noexcept override {
 			while (head) {
 				MemChunk* next = head->next;
@@ -84,17 +92,23 @@ namespace devsw::stl {
 				current->next = chunk;
 				current = chunk;
 				alignedOffset = 0;
+				this->stats_.on_reserve(newCapacity);
 			}
 
 			std::byte* ptr = current->memBlock + alignedOffset;
 			current->offset = alignedOffset + paddedSize;
+			this->stats_.on_allocate(paddedSize, DEVSW_ALLOCATION_SITE());
 			return reinterpret_cast<T*>(ptr);
 		}
 
 		void reset() noexcept {
+			size_t used = 0;
+			for (MemChunk* chunk = head; chunk; chunk = chunk->next) used += chunk->offset; // Padded sizes add up to whole offsets
+			this->stats_.on_deallocate(used);
 			MemChunk* chunk = head->next;
 			while (chunk) {
 				MemChunk* next = chunk->next;
+				this->stats_.on_release(chunk->capacity);
 				delete[] chunk->memBlock;
 				delete chunk;
 				chunk = next;
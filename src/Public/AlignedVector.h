@@ -2,56 +2,88 @@
 
 #include "devswSTL.h"
 #include "Traits.h"
-#include "Allocators.h"
+#include "Memory.h"
+#include "Float16.h"
+#include "Simd.h"
 
 namespace devsw::stl {
     template <typename T>
     class devswSTL AlignedVector {
-        static_assert(is_numeric_v<T>, "AlignedVector only supports floating point and integer types");
+        static_assert(is_numeric_v<T> || is_half_float_v<T>, "AlignedVector only supports floating point, integer and 16-bit float storage types");
 
     public:
         // Constructors
-        AlignedVector() :data_(nullptr), size_(0), capacity_(0), allocator_() {}
-        explicit AlignedVector(size_t n, T value = T()) : data_(nullptr), size_(0), capacity_(0) {
+        AlignedVector() :data_(nullptr), size_(0), capacity_(0), growth_(GOLDEN_RATIO), node_(Numa::ANY) {}
+        explicit AlignedVector(size_t n, T value = T()) : data_(nullptr), size_(0), capacity_(0), growth_(GOLDEN_RATIO), node_(Numa::ANY) {
+            resize(n, value);
+        }
+
+        // Storage placed on a NUMA node (or interleaved over all of them) for its whole life, see Numa. Placed storage
+        // is always a page mapping of its own, however small
+        explicit AlignedVector(NumaPlacement placement)
+            : data_(nullptr), size_(0), capacity_(0), growth_(GOLDEN_RATIO), node_(placement.node) {}
+        AlignedVector(size_t n, NumaPlacement placement, T value = T())
+            : data_(nullptr), size_(0), capacity_(0), growth_(GOLDEN_RATIO), node_(placement.node) {
             resize(n, value);
         }
 
         // Copy constructor
-        AlignedVector(const AlignedVector& other) : data_(nullptr), size_(0), capacity_(0) {
+        AlignedVector(const AlignedVector& other)
+            : data_(nullptr), size_(0), capacity_(0), growth_(other.growth_), node_(other.node_) {
             reserve(other.size_);
             size_ = other.size_;
-            memcpy(data_, other.data_, size_ * sizeof(T));
+            copy_range(data_, other.data_, size_);
+        }
+
+        // Lazy expression (see Expressions.h), evaluated in a single pass with no temporaries. The storage is new, so a
+        // result past Dispatch::streaming_threshold() is streamed out instead of being read in line by line first
+        template <typename E, typename S = Simd<T>, typename = enable_if_t<E::is_vector_expression, void>>
+        AlignedVector(const E& expr) : data_(nullptr), size_(0), capacity_(0), growth_(GOLDEN_RATIO), node_(Numa::ANY) {
+            reserve(expr.size());
+            size_ = expr.size();
+            expr.template evaluate<S>(data_, Dispatch::streams(StoreMode::Auto, size_ * sizeof(T)));
         }
 
         // Copy assignment
         AlignedVector& operator=(const AlignedVector& other) {
             if (this != &other) {
-				if (data_) allocator_.deallocate(data_, capacity_);
+				release(data_, capacity_);
                 data_ = nullptr;
                 size_ = 0;
                 capacity_ = 0;
                 reserve(other.size_);
                 size_ = other.size_;
-                memcpy(data_, other.data_, size_ * sizeof(T));
+                copy_range(data_, other.data_, size_);
             }
             return *this;
         }
 
         // Move constructor
         AlignedVector(AlignedVector&& other) noexcept
-            : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+            : data_(other.data_), size_(other.size_), capacity_(other.capacity_), growth_(other.growth_), node_(other.node_) {
             other.data_ = nullptr;
             other.size_ = 0;
             other.capacity_ = 0;
         }
 
+        // Expression assignment. Operands may alias *this, every lane is read before it is written
+        template <typename E, typename S = Simd<T>, typename = enable_if_t<E::is_vector_expression, void>>
+        AlignedVector& operator=(const E& expr) {
+            reserve(expr.size());
+            size_ = expr.size();
+            expr.template evaluate<S>(data_);
+            return *this;
+        }
+
         // Move assignment
         AlignedVector& operator=(AlignedVector&& other) noexcept {
             if (this != &other) {
-				if (data_) allocator_.deallocate(data_, capacity_);
+				release(data_, capacity_);
                 data_ = other.data_;
                 size_ = other.size_;
                 capacity_ = other.capacity_;
+                growth_ = other.growth_;
+                node_ = other.node_;
                 other.data_ = nullptr;
                 other.size_ = 0;
                 other.capacity_ = 0;
@@ -61,7 +93,7 @@ namespace devsw::stl {
 
         // Destructor
         ~AlignedVector() {
-			if (data_) allocator_.deallocate(data_, capacity_);
+			release(data_, capacity_);
         }
 
         // Accessors
@@ -71,25 +103,29 @@ namespace devsw::stl {
         const T* end() const { return data_ + size_; }
         size_t get_size() const { return size_; }
         size_t get_capacity() const { return capacity_; }
+        double get_growth_factor() const { return growth_; }
+        int get_node() const { return node_; }
 
         // Element access
         T& operator[](size_t i) { return data_[i]; } // No bounds live dangerously!
         const T& operator[](size_t i) const { return data_[i]; }
         T& at(size_t i) {
-            if (i >= size_);
+            if (i >= size_) {
 				//TODO Errors...
+            }
             return data_[i];
         }
         const T& at(size_t i) const {
-            if (i >= size_);
+            if (i >= size_) {
                 //TODO Errors...
+            }
             return data_[i];
         }
 
         // Modifiers
         void push_back(T value) {
             if (size_ == capacity_) {
-                size_t new_capacity = capacity_ ? capacity_ * 2 : 16; // Start bigger for AVX
+                size_t new_capacity = capacity_ ? static_cast<size_t>(capacity_ * growth_) + 1 : 16; // Start bigger for AVX
                 reserve(new_capacity);
             }
             data_[size_++] = value;
@@ -100,39 +136,103 @@ namespace devsw::stl {
                 size_t new_capacity = (new_size + 15) & ~15; // Round up to 16 for AVX
                 reserve(new_capacity);
             }
-            if (new_size > size_) {
-                for (size_t i = size_; i < new_size; ++i) data_[i] = value;
-            }
+            if (new_size > size_) fill_range(data_ + size_, new_size - size_, value);
             size_ = new_size;
         }
 
+        // Capacity is always whole cache lines of initialized memory, so [size, aligned_size()) is owned and element-wise
+        // kernels can run over it instead of handling a tail. Its values are unspecified: zeros when the storage is new,
+        // then whatever a kernel, resize or clear left there.
+        // From Pages::MAP_THRESHOLD bytes up the storage is a mapping of its own (huge pages, see Pages), grown with
+        // mremap where the OS has it: no copy, and no second buffer alive while it happens
         void reserve(size_t new_capacity) {
             if (new_capacity <= capacity_) return;
-            T* new_data = static_cast<T*>(allocator_.allocate(32, new_capacity * sizeof(T)));
-            if (!new_data);
-            //TODO Errors...
-            if (data_) {
-                memcpy(new_data, data_, size_ * sizeof(T));
-                aligned_free(data_);
+            reallocate((new_capacity + LINE_ELEMENTS - 1) & ~(LINE_ELEMENTS - 1));
+        }
+
+        // Gives the capacity past the last cache line in use back, to the OS for mapped storage
+        void shrink_to_fit() {
+            size_t new_capacity = (size_ + LINE_ELEMENTS - 1) & ~(LINE_ELEMENTS - 1);
+            if (new_capacity < capacity_) reallocate(new_capacity);
+        }
+
+        // Capacity multiplier for push_back, GOLDEN_RATIO by default. Smaller trades more reallocations for less slack
+        void set_growth_factor(double factor) {
+            if (factor <= 1.0) {
+                //TODO Errors...
+                return;
             }
-            data_ = new_data;
-            capacity_ = new_capacity;
+            growth_ = factor;
         }
 
         void clear() {
             size_ = 0;
         }
 
-        // AVX-friendly size helper
+        // AVX-friendly size helper, never more than get_capacity()
         size_t aligned_size() const {
             return (size_ + avx512_lanes_v<T> -1) & ~(avx512_lanes_v<T> -1); // Round up to lanes
         }
 
     private:
+        static constexpr size_t ALIGNMENT = 64; // A cache line, and a full AVX-512 register
+        static constexpr size_t LINE_ELEMENTS = ALIGNMENT / sizeof(T);
+
+        // Which allocator a capacity came from. Mapped capacities are Pages::round multiples, heap ones are below it
+        bool is_mapped(size_t capacity) const { return node_ != Numa::ANY || capacity * sizeof(T) >= Pages::MAP_THRESHOLD; }
+
+        void release(T* data, size_t capacity) const {
+            if (!data) return;
+            if (is_mapped(capacity)) Pages::unmap(data, capacity * sizeof(T));
+            else deallocate_array(data);
+        }
+
+        // Moves the storage to new_capacity elements (a whole number of lines, may be below size_ only for shrinking)
+        void reallocate(size_t new_capacity) {
+            size_t keep = size_ < new_capacity ? size_ : new_capacity;
+            if (new_capacity == 0) {
+                release(data_, capacity_);
+                data_ = nullptr;
+                capacity_ = 0;
+                return;
+            }
+            T* new_data = nullptr;
+            size_t bytes = new_capacity * sizeof(T);
+            if (is_mapped(new_capacity)) {
+                bytes = Pages::round(bytes);
+                if (data_ && is_mapped(capacity_)) {
+                    new_data = static_cast<T*>(Pages::remap(data_, capacity_ * sizeof(T), bytes));
+                    if (new_data) {
+                        if (node_ != Numa::ANY) Numa::place(new_data, bytes, node_); // The pages remap added
+                        data_ = new_data;
+                        capacity_ = bytes / sizeof(T);
+                        return;
+                    }
+                }
+                new_data = static_cast<T*>(Numa::map(bytes, node_));
+                new_capacity = bytes / sizeof(T);
+            }
+            else {
+                new_data = allocate_array<T>(new_capacity, ALIGNMENT);
+            }
+            if (!new_data) {
+                //TODO Errors...
+                return;
+            }
+            if (data_) {
+                relocate_range(new_data, data_, keep);
+                release(data_, capacity_);
+            }
+            if (!is_mapped(new_capacity)) memset(new_data + keep, 0, (new_capacity - keep) * sizeof(T)); // Mapped pages come zeroed
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
         T* data_;
         size_t size_;
         size_t capacity_;
-		StackAllocator<T> allocator_;
+        double growth_;
+        int node_; // Numa::ANY unless placed
     };
 }
 
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "devswSTL.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Compile-time switch for allocator statistics and the allocation trace. Off, every hook is an empty inline function.
+// Must be the same for the library and everything using it, it changes the layout of SlabHeap, NumaArena and
+// FrameArena: set it with the DEVSW_ALLOCATOR_STATS CMake option, which passes it on to every target linking devswSTL
+#ifndef DEVSW_ALLOCATOR_STATS
+#define DEVSW_ALLOCATOR_STATS 0
+#endif
+
+// Return address of the function it is used in, i.e. the call site of an allocate
+#if defined(_MSC_VER)
+#define DEVSW_ALLOCATION_SITE() _ReturnAddress()
+#else
+#define DEVSW_ALLOCATION_SITE() __builtin_return_address(0)
+#endif
+
+namespace devsw::stl {
+	namespace allocators {
+		// Geometric size classes, four per power of two from 8 B to 32 KiB: 8, 16, 24, 32, 40, 48, 56, 64, 80, 96...
+		// The classes of SlabHeap, and the buckets of AllocatorSnapshot::class_allocations
+		constexpr size_t MIN_CLASS_SIZE = 8;
+		constexpr size_t MAX_CLASS_SIZE = 32 * 1024;
+		constexpr size_t CLASS_COUNT = 44;
+
+		// Index of the smallest class holding bytes (1 to MAX_CLASS_SIZE), and the size of a class
+		constexpr size_t size_class(size_t bytes) {
+			if (bytes <= 32) return bytes ? (bytes + 7) / 8 - 1 : 0;
+			size_t k = static_cast<size_t>(std::bit_width(bytes - 1)) - 1; // bytes in (2^k, 2^(k+1)]
+			return 4 + (k - 5) * 4 + ((bytes - 1 - (size_t(1) << k)) >> (k - 2));
+		}
+		constexpr size_t class_size(size_t index) {
+			if (index < 4) return 8 * (index + 1);
+			size_t k = (index - 4) / 4 + 5;
+			return (size_t(1) << k) + ((index - 4) % 4 + 1) * (size_t(1) << (k - 2));
+		}
+		static_assert(size_class(MAX_CLASS_SIZE) == CLASS_COUNT - 1 && class_size(CLASS_COUNT - 1) == MAX_CLASS_SIZE);
+	}
+
+	/**
+	* An allocator's counters at one point in time. Zero, and enabled false, unless built with DEVSW_ALLOCATOR_STATS.
+	* Live bytes are what callers asked for (after the allocator's own rounding where it rounds, e.g. StackAllocator),
+	* reserved bytes what the allocator holds from the system for them: slabs, chunks, pools, mappings.
+	*/
+	struct AllocatorSnapshot {
+		bool enabled = false;
+		uint64_t live_bytes = 0;
+		uint64_t peak_live_bytes = 0;
+		uint64_t reserved_bytes = 0;
+		uint64_t peak_reserved_bytes = 0;
+		uint64_t chunks = 0;      // Slabs, chunks or pools currently held
+		uint64_t peak_chunks = 0;
+		uint64_t allocations = 0;
+		uint64_t deallocations = 0; // A StackAllocator rewind or an arena reset counts once
+		// Allocations by allocators::size_class of their size in bytes, the last bucket is everything above MAX_CLASS_SIZE
+		uint64_t class_allocations[allocators::CLASS_COUNT + 1] = {};
+
+		// Share of the reserved bytes not holding live data: slack in slabs and chunks, rounding, free lists
+		double fragmentation() const {
+			return reserved_bytes ? 1.0 - static_cast<double>(live_bytes) / static_cast<double>(reserved_bytes) : 0.0;
+		}
+		// Share of the reserved bytes in use, how close a fixed-capacity allocator is to its limit
+		double utilization() const {
+			return reserved_bytes ? static_cast<double>(live_bytes) / static_cast<double>(reserved_bytes) : 0.0;
+		}
+	};
+
+	/**
+	* Sampled allocation-site trace shared by every instrumented allocator: while started, one allocation in
+	* sample_every is recorded with its size, allocator and return address. Records stop (and are counted as dropped)
+	* when the buffer is full. A no-op unless built with DEVSW_ALLOCATOR_STATS.
+	* dump writes a TraceHeader followed by recorded TraceRecords, little endian as in memory. anchor is the address of
+	* AllocationTrace::dump in the process that wrote it, so sites can be symbolized against the binary offline.
+	* @note stop before dump: a record claimed by a thread still sampling may not be written yet.
+	*/
+	struct devswSTL AllocationTrace {
+		struct TraceHeader {
+			char magic[8];           // "DEVSWTRC"
+			uint32_t version;        // 1
+			uint32_t record_size;    // sizeof(TraceRecord)
+			uint32_t sample_every;
+			uint32_t reserved;
+			uint64_t records;
+			uint64_t dropped;
+			uint64_t anchor;
+		};
+		struct TraceRecord {
+			uint64_t time_ns;   // steady_clock since start
+			uint64_t site;
+			uint64_t allocator;
+			uint64_t bytes;
+		};
+
+		// The buffer is allocated by the first start, later ones reuse it and keep its capacity
+		static void start(uint32_t sample_every, size_t capacity = size_t(1) << 20);
+		static void stop();
+		static bool active();
+		static size_t recorded();
+		// Recorded so far, false if path cannot be written
+		static bool dump(const char* path);
+
+		static void sample(const void* allocator, size_t bytes, const void* site);
+	};
+
+	template <bool Enabled>
+	class BasicAllocatorStats {
+	public:
+		void on_allocate(size_t, const void* = nullptr) {}
+		void on_deallocate(size_t) {}
+		void on_reserve(size_t) {}
+		void on_release(size_t) {}
+		AllocatorSnapshot snapshot() const { return {}; }
+	};
+
+	/**
+	* The counters behind AllocatorSnapshot, relaxed atomics so shared allocators can update them from any thread.
+	* Allocators report what they hand out and take back (on_allocate/on_deallocate) and what they get from and give
+	* back to the system (on_reserve/on_release, one chunk each).
+	* @note Copying starts from zero: a copied allocator is a new allocator.
+	*/
+	template <>
+	class BasicAllocatorStats<true> {
+	public:
+		BasicAllocatorStats() = default;
+		BasicAllocatorStats(const BasicAllocatorStats&) noexcept {}
+		BasicAllocatorStats& operator=(const BasicAllocatorStats&) noexcept { return *this; }
+
+		void on_allocate(size_t bytes, const void* site = nullptr) {
+			raise(peak_live_, live_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+			allocations_.fetch_add(1, std::memory_order_relaxed);
+			size_t bucket = bytes <= allocators::MAX_CLASS_SIZE ? allocators::size_class(bytes) : allocators::CLASS_COUNT;
+			classes_[bucket].fetch_add(1, std::memory_order_relaxed);
+			AllocationTrace::sample(this, bytes, site);
+		}
+		void on_deallocate(size_t bytes) {
+			live_.fetch_sub(bytes, std::memory_order_relaxed);
+			deallocations_.fetch_add(1, std::memory_order_relaxed);
+		}
+		void on_reserve(size_t bytes) {
+			raise(peak_reserved_, reserved_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+			raise(peak_chunks_, chunks_.fetch_add(1, std::memory_order_relaxed) + 1);
+		}
+		void on_release(size_t bytes) {
+			reserved_.fetch_sub(bytes, std::memory_order_relaxed);
+			chunks_.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		AllocatorSnapshot snapshot() const {
+			AllocatorSnapshot s;
+			s.enabled = true;
+			s.live_bytes = live_.load(std::memory_order_relaxed);
+			s.peak_live_bytes = peak_live_.load(std::memory_order_relaxed);
+			s.reserved_bytes = reserved_.load(std::memory_order_relaxed);
+			s.peak_reserved_bytes = peak_reserved_.load(std::memory_order_relaxed);
+			s.chunks = chunks_.load(std::memory_order_relaxed);
+			s.peak_chunks = peak_chunks_.load(std::memory_order_relaxed);
+			s.allocations = allocations_.load(std::memory_order_relaxed);
+			s.deallocations = deallocations_.load(std::memory_order_relaxed);
+			for (size_t i = 0; i <= allocators::CLASS_COUNT; ++i) s.class_allocations[i] = classes_[i].load(std::memory_order_relaxed);
+			return s;
+		}
+
+	private:
+		static void raise(std::atomic<uint64_t>& peak, uint64_t value) {
+			uint64_t current = peak.load(std::memory_order_relaxed);
+			while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+		}
+
+		std::atomic<uint64_t> live_{ 0 };
+		std::atomic<uint64_t> peak_live_{ 0 };
+		std::atomic<uint64_t> reserved_{ 0 };
+		std::atomic<uint64_t> peak_reserved_{ 0 };
+		std::atomic<uint64_t> chunks_{ 0 };
+		std::atomic<uint64_t> peak_chunks_{ 0 };
+		std::atomic<uint64_t> allocations_{ 0 };
+		std::atomic<uint64_t> deallocations_{ 0 };
+		std::atomic<uint64_t> classes_[allocators::CLASS_COUNT + 1] = {};
+	};
+
+	using AllocatorStats = BasicAllocatorStats<DEVSW_ALLOCATOR_STATS != 0>;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "devswSTL.h"
+#include "AllocatorStats.h"
 #include <new>
 
 namespace devsw::stl {
@@ -14,10 +15,12 @@ namespace devsw::stl {
 
 		virtual T* allocate(size_t n) {
 			void* p = ::operator new(n * sizeof(T), std::align_val_t{ 32 });
+			stats_.on_allocate(n * sizeof(T), DEVSW_ALLOCATION_SITE());
 			return static_cast<T*>(p);
 		}
 
 		virtual void deallocate(T* p, size_t n) noexcept {
+			stats_.on_deallocate(n * sizeof(T));
 			::operator delete(p, std::align_val_t{ 32 });
 		}
 
@@ -34,6 +37,12 @@ namespace devsw::stl {
 		struct rebind {
 			using other = Allocator<U>;
 		};
+
+		// Counters of this allocator, see AllocatorStats.h. Empty unless built with DEVSW_ALLOCATOR_STATS
+		AllocatorSnapshot stats() const { return stats_.snapshot(); }
+
+	protected:
+		[[no_unique_address]] AllocatorStats stats_;
 	};
 
 	template <typename T>
@@ -48,7 +57,7 @@ namespace devsw::stl {
 		};
 
 		struct Slab {
-			Block* blocks[BLOCKS_PER_SLAB];
+			Block blocks[BLOCKS_PER_SLAB];
 			Slab* next;
 		};
 
@@ -57,6 +66,7 @@ namespace devsw::stl {
 
 		void allocateSlab() {
 			Slab* new_slab = static_cast<Slab*>(::operator new(sizeof(Slab), std::align_val_t{ 32 }));
+			this->stats_.on_reserve(sizeof(Slab));
 			new_slab->next = slabs;
 			slabs = new_slab;
 
@@ -90,6 +100,7 @@ namespace devsw::stl {
 			Block* block = free_list;
 			free_list = free_list->next;
 
+			this->stats_.on_allocate(sizeof(T), DEVSW_ALLOCATION_SITE());
 			return &block->data;
 		}
 
@@ -97,6 +108,7 @@ namespace devsw::stl {
 			if (n != 1) {
 				//TODO Errors...
 			}
+			this->stats_.on_deallocate(sizeof(T));
 			Block* block = reinterpret_cast<Block*>(p);
 			block->next = free_list;
 			free_list = block;
@@ -115,6 +127,7 @@ namespace devsw::stl {
 		StackAllocator() noexcept {
 			buffer = static_cast<uint8_t*>(::operator new(capacity_bytes, std::align_val_t{ 32 }));
 			top = buffer;
+			this->stats_.on_reserve(capacity_bytes);
 		}
 
 		~StackAllocator() noexcept override {
@@ -129,6 +142,7 @@ namespace devsw::stl {
 			}
 			T* result = reinterpret_cast<T*>(top);
 			top += aligned_bytes;
+			this->stats_.on_allocate(aligned_bytes, DEVSW_ALLOCATION_SITE());
 			return result;
 		}
 
@@ -137,11 +151,15 @@ namespace devsw::stl {
 		}
 
 		void reset() noexcept {
+			this->stats_.on_deallocate(static_cast<size_t>(top - buffer));
 			top = buffer;
 		}
 
 		void* get_marker() const noexcept { return top; }
-		void rewind(void* marker) noexcept { top = static_cast<uint8_t*>(marker); }
+		void rewind(void* marker) noexcept {
+			this->stats_.on_deallocate(static_cast<size_t>(top - static_cast<uint8_t*>(marker)));
+			top = static_cast<uint8_t*>(marker);
+		}
 	};
 
 	template <typename T>
@@ -159,6 +177,7 @@ namespace devsw::stl {
 
 		void init_pool() {
 			pool = static_cast<Slot*>(::operator new(sizeof(Slot) * POOL_SIZE, std::align_val_t{ 32 }));
+			this->stats_.on_reserve(sizeof(Slot) * POOL_SIZE);
 			free_list = pool;
 			for (size_t i = 0; i < POOL_SIZE - 1; ++i) {
 				pool[i].next = &pool[i + 1];
@@ -177,11 +196,13 @@ namespace devsw::stl {
 			if (!free_list) throw std::bad_alloc();
 			Slot* slot = free_list;
 			free_list = slot->next;
+			this->stats_.on_allocate(sizeof(T), DEVSW_ALLOCATION_SITE());
 			return &slot->data;
 		}
 
 		void deallocate(T* p, size_t n) noexcept override {
 			if (n != 1) return;
+			this->stats_.on_deallocate(sizeof(T));
 			Slot* slot = reinterpret_cast<Slot*>(p);
 			slot->next = free_list;
 			free_list = slot;
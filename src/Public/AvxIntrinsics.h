@@ -3,12 +3,36 @@
 #include "devswSTL.h"
 #include "Traits.h"
 #include "AlignedVector.h"
+#include "Matrix.h"
+#include "Dispatch.h"
+#include "Parallel.h"
+#include "Views.h"
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace devsw::stl {
+	// Floating point summation strategy for the reductions, integer sums are exact (mod 2^64) whatever is picked
+	enum class Summation : uint8_t {
+		Fast,     // Multiple SIMD accumulators, error grows linearly with n
+		Pairwise, // Recursive halving over SIMD blocks, error grows with log(n) at nearly the same speed
+		Kahan     // Compensated, error independent of n, roughly 4x the adds
+	};
+
 	/**
 	* This struct defines all the high-level methods that utilize the intrinsics by using aligned vectors
-	* @note Fully Optimized for AVX-512 or AVX2, with scalar fallback for remaining elements.
+	* @note Every call goes through the kernel table Dispatch resolved at Init() time, so one binary runs the AVX-512,
+	* AVX2, SSE4.2 or scalar build of each kernel depending on the host.
+	* Element-wise operations run up to aligned_size(), over the cache-line padding every AlignedVector owns,
+	* so they never take a tail path; reductions cannot, and finish with one masked load instead.
+	* A MappedVector (MappedVector.h) works wherever an AlignedVector does, padding included, straight from the page cache.
+	* Every operand may also be an AlignedSpan (Views.h) over memory the library does not own, at any address. Spans have
+	* no padding, so operations on them stop at get_size() and finish with a masked tail. StridedView operands go through
+	* the overloads at the end of this struct.
+	* The element-wise operations take a trailing StoreMode. They work in place, so every line of dest has been read by
+	* the time it is stored and a non-temporal store saves no read-for-ownership, it only evicts the line it was just
+	* handed. Auto therefore stays cached here whatever the size; Streaming is the opt-in for a pass over data nobody
+	* will read again soon. Fills, copies and expressions into new storage stream automatically (Memory.h, Expressions.h).
 	*/
 	struct devswSTL Intrinsics {
 		// ================= High-Level Operations for AlignedVector<T> =================
@@ -18,124 +42,16 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
 		* @param dest Reference to the destination vector, which is modified in place with the sum.
 		* @param src Const reference to the source vector to add to dest.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match.
 		* @note Optimized for AVX-512 or AVX2, with scalar fallback for remaining elements. Because who hates love speed?
 		*/
-		template <typename T>
-		static void add(devsw::stl::AlignedVector<T>& dest, const AlignedVector<T>& src) {
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void add(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != src.get_size()) {
 				//TODO Errors..
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::add_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::add_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::add_i8_512(AVXUtils::load_i8_512(d + i), AVXUtils::load_i8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::add_i16_512(AVXUtils::load_i16_512(d + i), AVXUtils::load_i16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::add_i32_512(AVXUtils::load_i32_512(d + i), AVXUtils::load_i32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::add_i64_512(AVXUtils::load_i64_512(d + i), AVXUtils::load_i64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8_512(d + i, AVXUtils::add_u8_512(AVXUtils::load_u8_512(d + i), AVXUtils::load_u8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16_512(d + i, AVXUtils::add_u16_512(AVXUtils::load_u16_512(d + i), AVXUtils::load_u16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32_512(d + i, AVXUtils::add_u32_512(AVXUtils::load_u32_512(d + i), AVXUtils::load_u32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64_512(d + i, AVXUtils::add_u64_512(AVXUtils::load_u64_512(d + i), AVXUtils::load_u64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::add_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::add_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::add_i8(AVXUtils::load_i8(d + i), AVXUtils::load_i8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::add_i16(AVXUtils::load_i16(d + i), AVXUtils::load_i16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::add_i32(AVXUtils::load_i32(d + i), AVXUtils::load_i32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::add_i64(AVXUtils::load_i64(d + i), AVXUtils::load_i64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8(d + i, AVXUtils::add_u8(AVXUtils::load_u8(d + i), AVXUtils::load_u8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16(d + i, AVXUtils::add_u16(AVXUtils::load_u16(d + i), AVXUtils::load_u16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32(d + i, AVXUtils::add_u32(AVXUtils::load_u32(d + i), AVXUtils::load_u32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64(d + i, AVXUtils::add_u64(AVXUtils::load_u64(d + i), AVXUtils::load_u64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] += s[i];
-			}
-#endif
+			Dispatch::kernels<T>().add(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 		}
 
 		/**
@@ -143,125 +59,17 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
 		* @param dest Reference to the destination vector, which is modified in place with the difference.
 		* @param src Const reference to the source vector to subtract from dest.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match.
 		* @note Leverages AVX-512 or AVX2 for performance, with scalar cleanup. Subtraction: the unsung hero of math.
 		*/
-		template <typename T>
-		static void subtract(AlignedVector<T>& dest, const AlignedVector<T>& src) {
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void subtract(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != src.get_size()) {
 				//TODO Errors...
 			}
 
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::sub_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::sub_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::sub_i8_512(AVXUtils::load_i8_512(d + i), AVXUtils::load_i8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::sub_i16_512(AVXUtils::load_i16_512(d + i), AVXUtils::load_i16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::sub_i32_512(AVXUtils::load_i32_512(d + i), AVXUtils::load_i32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::sub_i64_512(AVXUtils::load_i64_512(d + i), AVXUtils::load_i64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8_512(d + i, AVXUtils::sub_u8_512(AVXUtils::load_u8_512(d + i), AVXUtils::load_u8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16_512(d + i, AVXUtils::sub_u16_512(AVXUtils::load_u16_512(d + i), AVXUtils::load_u16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32_512(d + i, AVXUtils::sub_u32_512(AVXUtils::load_u32_512(d + i), AVXUtils::load_u32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64_512(d + i, AVXUtils::sub_u64_512(AVXUtils::load_u64_512(d + i), AVXUtils::load_u64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::sub_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::sub_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::sub_i8(AVXUtils::load_i8(d + i), AVXUtils::load_i8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::sub_i16(AVXUtils::load_i16(d + i), AVXUtils::load_i16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::sub_i32(AVXUtils::load_i32(d + i), AVXUtils::load_i32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::sub_i64(AVXUtils::load_i64(d + i), AVXUtils::load_i64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8(d + i, AVXUtils::sub_u8(AVXUtils::load_u8(d + i), AVXUtils::load_u8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16(d + i, AVXUtils::sub_u16(AVXUtils::load_u16(d + i), AVXUtils::load_u16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32(d + i, AVXUtils::sub_u32(AVXUtils::load_u32(d + i), AVXUtils::load_u32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64(d + i, AVXUtils::sub_u64(AVXUtils::load_u64(d + i), AVXUtils::load_u64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] -= s[i];
-			}
-#endif
+			Dispatch::kernels<T>().subtract(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 		}
 
 		/**
@@ -269,124 +77,16 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
 		* @param dest Reference to the destination vector, which is modified in place with the product.
 		* @param src Const reference to the source vector to multiply with dest.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match.
 		* @note Uses AVX-512 or AVX2 intrinsics for vectorized multiplication. Multiply like you mean it!
 		*/
-		template <typename T>
-		static void multiply(AlignedVector<T>& dest, const AlignedVector<T>& src) {
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void multiply(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != src.get_size()) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::mul_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::mul_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::mul_i8_512(AVXUtils::load_i8_512(d + i), AVXUtils::load_i8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::mul_i16_512(AVXUtils::load_i16_512(d + i), AVXUtils::load_i16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::mul_i32_512(AVXUtils::load_i32_512(d + i), AVXUtils::load_i32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::mul_i64_512(AVXUtils::load_i64_512(d + i), AVXUtils::load_i64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8_512(d + i, AVXUtils::mul_u8_512(AVXUtils::load_u8_512(d + i), AVXUtils::load_u8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16_512(d + i, AVXUtils::mul_u16_512(AVXUtils::load_u16_512(d + i), AVXUtils::load_u16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32_512(d + i, AVXUtils::mul_u32_512(AVXUtils::load_u32_512(d + i), AVXUtils::load_u32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64_512(d + i, AVXUtils::mul_u64_512(AVXUtils::load_u64_512(d + i), AVXUtils::load_u64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::mul_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::mul_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::mul_i8(AVXUtils::load_i8(d + i), AVXUtils::load_i8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::mul_i16(AVXUtils::load_i16(d + i), AVXUtils::load_i16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::mul_i32(AVXUtils::load_i32(d + i), AVXUtils::load_i32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::mul_i64(AVXUtils::load_i64(d + i), AVXUtils::load_i64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8(d + i, AVXUtils::mul_u8(AVXUtils::load_u8(d + i), AVXUtils::load_u8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16(d + i, AVXUtils::mul_u16(AVXUtils::load_u16(d + i), AVXUtils::load_u16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32(d + i, AVXUtils::mul_u32(AVXUtils::load_u32(d + i), AVXUtils::load_u32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64(d + i, AVXUtils::mul_u64(AVXUtils::load_u64(d + i), AVXUtils::load_u64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] *= s[i];
-			}
-#endif
+			Dispatch::kernels<T>().multiply(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 		}
 
 		/**
@@ -394,47 +94,21 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (must be floating-point: float or double).
 		* @param dest Reference to the destination vector, which is modified in place with the quotient.
 		* @param src Const reference to the source vector to divide dest by.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match or if T is not a floating-point type.
 		* @note Optimized with AVX-512 or AVX2; integers cannot be used here
 		*/
-		template <typename T>
-		static void divide(AlignedVector<T>& dest, const AlignedVector<T>& src) {
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void divide(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != src.get_size()) {
 				//TODO Errors...
 			}
 			if constexpr (!std::is_floating_point_v<T>) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::div_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] /= s[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::div_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] /= s[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::div_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] /= s[i];
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().divide(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::div_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] /= s[i];
-			}
-#endif
 		}
 
 		/**
@@ -442,124 +116,16 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
 		* @param dest Reference to the destination vector, which is modified in place with the minimum values.
 		* @param src Const reference to the source vector to compare with dest.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match.
 		* @note Employs AVX-512 or AVX2 for vectorized min operations. Because small numbers deserve love too.
 		*/
-		template <typename T>
-		static void min(AlignedVector<T>& dest, const AlignedVector<T>& src) {
-			if (dest.get_size() != src.get_size())
-				instrumentation::Instrumentation::log(instrumentation::E_LogLevel::ERROR_, "spectra::stl", "Intrinsics",
-					"Vectors must have the same size", instrumentation::E_LogComponent::CORE, LOCATION);
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::min_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::min_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::min_i8_512(AVXUtils::load_i8_512(d + i), AVXUtils::load_i8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::min_i16_512(AVXUtils::load_i16_512(d + i), AVXUtils::load_i16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::min_i32_512(AVXUtils::load_i32_512(d + i), AVXUtils::load_i32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::min_i64_512(AVXUtils::load_i64_512(d + i), AVXUtils::load_i64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8_512(d + i, AVXUtils::min_u8_512(AVXUtils::load_u8_512(d + i), AVXUtils::load_u8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16_512(d + i, AVXUtils::min_u16_512(AVXUtils::load_u16_512(d + i), AVXUtils::load_u16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32_512(d + i, AVXUtils::min_u32_512(AVXUtils::load_u32_512(d + i), AVXUtils::load_u32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64_512(d + i, AVXUtils::min_u64_512(AVXUtils::load_u64_512(d + i), AVXUtils::load_u64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::min_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::min_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::min_i8(AVXUtils::load_i8(d + i), AVXUtils::load_i8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::min_i16(AVXUtils::load_i16(d + i), AVXUtils::load_i16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::min_i32(AVXUtils::load_i32(d + i), AVXUtils::load_i32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::min_i64(AVXUtils::load_i64(d + i), AVXUtils::load_i64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8(d + i, AVXUtils::min_u8(AVXUtils::load_u8(d + i), AVXUtils::load_u8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16(d + i, AVXUtils::min_u16(AVXUtils::load_u16(d + i), AVXUtils::load_u16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32(d + i, AVXUtils::min_u32(AVXUtils::load_u32(d + i), AVXUtils::load_u32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64(d + i, AVXUtils::min_u64(AVXUtils::load_u64(d + i), AVXUtils::load_u64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::min(d[i], s[i]);
-			}
-#endif
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void min(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			Dispatch::kernels<T>().min(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 		}
 
 		/**
@@ -567,250 +133,220 @@ namespace devsw::stl {
 		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
 		* @param dest Reference to the destination vector, which is modified in place with the maximum values.
 		* @param src Const reference to the source vector to compare with dest.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest and src do not match.
 		* @note Uses AVX-512 or AVX2 intrinsics for speed. Go big or go home, right?
 		*/
-		template <typename T>
-		static void max(AlignedVector<T>& dest, const AlignedVector<T>& src) {
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void max(D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != src.get_size()) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* s = src.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::max_f32_512(AVXUtils::load_f32_512(d + i), AVXUtils::load_f32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::max_f64_512(AVXUtils::load_f64_512(d + i), AVXUtils::load_f64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::max_i8_512(AVXUtils::load_i8_512(d + i), AVXUtils::load_i8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::max_i16_512(AVXUtils::load_i16_512(d + i), AVXUtils::load_i16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::max_i32_512(AVXUtils::load_i32_512(d + i), AVXUtils::load_i32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::max_i64_512(AVXUtils::load_i64_512(d + i), AVXUtils::load_i64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8_512(d + i, AVXUtils::max_u8_512(AVXUtils::load_u8_512(d + i), AVXUtils::load_u8_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16_512(d + i, AVXUtils::max_u16_512(AVXUtils::load_u16_512(d + i), AVXUtils::load_u16_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32_512(d + i, AVXUtils::max_u32_512(AVXUtils::load_u32_512(d + i), AVXUtils::load_u32_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64_512(d + i, AVXUtils::max_u64_512(AVXUtils::load_u64_512(d + i), AVXUtils::load_u64_512(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::max_f32(AVXUtils::load_f32(d + i), AVXUtils::load_f32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::max_f64(AVXUtils::load_f64(d + i), AVXUtils::load_f64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::max_i8(AVXUtils::load_i8(d + i), AVXUtils::load_i8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::max_i16(AVXUtils::load_i16(d + i), AVXUtils::load_i16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::max_i32(AVXUtils::load_i32(d + i), AVXUtils::load_i32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::max_i64(AVXUtils::load_i64(d + i), AVXUtils::load_i64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u8(d + i, AVXUtils::max_u8(AVXUtils::load_u8(d + i), AVXUtils::load_u8(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u16(d + i, AVXUtils::max_u16(AVXUtils::load_u16(d + i), AVXUtils::load_u16(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u32(d + i, AVXUtils::max_u32(AVXUtils::load_u32(d + i), AVXUtils::load_u32(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_u64(d + i, AVXUtils::max_u64(AVXUtils::load_u64(d + i), AVXUtils::load_u64(s + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::max(d[i], s[i]);
-			}
-#endif
+			Dispatch::kernels<T>().max(dest.begin(), src.begin(), views::extent(dest, src), store == StoreMode::Streaming);
 		}
 
 		/**
 		* @brief Computes the element-wise absolute value of an aligned vector, storing the result in place.
 		* @tparam T The data type of the vector elements (must be signed: float, double, int8_t, etc.).
 		* @param dest Reference to the vector, which is modified in place with absolute values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If T is an unsigned type, unsigned abs is a no-go.
 		* @note Optimized with AVX-512 or AVX2; scalar fallback for leftovers. Negatives? Not on our watch!
 		*/
-		template <typename T>
-		static void abs(AlignedVector<T>& dest) {
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void abs(D&& dest, StoreMode store = StoreMode::Auto) {
 			if constexpr (std::is_unsigned_v<T>) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::abs_f32_512(AVXUtils::load_f32_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::abs_f64_512(AVXUtils::load_f64_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8_512(d + i, AVXUtils::abs_i8_512(AVXUtils::load_i8_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16_512(d + i, AVXUtils::abs_i16_512(AVXUtils::load_i16_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32_512(d + i, AVXUtils::abs_i32_512(AVXUtils::load_i32_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64_512(d + i, AVXUtils::abs_i64_512(AVXUtils::load_i64_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::abs_f32(AVXUtils::load_f32(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::abs_f64(AVXUtils::load_f64(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i8(d + i, AVXUtils::abs_i8(AVXUtils::load_i8(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i16(d + i, AVXUtils::abs_i16(AVXUtils::load_i16(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i32(d + i, AVXUtils::abs_i32(AVXUtils::load_i32(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_i64(d + i, AVXUtils::abs_i64(AVXUtils::load_i64(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::abs(d[i]);
-			}
-#endif
+			if constexpr (std::is_signed_v<T>) {
+				Dispatch::kernels<T>().abs(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
 		}
 
 		/**
 		* @brief Computes the element-wise square root of an aligned vector, storing the result in place.
 		* @tparam T The data type of the vector elements (must be floating-point: float or double).
 		* @param dest Reference to the vector, which is modified in place with square root values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If T is not a floating-point type, integers cannot handle this kind of radical.
 		* @note Uses AVX-512 or AVX2 for vectorized square roots. Math just got a little more grounded.
 		*/
-		template <typename T>
-		static void sqrt(AlignedVector<T>& dest) {
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void sqrt(D&& dest, StoreMode store = StoreMode::Auto) {
 			if constexpr (!std::is_floating_point_v<T>) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32_512(d + i, AVXUtils::sqrt_f32_512(AVXUtils::load_f32_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::sqrt(d[i]);
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().sqrt(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		// ================= Transcendentals =================
+		// Vectorized in SimdMath.h, see there for the error bounds of each function.
+		/**
+		* @brief Computes e raised to each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with exp values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Overflows to inf and underflows through the denormals like std::exp. Grows on you.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void exp(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().exp(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the natural logarithm of each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with natural logarithms.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note 0 gives -inf and negative inputs give NaN. Timber!
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void log(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().log(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the base-2 logarithm of each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with base-2 logarithms.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Exact for powers of two. Counting bits the scenic way.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void log2(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().log2(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the sine of each element (radians) of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with sine values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Within 2.5 ulp for |x| < 1000 in float and 1e6 in double, there is no Payne-Hanek reduction past that. Good vibrations.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void sin(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().sin(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the cosine of each element (radians) of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with cosine values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Same range caveat as sin, a quarter turn later.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void cos(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().cos(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the hyperbolic tangent of each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with tanh values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Saturates to +-1 cleanly, no inf / inf. Keeps its cool.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void tanh(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().tanh(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the logistic function 1 / (1 + e^-x) of each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with sigmoid values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Saturates to 0 and 1 without NaNs for large |x|. Squashed, not crushed.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void sigmoid(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().sigmoid(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Computes the Gauss error function of each element of an aligned vector, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the vector, which is modified in place with erf values.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type.
+		* @note Rounds to exactly +-1 past |x| ~ 4 (float) / 6 (double). Normally distributed.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void erf(D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
 			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64_512(d + i, AVXUtils::sqrt_f64_512(AVXUtils::load_f64_512(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::sqrt(d[i]);
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().erf(dest.begin(), views::extent(dest), store == StoreMode::Streaming);
+			}
+		}
+
+		/**
+		* @brief Raises each element of an aligned vector to the matching element of another, storing the result in place.
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param dest Reference to the base vector, which is modified in place with dest[i] ^ exponent[i].
+		* @param exponent Const reference to the exponent vector.
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
+		* @throws std::runtime_error If T is not a floating-point type, or if the sizes do not match.
+		* @note Computed as exp(y * log(x)): negative bases give NaN, and the error grows with |y * log2(x)|. Power hungry.
+		*/
+		template <views::Operand D, views::Operand E, typename T = views::element_t<D>>
+		static void pow(D&& dest, const E& exponent, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
 			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f32(d + i, AVXUtils::sqrt_f32(AVXUtils::load_f32(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::sqrt(d[i]);
+			if (dest.get_size() != exponent.get_size()) {
+				//TODO Errors...
 			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes)
-					AVXUtils::store_f64(d + i, AVXUtils::sqrt_f64(AVXUtils::load_f64(d + i)));
-				for (size_t i = avx_end; i < n; ++i) d[i] = std::sqrt(d[i]);
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().pow(dest.begin(), exponent.begin(), views::extent(dest, exponent), store == StoreMode::Streaming);
 			}
-#endif
 		}
 
 		/**
@@ -822,211 +358,12 @@ namespace devsw::stl {
 		* @throws std::runtime_error If the sizes of a and b do not match.
 		* @note Optimized with AVX-512 or AVX2, including fused multiply-add where available. A scalar worth celebrating!
 		*/
-		template <typename T>
-		static T dot_product(const AlignedVector<T>& a, const AlignedVector<T>& b) {
+		template <views::Operand A, views::Operand B, typename T = views::element_t<A>>
+		static T dot_product(const A& a, const B& b) {
 			if (a.get_size() != b.get_size()) {
 				//TODO Errors...
 			}
-			size_t n = a.get_size();
-			const T* ap = a.begin();
-			const T* bp = b.begin();
-			T result = 0;
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				__m512 sum = _mm512_setzero_ps();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::fmadd_f32_512(AVXUtils::load_f32_512(ap + i), AVXUtils::load_f32_512(bp + i), sum);
-				}
-				result = _mm512_reduce_add_ps(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				__m512d sum = _mm512_setzero_pd();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::fmadd_f64_512(AVXUtils::load_f64_512(ap + i), AVXUtils::load_f64_512(bp + i), sum);
-				}
-				result = _mm512_reduce_add_pd(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i8_512(sum, AVXUtils::mul_i8_512(AVXUtils::load_i8_512(ap + i), AVXUtils::load_i8_512(bp + i)));
-				}
-				alignas(64) int8_t temp[64];
-				AVXUtils::store_i8_512(temp, sum);
-				for (int i = 0; i < 64; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i16_512(sum, AVXUtils::mul_i16_512(AVXUtils::load_i16_512(ap + i), AVXUtils::load_i16_512(bp + i)));
-				}
-				alignas(64) int16_t temp[32];
-				AVXUtils::store_i16_512(temp, sum);
-				for (int i = 0; i < 32; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i32_512(sum, AVXUtils::mul_i32_512(AVXUtils::load_i32_512(ap + i), AVXUtils::load_i32_512(bp + i)));
-				}
-				result = _mm512_reduce_add_epi32(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i64_512(sum, AVXUtils::mul_i64_512(AVXUtils::load_i64_512(ap + i), AVXUtils::load_i64_512(bp + i)));
-				}
-				result = _mm512_reduce_add_epi64(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u8_512(sum, AVXUtils::mul_u8_512(AVXUtils::load_u8_512(ap + i), AVXUtils::load_u8_512(bp + i)));
-				}
-				alignas(64) uint8_t temp[64];
-				AVXUtils::store_u8_512(temp, sum);
-				for (int i = 0; i < 64; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u16_512(sum, AVXUtils::mul_u16_512(AVXUtils::load_u16_512(ap + i), AVXUtils::load_u16_512(bp + i)));
-				}
-				alignas(64) uint16_t temp[32];
-				AVXUtils::store_u16_512(temp, sum);
-				for (int i = 0; i < 32; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u32_512(sum, AVXUtils::mul_u32_512(AVXUtils::load_u32_512(ap + i), AVXUtils::load_u32_512(bp + i)));
-				}
-				result = _mm512_reduce_add_epu32(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				__m512i sum = _mm512_setzero_si512();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u64_512(sum, AVXUtils::mul_u64_512(AVXUtils::load_u64_512(ap + i), AVXUtils::load_u64_512(bp + i)));
-				}
-				result = _mm512_reduce_add_epu64(sum);
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				__m256 sum = _mm256_setzero_ps();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::fmadd_f32(AVXUtils::load_f32(ap + i), AVXUtils::load_f32(bp + i), sum);
-				}
-				alignas(32) float temp[8];
-				AVXUtils::store_f32(temp, sum);
-				for (int i = 0; i < 8; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, double>) {
-				__m256d sum = _mm256_setzero_pd();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::fmadd_f64(AVXUtils::load_f64(ap + i), AVXUtils::load_f64(bp + i), sum);
-				}
-				alignas(32) double temp[4];
-				AVXUtils::store_f64(temp, sum);
-				for (int i = 0; i < 4; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int8_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i8(sum, AVXUtils::mul_i8(AVXUtils::load_i8(ap + i), AVXUtils::load_i8(bp + i)));
-				}
-				alignas(32) int8_t temp[32];
-				AVXUtils::store_i8(temp, sum);
-				for (int i = 0; i < 32; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int16_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i16(sum, AVXUtils::mul_i16(AVXUtils::load_i16(ap + i), AVXUtils::load_i16(bp + i)));
-				}
-				alignas(32) int16_t temp[16];
-				AVXUtils::store_i16(temp, sum);
-				for (int i = 0; i < 16; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int32_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i32(sum, AVXUtils::mul_i32(AVXUtils::load_i32(ap + i), AVXUtils::load_i32(bp + i)));
-				}
-				alignas(32) int32_t temp[8];
-				AVXUtils::store_i32(temp, sum);
-				for (int i = 0; i < 8; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, int64_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_i64(sum, AVXUtils::mul_i64(AVXUtils::load_i64(ap + i), AVXUtils::load_i64(bp + i)));
-				}
-				alignas(32) int64_t temp[4];
-				AVXUtils::store_i64(temp, sum);
-				for (int i = 0; i < 4; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint8_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u8(sum, AVXUtils::mul_u8(AVXUtils::load_u8(ap + i), AVXUtils::load_u8(bp + i)));
-				}
-				alignas(32) uint8_t temp[32];
-				AVXUtils::store_u8(temp, sum);
-				for (int i = 0; i < 32; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint16_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u16(sum, AVXUtils::mul_u16(AVXUtils::load_u16(ap + i), AVXUtils::load_u16(bp + i)));
-				}
-				alignas(32) uint16_t temp[16];
-				AVXUtils::store_u16(temp, sum);
-				for (int i = 0; i < 16; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u32(sum, AVXUtils::mul_u32(AVXUtils::load_u32(ap + i), AVXUtils::load_u32(bp + i)));
-				}
-				alignas(32) uint32_t temp[8];
-				AVXUtils::store_u32(temp, sum);
-				for (int i = 0; i < 8; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-			else if constexpr (std::is_same_v<T, uint64_t>) {
-				__m256i sum = _mm256_setzero_si256();
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					sum = AVXUtils::add_u64(sum, AVXUtils::mul_u64(AVXUtils::load_u64(ap + i), AVXUtils::load_u64(bp + i)));
-				}
-				alignas(32) uint64_t temp[4];
-				AVXUtils::store_u64(temp, sum);
-				for (int i = 0; i < 4; ++i) result += temp[i];
-				for (size_t i = avx_end; i < n; ++i) result += ap[i] * bp[i];
-			}
-#endif
-			return result;
+			return Dispatch::kernels<T>().dot_product(a.begin(), b.begin(), a.get_size());
 		}
 
 		/**
@@ -1035,52 +372,1083 @@ namespace devsw::stl {
 		* @param dest Reference to the destination vector, which is modified in place with the result.
 		* @param a Const reference to the first input vector (multiplicand).
 		* @param b Const reference to the second input vector (multiplier).
+		* @param store StoreMode::Streaming writes dest with non-temporal stores, Auto and Cached through the cache.
 		* @throws std::runtime_error If the sizes of dest, a, and b do not match or if T is not a floating-point type.
 		* @note Leverages AVX-512 or AVX2 fused multiply-add instructions. Three vectors, one destiny!
 		*/
-		template <typename T>
-		static void fmadd(AlignedVector<T>& dest, const AlignedVector<T>& a, const AlignedVector<T>& b) {
+		template <views::Operand D, views::Operand A, views::Operand B, typename T = views::element_t<D>>
+		static void fmadd(D&& dest, const A& a, const B& b, StoreMode store = StoreMode::Auto) {
 			if (dest.get_size() != a.get_size() || dest.get_size() != b.get_size()) {
 				//TODO Errors...
 			}
 			if constexpr (!std::is_floating_point_v<T>) {
 				//TODO Errors...
 			}
-			size_t n = dest.get_size();
-			T* d = dest.begin();
-			const T* ap = a.begin();
-			const T* bp = b.begin();
-#ifdef __AVX512F__
-			constexpr size_t lanes = sizeof(__m512) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					AVXUtils::store_f32_512(d + i, AVXUtils::fmadd_f32_512(AVXUtils::load_f32_512(ap + i), AVXUtils::load_f32_512(bp + i), AVXUtils::load_f32_512(d + i)));
-				}
-				for (size_t i = avx_end; i < n; ++i) d[i] = ap[i] * bp[i] + d[i];
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().fmadd(dest.begin(), a.begin(), b.begin(), views::extent(dest, a, b), store == StoreMode::Streaming);
 			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					AVXUtils::store_f64_512(d + i, AVXUtils::fmadd_f64_512(AVXUtils::load_f64_512(ap + i), AVXUtils::load_f64_512(bp + i), AVXUtils::load_f64_512(d + i)));
-				}
-				for (size_t i = avx_end; i < n; ++i) d[i] = ap[i] * bp[i] + d[i];
-			}
-#else
-			constexpr size_t lanes = sizeof(__m256) / sizeof(T);
-			size_t avx_end = n & ~(lanes - 1);
-			if constexpr (std::is_same_v<T, float>) {
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					AVXUtils::store_f32(d + i, AVXUtils::fmadd_f32(AVXUtils::load_f32(ap + i), AVXUtils::load_f32(bp + i), AVXUtils::load_f32(d + i)));
-				}
-				for (size_t i = avx_end; i < n; ++i) d[i] = ap[i] * bp[i] + d[i];
+		}
+
+		// ================= Reductions =================
+
+		/**
+		* @brief Sums every element of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the vector to sum.
+		* @param mode Accuracy mode for float and double, ignored for integers.
+		* @return sum_t<T> The sum; integer inputs accumulate in 64-bit lanes, so int8 and int16 cannot overflow.
+		* @note Four independent accumulators keep the adders busy. Summing it all up, quickly.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static sum_t<T> sum(const S& src, Summation mode = Summation::Fast) {
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			if constexpr (std::is_floating_point_v<T>) {
+				if (mode == Summation::Pairwise) return kernels.sum_pairwise(src.begin(), src.get_size());
+				if (mode == Summation::Kahan) return kernels.sum_kahan(src.begin(), src.get_size());
+			}
+			return kernels.sum(src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Finds the smallest element of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the vector to search, must not be empty.
+		* @return T The minimum value.
+		* @throws std::runtime_error If src is empty.
+		* @note Same overload set as the element-wise min, one argument means reduce. Smallest of them all!
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static T min(const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return T();
 			}
-			else if constexpr (std::is_same_v<T, double>) {
-				for (size_t i = 0; i < avx_end; i += lanes) {
-					AVXUtils::store_f64(d + i, AVXUtils::fmadd_f64(AVXUtils::load_f64(ap + i), AVXUtils::load_f64(bp + i), AVXUtils::load_f64(d + i)));
-				}
-				for (size_t i = avx_end; i < n; ++i) d[i] = ap[i] * bp[i] + d[i];
+			return Dispatch::kernels<T>().reduce_min(src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Finds the largest element of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the vector to search, must not be empty.
+		* @return T The maximum value.
+		* @throws std::runtime_error If src is empty.
+		* @note One argument reduces, two arguments work element-wise. There can be only one.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static T max(const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return T();
+			}
+			return Dispatch::kernels<T>().reduce_max(src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Finds the index of the first smallest element of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the vector to search, must not be empty.
+		* @return size_t Index of the first occurrence of the minimum.
+		* @throws std::runtime_error If src is empty.
+		* @note Blocks are reduced with SIMD min and only the winning block is rescanned. NaNs are not ordered.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static size_t argmin(const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return 0;
+			}
+			return Dispatch::kernels<T>().argmin(src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Finds the index of the first largest element of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the vector to search, must not be empty.
+		* @return size_t Index of the first occurrence of the maximum.
+		* @throws std::runtime_error If src is empty.
+		* @note Blocks are reduced with SIMD max and only the winning block is rescanned. NaNs are not ordered.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static size_t argmax(const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return 0;
+			}
+			return Dispatch::kernels<T>().argmax(src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Computes the arithmetic mean of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the input vector.
+		* @param mode Accuracy mode of the underlying sum for float and double.
+		* @return real_t<T> The mean, float for float input and double otherwise.
+		* @throws std::runtime_error If src is empty.
+		* @note Perfectly average, in the best way.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static real_t<T> mean(const S& src, Summation mode = Summation::Fast) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+			}
+			return static_cast<real_t<T>>(sum(src, mode)) / static_cast<real_t<T>>(src.get_size());
+		}
+
+		/**
+		* @brief Computes the variance of an aligned vector with the two-pass algorithm (mean first, then squared deviations).
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the input vector.
+		* @param ddof Delta degrees of freedom, 0 for the population variance and 1 for the sample variance.
+		* @param mode Accuracy mode of the mean for float and double.
+		* @return real_t<T> The variance, float for float input and double otherwise.
+		* @throws std::runtime_error If src has no more than ddof elements.
+		* @note Two passes avoid the catastrophic cancellation of sum(x^2) - sum(x)^2. It varies.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static real_t<T> variance(const S& src, size_t ddof = 0, Summation mode = Summation::Fast) {
+			if (src.get_size() <= ddof) {
+				//TODO Errors...
+			}
+			real_t<T> center = mean(src, mode);
+			real_t<T> deviation = Dispatch::kernels<T>().sum_squared_deviation(src.begin(), src.get_size(), center);
+			return deviation / static_cast<real_t<T>>(src.get_size() - ddof);
+		}
+
+		/**
+		* @brief Computes the Euclidean norm of an aligned vector.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param src Const reference to the input vector.
+		* @return real_t<T> sqrt(sum(x^2)), float for float input and double otherwise.
+		* @note Squares are accumulated with FMA in real_t<T>, so integer inputs cannot overflow. As the crow flies.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static real_t<T> l2_norm(const S& src) {
+			return std::sqrt(Dispatch::kernels<T>().sum_squared_deviation(src.begin(), src.get_size(), real_t<T>(0)));
+		}
+
+		// ================= Compare =================
+		// Predicates packed one bit per element into 64-bit words, lane i of a in bit i % 64 of bits[i / 64]
+
+		/**
+		* @brief Compares two aligned vectors element-wise, writing the results as a packed bitset.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param bits Output bitset, resized to (size + 63) / 64 words. Bits past size are zero.
+		* @param a Const reference to the left-hand vector.
+		* @param b Const reference to the right-hand vector.
+		* @param op Predicate, a[i] op b[i].
+		* @throws std::runtime_error If the sizes of a and b do not match.
+		* @note 64 results per store instead of 64 branches. Floating point compares follow C++, NaN is only != to anything.
+		*/
+		template <views::OperandOf<uint64_t> M, views::Operand A, views::Operand B, typename T = views::element_t<A>>
+		static void compare(M&& bits, const A& a, const B& b, Comparison op) {
+			if (a.get_size() != b.get_size()) {
+				//TODO Errors...
+			}
+			bits.resize((a.get_size() + 63) / 64);
+			Dispatch::kernels<T>().compare(bits.begin(), a.begin(), b.begin(), a.get_size(), op);
+		}
+
+		/**
+		* @brief Compares every element of an aligned vector against one value, writing the results as a packed bitset.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param bits Output bitset, resized to (size + 63) / 64 words. Bits past size are zero.
+		* @param a Const reference to the vector to test.
+		* @param value Right-hand side of every comparison, a[i] op value.
+		* @param op Predicate.
+		* @note The building block of a columnar filter: compare, then AND/OR the bitsets. No branches were mispredicted.
+		*/
+		template <views::OperandOf<uint64_t> M, views::Operand A, typename T = views::element_t<A>>
+		static void compare(M&& bits, const A& a, views::element_t<A> value, Comparison op) {
+			bits.resize((a.get_size() + 63) / 64);
+			Dispatch::kernels<T>().compare_scalar(bits.begin(), a.begin(), value, a.get_size(), op);
+		}
+
+		/**
+		* @brief Stream compaction: copies the elements of src whose bit is set to the front of dest, in order.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to the number of selected elements. May be src itself.
+		* @param src Const reference to the source vector.
+		* @param bits Selection bitset as written by compare, at least (size + 63) / 64 words.
+		* @return size_t The number of elements written.
+		* @throws std::runtime_error If bits is too short for src.
+		* @note 32/64-bit lanes are packed with vpcompress (AVX-512) or a shuffle table (AVX2/SSE4.2), 8/16-bit lanes with
+		* a branchless store-and-advance. Selectivity no longer matters, the branch predictor is off the hook.
+		*/
+		template <views::Operand D, views::Operand S, views::OperandOf<uint64_t> M, typename T = views::element_t<D>>
+		static size_t compress(D&& dest, const S& src, const M& bits) {
+			if (bits.get_size() * 64 < src.get_size()) {
+				//TODO Errors...
 			}
-#endif
+			dest.resize(src.get_size());
+			size_t count = Dispatch::kernels<T>().compress(dest.begin(), src.begin(), bits.begin(), src.get_size());
+			dest.resize(count);
+			return count;
+		}
+
+		/**
+		* @brief Stream compaction with the predicate fused in: keeps the elements of src for which src[i] op value holds.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to the number of selected elements. May be src itself.
+		* @param src Const reference to the source vector.
+		* @param op Predicate.
+		* @param value Right-hand side of every comparison.
+		* @return size_t The number of elements written.
+		* @note One pass, the mask never leaves the register. WHERE clause, meet vector unit.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static size_t compress(D&& dest, const S& src, Comparison op, views::element_t<D> value) {
+			dest.resize(src.get_size());
+			size_t count = Dispatch::kernels<T>().compress_scalar(dest.begin(), src.begin(), value, src.get_size(), op);
+			dest.resize(count);
+			return count;
+		}
+
+		// ================= Scans =================
+		// Prefix operations, dest is resized to src and may be src itself. Floating point sums are reassociated
+		// within a vector, so they can differ from a left-to-right loop in the last bits
+
+		/**
+		* @brief Inclusive prefix sum, dest[i] = init + src[0] + ... + src[i].
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @param init Value the running sum starts from.
+		* @note Integer sums wrap in T. Shift-and-add in registers, one add per vector on the critical path.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void inclusive_scan(D&& dest, const S& src, views::element_t<D> init = {}) {
+			dest.resize(src.get_size());
+			Dispatch::kernels<T>().inclusive_scan(dest.begin(), src.begin(), src.get_size(), init);
+		}
+
+		/**
+		* @brief Exclusive prefix sum, dest[0] = init and dest[i] = init + src[0] + ... + src[i - 1].
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector, e.g. record lengths.
+		* @param init Value the running sum starts from, e.g. the base offset.
+		* @note Lengths in, offsets out. The total is dest.back() + src.back().
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void exclusive_scan(D&& dest, const S& src, views::element_t<D> init = {}) {
+			dest.resize(src.get_size());
+			Dispatch::kernels<T>().exclusive_scan(dest.begin(), src.begin(), src.get_size(), init);
+		}
+
+		/**
+		* @brief Running minimum, dest[i] = min(src[0], ..., src[i]).
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @note NaNs are not ordered. The lowest low so far.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void running_min(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::kernels<T>().running_min(dest.begin(), src.begin(), src.get_size(), scan_identity<T>(false));
+		}
+
+		/**
+		* @brief Running maximum, dest[i] = max(src[0], ..., src[i]).
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @note NaNs are not ordered. High-water mark, vectorized.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void running_max(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::kernels<T>().running_max(dest.begin(), src.begin(), src.get_size(), scan_identity<T>(true));
+		}
+
+		// ================= Sorting =================
+
+		/**
+		* @brief Sorts data in ascending order, in place.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param data Reference to the vector to sort.
+		* @note Floating point values are sorted in total order: -0 before +0, NaNs at the end matching their sign bit.
+		* Up to a few thousand elements a bitonic network and vector merge (AVX2/AVX-512, 32/64-bit lanes), past that an
+		* LSD radix sort that skips the bytes every key agrees on. Not stable, not that values can tell.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void sort(D&& data) {
+			Dispatch::kernels<T>().sort(data.begin(), data.get_size());
+		}
+
+		/**
+		* @brief Argsort: index[k] is the position in keys of the k-th smallest key.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param index Destination vector, resized to keys.
+		* @param keys Const reference to the keys, left untouched.
+		* @note Same order as sort, and stable: equal keys keep their original order. Ranks the scores, moves the rows later.
+		*/
+		template <views::OperandOf<size_t> I, views::Operand K, typename T = views::element_t<K>>
+		static void argsort(I&& index, const K& keys) {
+			index.resize(keys.get_size());
+			Dispatch::kernels<T>().argsort(index.begin(), keys.begin(), keys.get_size());
+		}
+
+		// ================= Histograms =================
+		// counts is caller-owned and only added to, so one vector can collect several batches. Its size is the bin count
+
+		/**
+		* @brief Counts the integer values of src into counts: ++counts[v] for every value v in [0, counts.get_size()).
+		* @tparam T The data type of the vector elements (must be integral: int8_t ... uint64_t).
+		* @param counts Reference to the bins, added to. Negative values and values past the last bin are skipped.
+		* @param src Const reference to the values, left untouched.
+		* @throws std::runtime_error If T is not an integral type, or there are 2^32 bins or more.
+		* @note Up to 2048 bins the counts are spread over four sub-histograms merged at the end, so runs of equal values
+		* do not serialize on one counter. Past that, vpconflictd gather/scatter on AVX-512. Everybody gets counted.
+		*/
+		template <views::OperandOf<uint32_t> C, views::Operand S, typename T = views::element_t<S>>
+		static void histogram(C&& counts, const S& src) {
+			if constexpr (!std::is_integral_v<T>) {
+				//TODO Errors...
+			}
+			if (counts.get_size() > std::numeric_limits<uint32_t>::max()) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_integral_v<T>) {
+				Dispatch::kernels<T>().histogram(counts.begin(), counts.get_size(), src.begin(), src.get_size());
+			}
+		}
+
+		/**
+		* @brief Buckets the floating-point values of src into counts.get_size() equal-width bins over [low, high).
+		* @tparam T The data type of the vector elements (must be floating-point: float or double).
+		* @param counts Reference to the bins, added to. Bin k covers [low + k * width, low + (k + 1) * width).
+		* @param src Const reference to the values, left untouched. NaNs and values outside [low, high) are skipped.
+		* @param low Lower bound of the first bin, inclusive.
+		* @param high Upper bound of the last bin, exclusive.
+		* @throws std::runtime_error If T is not a floating-point type, high <= low, or there are 2^32 bins or more.
+		* @note Same sub-histogram/conflict-detection split as the integer overload. A bell curve in two lines of code.
+		*/
+		template <views::OperandOf<uint32_t> C, views::Operand S, typename T = views::element_t<S>>
+		static void histogram(C&& counts, const S& src, views::element_t<S> low, views::element_t<S> high) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if (!(low < high) || counts.get_size() > std::numeric_limits<uint32_t>::max()) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				if (counts.get_size() == 0) return;
+				Dispatch::kernels<T>().histogram_range(counts.begin(), counts.get_size(), src.begin(), src.get_size(), low, high);
+			}
+		}
+
+		// ================= Indexed Access =================
+		// 32-bit indices, the width vpgatherdd/vpscatterdd take. Tables of 2^31 elements or more fall back to scalar loops
+
+		/**
+		* @brief Gathers dest[i] = table[indices[i]].
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param dest Destination vector, resized to indices. May not be table.
+		* @param table Const reference to the lookup table.
+		* @param indices Const reference to the row of table for each element of dest.
+		* @param check Checked (default) reads T() for indices past the table, Unchecked trusts every index.
+		* @return The number of out-of-range indices, 0 when Unchecked.
+		* @note vpgatherd* for 32/64-bit elements on AVX2 and AVX-512, with the rows a few vectors ahead prefetched once the
+		* table outgrows L2. Indices that run in order cost nothing extra. Join probes rejoice.
+		*/
+		template <views::Operand D, views::Operand L, views::OperandOf<uint32_t> I, typename T = views::element_t<D>>
+		static size_t gather(D&& dest, const L& table, const I& indices, BoundsCheck check = BoundsCheck::Checked) {
+			if (dest.begin() == table.begin()) {
+				//TODO Errors...
+			}
+			dest.resize(indices.get_size());
+			return Dispatch::kernels<T>().gather(dest.begin(), table.begin(), table.get_size(), indices.begin(), indices.get_size(), check);
+		}
+
+		/**
+		* @brief Scatters table[indices[i]] = src[i], in order of i.
+		* @tparam T The data type of the vector elements (e.g., float, double, int32_t, etc.).
+		* @param table Reference to the table written into. Its size does not change.
+		* @param indices Const reference to the row of table for each element of src. Of repeated indices the last one wins.
+		* @param src Const reference to the values.
+		* @param check Checked (default) skips indices past the table, Unchecked trusts every index.
+		* @return The number of out-of-range indices, 0 when Unchecked.
+		* @throws std::runtime_error If the sizes of indices and src do not match.
+		* @note vpscatterd* on AVX-512, a scalar store loop below that. Everything in its right place.
+		*/
+		template <views::Operand L, views::OperandOf<uint32_t> I, views::Operand S, typename T = views::element_t<L>>
+		static size_t scatter(L&& table, const I& indices, const S& src, BoundsCheck check = BoundsCheck::Checked) {
+			if (indices.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			return Dispatch::kernels<T>().scatter(table.begin(), table.get_size(), indices.begin(), src.begin(), src.get_size(), check);
+		}
+
+		// ================= Linear Algebra =================
+		// Row-major Matrix operands, no transposes. Floating point only
+
+		/**
+		* @brief General matrix multiply, c = alpha * a * b + beta * c.
+		* @tparam T float or double.
+		* @param c Output matrix, a.get_rows() x b.get_cols(). Only read when beta is not 0.
+		* @param a Const reference to the left-hand matrix, m x k.
+		* @param b Const reference to the right-hand matrix, k x n.
+		* @param alpha Scale of the product.
+		* @param beta Scale of the existing contents of c.
+		* @throws std::runtime_error If the shapes do not line up, or c aliases a or b.
+		* @note Cache-blocked with packed panels and an MR x NR register tile, see Gemm.h. Peak FLOPs, finally.
+		*/
+		template <typename T>
+		static void gemm(Matrix<T>& c, const Matrix<T>& a, const Matrix<T>& b, T alpha = T(1), T beta = T(0)) {
+			if (a.get_cols() != b.get_rows() || c.get_rows() != a.get_rows() || c.get_cols() != b.get_cols()) {
+				//TODO Errors...
+			}
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				Dispatch::kernels<T>().gemm(c.get_rows(), c.get_cols(), a.get_cols(), alpha, a.data(), a.get_stride(),
+					b.data(), b.get_stride(), beta, c.data(), c.get_stride());
+			}
+		}
+
+		/**
+		* @brief General matrix-vector multiply, y = alpha * a * x + beta * y.
+		* @tparam T float or double.
+		* @param y Output vector, resized to a.get_rows(). Only read when beta is not 0.
+		* @param a Const reference to the matrix, m x n.
+		* @param x Const reference to the input vector, n elements.
+		* @param alpha Scale of the product.
+		* @param beta Scale of the existing contents of y.
+		* @throws std::runtime_error If x does not have a.get_cols() elements.
+		* @note Four rows per pass share every load of x. Memory bound, as matrix-vector products have always been.
+		*/
+		template <typename T, views::OperandOf<T> Y, views::OperandOf<T> X>
+		static void gemv(Y&& y, const Matrix<T>& a, const X& x, T alpha = T(1), T beta = T(0)) {
+			if (x.get_size() != a.get_cols()) {
+				//TODO Errors...
+			}
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				y.resize(a.get_rows());
+				Dispatch::kernels<T>().gemv(a.get_rows(), a.get_cols(), alpha, a.data(), a.get_stride(), x.begin(), beta, y.begin());
+			}
+		}
+
+		// ================= Conversions =================
+		// float against the narrow storage formats, dest is resized to src. Narrowing rounds to nearest even
+
+		/**
+		* @brief Narrows floats to IEEE half precision.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @note Out of range values become infinity, NaN stays NaN. Half the bytes, most of the bits.
+		*/
+		template <views::OperandOf<float16> D, views::OperandOf<float> S>
+		static void convert(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::conversions().f32_to_f16(dest.begin(), src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Widens IEEE half precision values to float, exactly.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		*/
+		template <views::OperandOf<float> D, views::OperandOf<float16> S>
+		static void convert(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::conversions().f16_to_f32(dest.begin(), src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Narrows floats to bfloat16, the top half of each float rounded to nearest even.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @note Same range as float, a third of the mantissa. Good enough for embeddings, not for accountants.
+		*/
+		template <views::OperandOf<bfloat16> D, views::OperandOf<float> S>
+		static void convert(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::conversions().f32_to_bf16(dest.begin(), src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Widens bfloat16 values to float, exactly.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		*/
+		template <views::OperandOf<float> D, views::OperandOf<bfloat16> S>
+		static void convert(D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			Dispatch::conversions().bf16_to_f32(dest.begin(), src.begin(), src.get_size());
+		}
+
+		/**
+		* @brief Converts floats to 8-bit integers, rounding to nearest even and saturating. quantize with scale 1.
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @note NaN becomes the lowest code.
+		*/
+		template <views::Operand D, views::OperandOf<float> S, typename Q = views::element_t<D>> requires is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>
+		static void convert(D&& dest, const S& src) {
+			quantize(dest, src, 1.0f, 0);
+		}
+
+		/**
+		* @brief Converts 8-bit integers to float, exactly. dequantize with scale 1.
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		*/
+		template <views::OperandOf<float> D, views::Operand S, typename Q = views::element_t<S>> requires is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>
+		static void convert(D&& dest, const S& src) {
+			dequantize(dest, src, 1.0f, 0);
+		}
+
+		/**
+		* @brief Affine quantization with one scale and zero point for the whole vector.
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src. dest[i] = saturate(round(src[i] / scale) + zero_point).
+		* @param src Const reference to the input vector.
+		* @param scale Step between adjacent codes, must be positive.
+		* @param zero_point Code that 0.0f maps to, 0 for symmetric int8.
+		* @note The division is a multiply by 1 / scale, as most int8 runtimes do it. Four times smaller, a little blurrier.
+		*/
+		template <views::Operand D, views::OperandOf<float> S, typename Q = views::element_t<D>>
+		static void quantize(D&& dest, const S& src, float scale, int32_t zero_point = 0) {
+			static_assert(is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>, "Quantization targets int8_t or uint8_t");
+			if (!(scale > 0.0f)) {
+				//TODO Errors...
+			}
+			dest.resize(src.get_size());
+			quantize_kernel<Q>()(dest.begin(), src.begin(), src.get_size(), scale, zero_point);
+		}
+
+		/**
+		* @brief Blockwise affine quantization, block b of block_size elements uses scales[b] and zero_points[b].
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the input vector.
+		* @param block_size Elements per block, the last block may be shorter.
+		* @param scales One scale per block.
+		* @param zero_points One zero point per block, or empty for all zero.
+		* @throws std::runtime_error If there are fewer scales (or zero points) than blocks.
+		* @note Per-block scales keep one outlier from flattening the whole vector.
+		*/
+		template <views::Operand D, views::OperandOf<float> S, typename Q = views::element_t<D>>
+		static void quantize(D&& dest, const S& src, size_t block_size,
+			const AlignedVector<float>& scales, const AlignedVector<int32_t>& zero_points = AlignedVector<int32_t>()) {
+			static_assert(is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>, "Quantization targets int8_t or uint8_t");
+			size_t n = src.get_size();
+			size_t blocks = block_size ? (n + block_size - 1) / block_size : 0;
+			if (block_size == 0 || scales.get_size() < blocks || (zero_points.get_size() && zero_points.get_size() < blocks)) {
+				//TODO Errors...
+			}
+			dest.resize(n);
+			auto kernel = quantize_kernel<Q>();
+			for (size_t b = 0; b < blocks; ++b) {
+				size_t begin = b * block_size;
+				size_t count = n - begin < block_size ? n - begin : block_size;
+				kernel(dest.begin() + begin, src.begin() + begin, count, scales[b], zero_points.get_size() ? zero_points[b] : 0);
+			}
+		}
+
+		/**
+		* @brief Inverse of quantize, dest[i] = (src[i] - zero_point) * scale.
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the quantized vector.
+		* @param scale Scale used to quantize.
+		* @param zero_point Zero point used to quantize.
+		*/
+		template <views::OperandOf<float> D, views::Operand S, typename Q = views::element_t<S>>
+		static void dequantize(D&& dest, const S& src, float scale, int32_t zero_point = 0) {
+			static_assert(is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>, "Quantization targets int8_t or uint8_t");
+			dest.resize(src.get_size());
+			dequantize_kernel<Q>()(dest.begin(), src.begin(), src.get_size(), scale, zero_point);
+		}
+
+		/**
+		* @brief Blockwise inverse of quantize, see the blockwise quantize for the layout.
+		* @tparam Q int8_t or uint8_t.
+		* @param dest Destination vector, resized to src.
+		* @param src Const reference to the quantized vector.
+		* @param block_size Elements per block, the last block may be shorter.
+		* @param scales One scale per block.
+		* @param zero_points One zero point per block, or empty for all zero.
+		* @throws std::runtime_error If there are fewer scales (or zero points) than blocks.
+		*/
+		template <views::OperandOf<float> D, views::Operand S, typename Q = views::element_t<S>>
+		static void dequantize(D&& dest, const S& src, size_t block_size,
+			const AlignedVector<float>& scales, const AlignedVector<int32_t>& zero_points = AlignedVector<int32_t>()) {
+			static_assert(is_same_v<Q, int8_t> || is_same_v<Q, uint8_t>, "Quantization targets int8_t or uint8_t");
+			size_t n = src.get_size();
+			size_t blocks = block_size ? (n + block_size - 1) / block_size : 0;
+			if (block_size == 0 || scales.get_size() < blocks || (zero_points.get_size() && zero_points.get_size() < blocks)) {
+				//TODO Errors...
+			}
+			dest.resize(n);
+			auto kernel = dequantize_kernel<Q>();
+			for (size_t b = 0; b < blocks; ++b) {
+				size_t begin = b * block_size;
+				size_t count = n - begin < block_size ? n - begin : block_size;
+				kernel(dest.begin() + begin, src.begin() + begin, count, scales[b], zero_points.get_size() ? zero_points[b] : 0);
+			}
+		}
+
+		/**
+		* @brief Dot product of two int8 vectors, accumulated in int32.
+		* @param a Const reference to the first vector.
+		* @param b Const reference to the second vector.
+		* @return int32_t The sum of a[i] * b[i], exact while it fits in int32_t.
+		* @throws std::runtime_error If the sizes of a and b do not match.
+		* @note vpdpbusd on AVX-512 VNNI hosts, widen and pmaddwd elsewhere. Scale the result by both scales to get floats back.
+		*/
+		template <views::OperandOf<int8_t> A, views::OperandOf<int8_t> B>
+		static int32_t dot_product_i32(const A& a, const B& b) {
+			if (a.get_size() != b.get_size()) {
+				//TODO Errors...
+			}
+			return Dispatch::conversions().dot_i8(a.begin(), b.begin(), a.get_size());
+		}
+
+		/**
+		* @brief Dot product of a uint8 vector (e.g. asymmetric activations) with an int8 vector, accumulated in int32.
+		* @param a Const reference to the unsigned vector.
+		* @param b Const reference to the signed vector.
+		* @return int32_t The sum of a[i] * b[i], exact while it fits in int32_t.
+		* @throws std::runtime_error If the sizes of a and b do not match.
+		* @note The operand order vpdpbusd wants, one instruction per 64 bytes.
+		*/
+		template <views::OperandOf<uint8_t> A, views::OperandOf<int8_t> B>
+		static int32_t dot_product_i32(const A& a, const B& b) {
+			if (a.get_size() != b.get_size()) {
+				//TODO Errors...
+			}
+			return Dispatch::conversions().dot_u8i8(a.begin(), b.begin(), a.get_size());
+		}
+
+		// ================= Parallel Operations =================
+		// Same kernels as above, run over cache-line aligned chunks on the ThreadPool. Pass par, or a tuned policy.
+
+		/**
+		* @brief Parallel element-wise addition of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Split across the worker pool. Many hands make light work.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void add(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().add;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			bool stream = store == StoreMode::Streaming;
+			Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+		}
+
+		/**
+		* @brief Parallel element-wise subtraction of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Every core takes its share of the difference.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void subtract(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().subtract;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			bool stream = store == StoreMode::Streaming;
+			Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+		}
+
+		/**
+		* @brief Parallel element-wise multiplication of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Multiplying the multipliers.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void multiply(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().multiply;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			bool stream = store == StoreMode::Streaming;
+			Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+		}
+
+		/**
+		* @brief Parallel element-wise minimum of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note The smallest effort per core.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void min(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().min;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			bool stream = store == StoreMode::Streaming;
+			Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+		}
+
+		/**
+		* @brief Parallel element-wise maximum of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Maximum effort, from all cores.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void max(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().max;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			bool stream = store == StoreMode::Streaming;
+			Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+		}
+
+		/**
+		* @brief Parallel element-wise division of two aligned vectors, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Divide and conquer, literally.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void divide(const ParallelPolicy& policy, D&& dest, const S& src, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != src.get_size()) {
+				//TODO Errors...
+			}
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				auto kernel = Dispatch::kernels<T>().divide;
+				T* d = dest.begin();
+				const T* s = src.begin();
+				bool stream = store == StoreMode::Streaming;
+				Parallel::for_each_chunk<T>(policy, views::extent(dest, src), [=](size_t begin, size_t end) { kernel(d + begin, s + begin, end - begin, stream); });
+			}
+		}
+
+		/**
+		* @brief Parallel in-place absolute value, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Positively parallel.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void abs(const ParallelPolicy& policy, D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (std::is_unsigned_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_signed_v<T>) {
+				auto kernel = Dispatch::kernels<T>().abs;
+				T* d = dest.begin();
+				bool stream = store == StoreMode::Streaming;
+				Parallel::for_each_chunk<T>(policy, views::extent(dest), [=](size_t begin, size_t end) { kernel(d + begin, end - begin, stream); });
+			}
+		}
+
+		/**
+		* @brief Parallel in-place square root, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Square roots, grown on every core.
+		*/
+		template <views::Operand D, typename T = views::element_t<D>>
+		static void sqrt(const ParallelPolicy& policy, D&& dest, StoreMode store = StoreMode::Auto) {
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				auto kernel = Dispatch::kernels<T>().sqrt;
+				T* d = dest.begin();
+				bool stream = store == StoreMode::Streaming;
+				Parallel::for_each_chunk<T>(policy, views::extent(dest), [=](size_t begin, size_t end) { kernel(d + begin, end - begin, stream); });
+			}
+		}
+
+		/**
+		* @brief Parallel fused multiply-add (dest = a * b + dest), see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param store StoreMode::Streaming for non-temporal stores from every chunk, as in the serial overload.
+		* @note Three vectors, one destiny, many threads.
+		*/
+		template <views::Operand D, views::Operand A, views::Operand B, typename T = views::element_t<D>>
+		static void fmadd(const ParallelPolicy& policy, D&& dest, const A& a, const B& b, StoreMode store = StoreMode::Auto) {
+			if (dest.get_size() != a.get_size() || dest.get_size() != b.get_size()) {
+				//TODO Errors...
+			}
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				auto kernel = Dispatch::kernels<T>().fmadd;
+				T* d = dest.begin();
+				const T* pa = a.begin();
+				const T* pb = b.begin();
+				bool stream = store == StoreMode::Streaming;
+				Parallel::for_each_chunk<T>(policy, views::extent(dest, a, b), [=](size_t begin, size_t end) { kernel(d + begin, pa + begin, pb + begin, end - begin, stream); });
+			}
+		}
+
+		/**
+		* @brief Parallel dot product, each chunk reduces on its own and the partial sums are added in chunk order.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @return T The dot product, the same for any thread count given the same policy.
+		* @note Partial to partial sums.
+		*/
+		template <views::Operand A, views::Operand B, typename T = views::element_t<A>>
+		static T dot_product(const ParallelPolicy& policy, const A& a, const B& b) {
+			if (a.get_size() != b.get_size()) {
+				//TODO Errors...
+			}
+			auto kernel = Dispatch::kernels<T>().dot_product;
+			const T* pa = a.begin();
+			const T* pb = b.begin();
+			return Parallel::reduce_chunks<T, T>(policy, a.get_size(),
+				[=](size_t begin, size_t end) { return kernel(pa + begin, pb + begin, end - begin); },
+				[](T x, T y) { return T(x + y); });
+		}
+
+		/**
+		* @brief Parallel sum, each chunk is summed with the chosen mode and the partials are added in chunk order.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @param mode Accuracy mode for float and double, ignored for integers.
+		* @note Chunking is itself one level of pairwise summation.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static sum_t<T> sum(const ParallelPolicy& policy, const S& src, Summation mode = Summation::Fast) {
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			auto kernel = kernels.sum;
+			if constexpr (std::is_floating_point_v<T>) {
+				if (mode == Summation::Pairwise) kernel = kernels.sum_pairwise;
+				if (mode == Summation::Kahan) kernel = kernels.sum_kahan;
+			}
+			const T* s = src.begin();
+			return Parallel::reduce_chunks<T, sum_t<T>>(policy, src.get_size(),
+				[=](size_t begin, size_t end) { return kernel(s + begin, end - begin); },
+				[](sum_t<T> x, sum_t<T> y) { return sum_t<T>(x + y); });
+		}
+
+		/**
+		* @brief Parallel minimum of an aligned vector, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note Every core finds its smallest, then they compare notes.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static T min(const ParallelPolicy& policy, const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return T();
+			}
+			auto kernel = Dispatch::kernels<T>().reduce_min;
+			const T* s = src.begin();
+			return Parallel::reduce_chunks<T, T>(policy, src.get_size(),
+				[=](size_t begin, size_t end) { return kernel(s + begin, end - begin); },
+				[](T x, T y) { return y < x ? y : x; });
+		}
+
+		/**
+		* @brief Parallel maximum of an aligned vector, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note Every core finds its largest, then they compare notes.
+		*/
+		template <views::Operand S, typename T = views::element_t<S>>
+		static T max(const ParallelPolicy& policy, const S& src) {
+			if (src.get_size() == 0) {
+				//TODO Errors...
+				return T();
+			}
+			auto kernel = Dispatch::kernels<T>().reduce_max;
+			const T* s = src.begin();
+			return Parallel::reduce_chunks<T, T>(policy, src.get_size(),
+				[=](size_t begin, size_t end) { return kernel(s + begin, end - begin); },
+				[](T x, T y) { return y > x ? y : x; });
+		}
+
+		/**
+		* @brief Parallel general matrix multiply, see the serial overload.
+		* @param policy Chunking policy, e.g. par. serial_threshold applies to the bytes of a, b and c together.
+		* @note c is cut into row slabs, one per pool thread, each run through the serial kernel with its own packing
+		* buffers. Slabs are whole multiples of the register tile height and rows are cache line aligned, so no two
+		* threads share a line of c. Every slab packs all of b, which is cheap next to the m * n * k of its own work.
+		*/
+		template <typename T>
+		static void gemm(const ParallelPolicy& policy, Matrix<T>& c, const Matrix<T>& a, const Matrix<T>& b, T alpha = T(1), T beta = T(0)) {
+			if (a.get_cols() != b.get_rows() || c.get_rows() != a.get_rows() || c.get_cols() != b.get_cols()) {
+				//TODO Errors...
+			}
+			if constexpr (!std::is_floating_point_v<T>) {
+				//TODO Errors...
+			}
+			if constexpr (std::is_floating_point_v<T>) {
+				constexpr size_t SLAB_ROWS = 12; // Multiple of the register tile height of every tier
+				size_t m = c.get_rows(), n = c.get_cols(), k = a.get_cols();
+				size_t bytes = (m * k + k * n + m * n) * sizeof(T);
+				size_t threads = ThreadPool::concurrency();
+				if (bytes < policy.serial_threshold || threads < 2 || m < 2 * SLAB_ROWS) {
+					gemm(c, a, b, alpha, beta);
+					return;
+				}
+				size_t slab = ((m + threads - 1) / threads + SLAB_ROWS - 1) / SLAB_ROWS * SLAB_ROWS;
+				auto kernel = Dispatch::kernels<T>().gemm;
+				auto task = [&](size_t index) {
+					size_t begin = index * slab;
+					size_t rows = m - begin < slab ? m - begin : slab;
+					kernel(rows, n, k, alpha, a.row(begin), a.get_stride(), b.data(), b.get_stride(), beta, c.row(begin), c.get_stride());
+				};
+				ThreadPool::run((m + slab - 1) / slab, task);
+			}
+		}
+
+
+		/**
+		* @brief Parallel inclusive prefix sum, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note Two passes: every chunk is summed, the chunk sums are scanned on the calling thread, then every chunk is
+		* scanned from its carry-in. Floating point results depend on the grain size, not on the thread count.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void inclusive_scan(const ParallelPolicy& policy, D&& dest, const S& src, views::element_t<D> init = {}) {
+			dest.resize(src.get_size());
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			auto sum = kernels.sum;
+			auto scan = kernels.inclusive_scan;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			Parallel::scan_chunks<T>(policy, src.get_size(), init,
+				[=](size_t begin, size_t end) { return static_cast<T>(sum(s + begin, end - begin)); },
+				[](T x, T y) { return T(x + y); },
+				[=](size_t begin, size_t end, T carry) { scan(d + begin, s + begin, end - begin, carry); });
+		}
+
+		/**
+		* @brief Parallel exclusive prefix sum, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note Same two passes as the parallel inclusive_scan. Offsets for a billion records before the coffee cools.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void exclusive_scan(const ParallelPolicy& policy, D&& dest, const S& src, views::element_t<D> init = {}) {
+			dest.resize(src.get_size());
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			auto sum = kernels.sum;
+			auto scan = kernels.exclusive_scan;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			Parallel::scan_chunks<T>(policy, src.get_size(), init,
+				[=](size_t begin, size_t end) { return static_cast<T>(sum(s + begin, end - begin)); },
+				[](T x, T y) { return T(x + y); },
+				[=](size_t begin, size_t end, T carry) { scan(d + begin, s + begin, end - begin, carry); });
+		}
+
+		/**
+		* @brief Parallel running minimum, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note The same two passes, with min in place of the sum.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void running_min(const ParallelPolicy& policy, D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			auto reduce = kernels.reduce_min;
+			auto scan = kernels.running_min;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			Parallel::scan_chunks<T>(policy, src.get_size(), scan_identity<T>(false),
+				[=](size_t begin, size_t end) { return reduce(s + begin, end - begin); },
+				[](T x, T y) { return y < x ? y : x; },
+				[=](size_t begin, size_t end, T carry) { scan(d + begin, s + begin, end - begin, carry); });
+		}
+
+		/**
+		* @brief Parallel running maximum, see the serial overload.
+		* @param policy Chunking policy, e.g. par or par.with_grain_size(bytes).
+		* @note The same two passes, with max in place of the sum.
+		*/
+		template <views::Operand D, views::Operand S, typename T = views::element_t<D>>
+		static void running_max(const ParallelPolicy& policy, D&& dest, const S& src) {
+			dest.resize(src.get_size());
+			const KernelTable<T>& kernels = Dispatch::kernels<T>();
+			auto reduce = kernels.reduce_max;
+			auto scan = kernels.running_max;
+			T* d = dest.begin();
+			const T* s = src.begin();
+			Parallel::scan_chunks<T>(policy, src.get_size(), scan_identity<T>(true),
+				[=](size_t begin, size_t end) { return reduce(s + begin, end - begin); },
+				[](T x, T y) { return y > x ? y : x; },
+				[=](size_t begin, size_t end, T carry) { scan(d + begin, s + begin, end - begin, carry); });
+		}
+
+		// ================= Strided Operands =================
+		// Every operation above, serial and parallel, with StridedView arguments in place of vectors. Each one is staged
+		// into contiguous scratch and the operation runs on that. The destination, the first argument after the policy,
+		// is scattered back before returning; sources are only read, reductions write nothing back.
+#define DEVSW_STRIDED_OVERLOAD(name, role) \
+		template <typename... A> requires views::AnyStrided<A...> \
+		static decltype(auto) name(A&&... args) { \
+			return views::unstride(output_of<role, A...>(), [](auto&... staged) -> decltype(auto) { return Intrinsics::name(staged...); }, std::forward<A>(args)...); \
+		}
+		DEVSW_STRIDED_OVERLOAD(add, Role::Writes) DEVSW_STRIDED_OVERLOAD(subtract, Role::Writes) DEVSW_STRIDED_OVERLOAD(multiply, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(divide, Role::Writes) DEVSW_STRIDED_OVERLOAD(min, Role::WritesIfBinary) DEVSW_STRIDED_OVERLOAD(max, Role::WritesIfBinary)
+		DEVSW_STRIDED_OVERLOAD(abs, Role::Writes) DEVSW_STRIDED_OVERLOAD(sqrt, Role::Writes) DEVSW_STRIDED_OVERLOAD(exp, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(log, Role::Writes) DEVSW_STRIDED_OVERLOAD(log2, Role::Writes) DEVSW_STRIDED_OVERLOAD(sin, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(cos, Role::Writes) DEVSW_STRIDED_OVERLOAD(tanh, Role::Writes) DEVSW_STRIDED_OVERLOAD(sigmoid, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(erf, Role::Writes) DEVSW_STRIDED_OVERLOAD(pow, Role::Writes) DEVSW_STRIDED_OVERLOAD(dot_product, Role::Reads)
+		DEVSW_STRIDED_OVERLOAD(fmadd, Role::Writes) DEVSW_STRIDED_OVERLOAD(sum, Role::Reads) DEVSW_STRIDED_OVERLOAD(argmin, Role::Reads)
+		DEVSW_STRIDED_OVERLOAD(argmax, Role::Reads) DEVSW_STRIDED_OVERLOAD(mean, Role::Reads) DEVSW_STRIDED_OVERLOAD(variance, Role::Reads)
+		DEVSW_STRIDED_OVERLOAD(l2_norm, Role::Reads) DEVSW_STRIDED_OVERLOAD(compare, Role::Writes) DEVSW_STRIDED_OVERLOAD(compress, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(inclusive_scan, Role::Writes) DEVSW_STRIDED_OVERLOAD(exclusive_scan, Role::Writes) DEVSW_STRIDED_OVERLOAD(running_min, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(running_max, Role::Writes) DEVSW_STRIDED_OVERLOAD(sort, Role::Writes) DEVSW_STRIDED_OVERLOAD(argsort, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(histogram, Role::Writes) DEVSW_STRIDED_OVERLOAD(gather, Role::Writes) DEVSW_STRIDED_OVERLOAD(scatter, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(gemv, Role::Writes) DEVSW_STRIDED_OVERLOAD(convert, Role::Writes) DEVSW_STRIDED_OVERLOAD(quantize, Role::Writes)
+		DEVSW_STRIDED_OVERLOAD(dequantize, Role::Writes) DEVSW_STRIDED_OVERLOAD(dot_product_i32, Role::Reads)
+#undef DEVSW_STRIDED_OVERLOAD
+
+	private:
+		// What a strided overload writes back: its destination, nothing (reductions), or its destination when it has
+		// one, i.e. min/max with two operands rather than the min/max of one
+		enum class Role { Reads, Writes, WritesIfBinary };
+
+		template <Role R, typename P, typename... A>
+		static constexpr size_t output_of() {
+			constexpr size_t first = is_same_v<remove_const_t<remove_reference_t<P>>, ParallelPolicy> ? 1 : 0;
+			if constexpr (R == Role::Reads) return views::NO_OUTPUT;
+			else if constexpr (R == Role::WritesIfBinary) return 1 + sizeof...(A) - first > 1 ? first : views::NO_OUTPUT;
+			else return first;
+		}
+
+		// Starting value of a running min (the largest T) or max (the smallest)
+		template <typename T>
+		static T scan_identity(bool max) {
+			if constexpr (std::numeric_limits<T>::has_infinity) return max ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+			else return max ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+		}
+
+		template <typename Q>
+		static auto quantize_kernel() {
+			if constexpr (is_same_v<Q, int8_t>) return Dispatch::conversions().quantize_i8;
+			else return Dispatch::conversions().quantize_u8;
+		}
+
+		template <typename Q>
+		static auto dequantize_kernel() {
+			if constexpr (is_same_v<Q, int8_t>) return Dispatch::conversions().dequantize_i8;
+			else return Dispatch::conversions().dequantize_u8;
 		}
 	};
 };
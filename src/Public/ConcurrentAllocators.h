@@ -0,0 +1,362 @@
+#pragma once
+
+#include "devswSTL.h"
+#include "Allocators.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+#include <vector>
+
+namespace devsw::stl {
+	namespace allocators {
+		/**
+		* Lock-free LIFO of nodes with an atomic next pointer, Treiber style. The head packs a 16-bit version above a
+		* 48-bit pointer (every x86-64 and AArch64 user address), so a pop racing a pop and push of the same node fails
+		* its compare-exchange instead of linking a stale next (ABA).
+		* @note Nodes are read after they may have been popped elsewhere, so they must stay mapped until the stack dies.
+		*/
+		template <typename N>
+		class TaggedStack {
+			static_assert(sizeof(void*) == 8, "TaggedStack packs a version next to a 48-bit pointer");
+			static constexpr uint64_t POINTER_MASK = (uint64_t(1) << 48) - 1;
+
+		public:
+			void push(N* node) {
+				uint64_t old = head_.load(std::memory_order_relaxed);
+				uint64_t desired;
+				do {
+					node->next.store(unpack(old), std::memory_order_relaxed);
+					desired = pack(node, old);
+				} while (!head_.compare_exchange_weak(old, desired, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			N* pop() {
+				uint64_t old = head_.load(std::memory_order_acquire);
+				while (N* node = unpack(old)) {
+					if (head_.compare_exchange_weak(old, pack(node->next.load(std::memory_order_relaxed), old),
+						std::memory_order_acquire, std::memory_order_acquire)) return node;
+				}
+				return nullptr;
+			}
+
+		private:
+			static N* unpack(uint64_t head) { return reinterpret_cast<N*>(head & POINTER_MASK); }
+			static uint64_t pack(N* node, uint64_t previous) {
+				return reinterpret_cast<uint64_t>(node) | (((previous >> 48) + 1) << 48);
+			}
+
+			std::atomic<uint64_t> head_{ 0 };
+		};
+
+		// One thread's cache in one allocator, handed back through release when the thread exits
+		struct ThreadCacheEntry {
+			uint64_t id;
+			void* owner;
+			void* cache;
+			void (*release)(void* owner, void* cache);
+		};
+
+		// Allocator ids still alive. Thread exit and allocator destruction both hold the mutex, so a cache is never
+		// released into an allocator that is being torn down
+		inline std::mutex& registry_mutex() {
+			static std::mutex mutex;
+			return mutex;
+		}
+		inline std::unordered_set<uint64_t>& live_allocators() {
+			static std::unordered_set<uint64_t> ids;
+			return ids;
+		}
+		inline uint64_t register_allocator() {
+			static std::atomic<uint64_t> next_id{ 1 };
+			uint64_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+			std::lock_guard<std::mutex> lock(registry_mutex());
+			live_allocators().insert(id);
+			return id;
+		}
+		inline void unregister_allocator(uint64_t id) {
+			std::lock_guard<std::mutex> lock(registry_mutex());
+			live_allocators().erase(id);
+		}
+
+		// Every cache this thread holds, released when it exits
+		struct ThreadCaches {
+			std::vector<ThreadCacheEntry> entries;
+
+			~ThreadCaches() {
+				std::lock_guard<std::mutex> lock(registry_mutex());
+				for (const ThreadCacheEntry& entry : entries) {
+					if (live_allocators().count(entry.id)) entry.release(entry.owner, entry.cache);
+				}
+			}
+
+			void* find(uint64_t id) const {
+				for (const ThreadCacheEntry& entry : entries) if (entry.id == id) return entry.cache;
+				return nullptr;
+			}
+
+			// Also forgets the entries of allocators destroyed since
+			void add(const ThreadCacheEntry& entry) {
+				std::lock_guard<std::mutex> lock(registry_mutex());
+				size_t kept = 0;
+				for (const ThreadCacheEntry& old : entries) if (live_allocators().count(old.id)) entries[kept++] = old;
+				entries.resize(kept);
+				entries.push_back(entry);
+			}
+		};
+
+		inline ThreadCaches& thread_caches() {
+			thread_local ThreadCaches caches;
+			return caches;
+		}
+
+		// The cache of the allocator this thread used last, trivial so reading it needs no thread_local init guard
+		struct LastCache {
+			uint64_t id;
+			void* cache;
+		};
+		inline thread_local LastCache last_cache{ 0, nullptr };
+	}
+
+	/**
+	* Fixed-size object allocator that any number of threads can share, including freeing what another thread
+	* allocated (one thread producing messages, another consuming them). tcache-style front-end over slabs:
+	* - Each thread allocates from and frees to two magazines of its own (Bonwick's loaded and previous), no atomics.
+	* - A lock-free depot swaps whole magazines, full for empty, when a thread runs out or fills up.
+	* - A block freed by a thread other than the one whose slab it came from is pushed onto that thread's lock-free
+	*   remote-free list, which the owner takes in one exchange the next time its magazines run dry.
+	* Blocks come from size-aligned slabs (64 KiB unless T is large) carved by their owning thread, so the owner of a
+	* block is found by masking its address.
+	* @note allocate(n) with n != 1 falls through to Allocator<T>, as does the matching deallocate.
+	* A thread's cache is handed to the next new thread when it exits, and everything is freed with the allocator.
+	* The allocator must outlive every call into it.
+	*/
+	template <typename T, size_t MagazineSize = 64>
+	class devswSTL ConcurrentPoolAllocator final : public Allocator<T> {
+		static_assert(MagazineSize > 0, "Magazines must hold at least one block");
+
+		struct Block {
+			Block* next;
+		};
+
+		struct Magazine {
+			std::atomic<Magazine*> next; // Depot link
+			Magazine* all_next;          // Every magazine, for the destructor
+			size_t count;
+			Block* blocks[MagazineSize];
+		};
+
+		struct alignas(64) Cache {
+			Magazine* loaded = nullptr;
+			Magazine* previous = nullptr;
+			char* carve = nullptr;     // Unused tail of the slab this cache is carving
+			char* carve_end = nullptr;
+			Cache* all_next = nullptr;
+			std::atomic<bool> abandoned{ false };
+			alignas(64) std::atomic<Block*> remote{ nullptr }; // Written by other threads, on a line of its own
+		};
+
+		struct Slab {
+			Slab* all_next;
+			Cache* owner;
+		};
+
+		static constexpr size_t BLOCK_ALIGN = alignof(T) > alignof(Block) ? alignof(T) : alignof(Block);
+		static constexpr size_t BLOCK_SIZE = ((sizeof(T) > sizeof(Block) ? sizeof(T) : sizeof(Block)) + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+		static constexpr size_t HEADER_SIZE = (sizeof(Slab) + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+		static constexpr size_t slab_size() {
+			size_t size = 64 * 1024;
+			while (size < HEADER_SIZE + 16 * BLOCK_SIZE) size <<= 1;
+			return size;
+		}
+		static constexpr size_t SLAB_SIZE = slab_size();
+
+	public:
+		ConcurrentPoolAllocator() : id_(allocators::register_allocator()) {}
+
+		ConcurrentPoolAllocator(const ConcurrentPoolAllocator&) = delete;
+		ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+		~ConcurrentPoolAllocator() noexcept override {
+			allocators::unregister_allocator(id_);
+			if (allocators::last_cache.id == id_) allocators::last_cache = { 0, nullptr };
+			for (Slab* slab = slabs_.load(std::memory_order_acquire); slab;) {
+				Slab* next = slab->all_next;
+				::operator delete(slab, std::align_val_t{ SLAB_SIZE });
+				slab = next;
+			}
+			for (Magazine* magazine = magazines_.load(std::memory_order_acquire); magazine;) {
+				Magazine* next = magazine->all_next;
+				delete magazine;
+				magazine = next;
+			}
+			for (Cache* cache = caches_.load(std::memory_order_acquire); cache;) {
+				Cache* next = cache->all_next;
+				delete cache;
+				cache = next;
+			}
+		}
+
+		T* allocate(size_t n) override {
+			if (n != 1) return Allocator<T>::allocate(n);
+			this->stats_.on_allocate(sizeof(T), DEVSW_ALLOCATION_SITE());
+			Cache* cache = local_cache();
+			Magazine* loaded = cache->loaded;
+			if (loaded->count) return reinterpret_cast<T*>(loaded->blocks[--loaded->count]);
+			return reinterpret_cast<T*>(refill(cache));
+		}
+
+		void deallocate(T* p, size_t n) noexcept override {
+			if (!p) return;
+			if (n != 1) {
+				Allocator<T>::deallocate(p, n);
+				return;
+			}
+			this->stats_.on_deallocate(sizeof(T));
+			Block* block = reinterpret_cast<Block*>(p);
+			Cache* cache = local_cache();
+			Cache* owner = slab_of(block)->owner;
+			if (owner != cache) {
+				Block* head = owner->remote.load(std::memory_order_relaxed);
+				do {
+					block->next = head;
+				} while (!owner->remote.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+				return;
+			}
+			Magazine* loaded = cache->loaded;
+			if (loaded->count < MagazineSize) {
+				loaded->blocks[loaded->count++] = block;
+				return;
+			}
+			put_slow(cache, block);
+		}
+
+	private:
+		static Slab* slab_of(void* p) {
+			return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p) & ~(SLAB_SIZE - 1));
+		}
+
+		template <typename N>
+		static void push_all(std::atomic<N*>& list, N* node) {
+			N* head = list.load(std::memory_order_relaxed);
+			do {
+				node->all_next = head;
+			} while (!list.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		Cache* local_cache() {
+			allocators::LastCache& last = allocators::last_cache;
+			if (last.id == id_) return static_cast<Cache*>(last.cache);
+			Cache* cache = static_cast<Cache*>(allocators::thread_caches().find(id_));
+			if (!cache) cache = attach();
+			last = { id_, cache };
+			return cache;
+		}
+
+		// A cache for this thread: one an exited thread left behind, or a new one
+		Cache* attach() {
+			Cache* cache = nullptr;
+			for (Cache* c = caches_.load(std::memory_order_acquire); c && !cache; c = c->all_next) {
+				bool abandoned = true;
+				if (c->abandoned.load(std::memory_order_relaxed)
+					&& c->abandoned.compare_exchange_strong(abandoned, false, std::memory_order_acquire)) cache = c;
+			}
+			if (!cache) {
+				cache = new Cache();
+				cache->loaded = empty_magazine();
+				cache->previous = empty_magazine();
+				push_all(caches_, cache);
+			}
+			allocators::thread_caches().add({ id_, this, cache, &ConcurrentPoolAllocator::release });
+			return cache;
+		}
+
+		// Thread exit: magazines go to the depot, remote frees and the carving slab stay for the next owner
+		static void release(void* owner, void* c) {
+			ConcurrentPoolAllocator* self = static_cast<ConcurrentPoolAllocator*>(owner);
+			Cache* cache = static_cast<Cache*>(c);
+			for (Magazine** magazine : { &cache->loaded, &cache->previous }) {
+				if ((*magazine)->count) {
+					self->full_.push(*magazine);
+					*magazine = self->empty_magazine();
+				}
+			}
+			cache->abandoned.store(true, std::memory_order_release);
+		}
+
+		Magazine* empty_magazine() {
+			Magazine* magazine = empty_.pop();
+			if (!magazine) {
+				magazine = new Magazine();
+				push_all(magazines_, magazine);
+			}
+			magazine->count = 0;
+			return magazine;
+		}
+
+		// Both magazines full: the previous one goes to the depot, an empty one takes its place
+		void put_slow(Cache* cache, Block* block) {
+			if (cache->previous->count < MagazineSize) {
+				Magazine* loaded = cache->loaded;
+				cache->loaded = cache->previous;
+				cache->previous = loaded;
+			}
+			else {
+				full_.push(cache->previous);
+				cache->previous = cache->loaded;
+				cache->loaded = empty_magazine();
+			}
+			cache->loaded->blocks[cache->loaded->count++] = block;
+		}
+
+		// Loaded magazine empty: previous magazine, remote frees, depot, then a new slab, in that order
+		Block* refill(Cache* cache) {
+			if (cache->previous->count) {
+				Magazine* loaded = cache->loaded;
+				cache->loaded = cache->previous;
+				cache->previous = loaded;
+				return cache->loaded->blocks[--cache->loaded->count];
+			}
+			if (Block* remote = cache->remote.exchange(nullptr, std::memory_order_acquire)) {
+				Block* first = remote;
+				for (Block* block = remote->next; block;) {
+					Block* next = block->next;
+					Magazine* loaded = cache->loaded;
+					if (loaded->count < MagazineSize) loaded->blocks[loaded->count++] = block;
+					else put_slow(cache, block);
+					block = next;
+				}
+				return first;
+			}
+			if (Magazine* full = full_.pop()) {
+				empty_.push(cache->loaded);
+				cache->loaded = full;
+				return full->blocks[--full->count];
+			}
+			if (cache->carve == cache->carve_end) {
+				Slab* slab = static_cast<Slab*>(::operator new(SLAB_SIZE, std::align_val_t{ SLAB_SIZE }));
+				slab->owner = cache;
+				push_all(slabs_, slab);
+				this->stats_.on_reserve(SLAB_SIZE);
+				cache->carve = reinterpret_cast<char*>(slab) + HEADER_SIZE;
+				cache->carve_end = cache->carve + (SLAB_SIZE - HEADER_SIZE) / BLOCK_SIZE * BLOCK_SIZE;
+			}
+			Block* first = reinterpret_cast<Block*>(cache->carve);
+			cache->carve += BLOCK_SIZE;
+			Magazine* loaded = cache->loaded;
+			while (loaded->count < MagazineSize && cache->carve != cache->carve_end) {
+				loaded->blocks[loaded->count++] = reinterpret_cast<Block*>(cache->carve);
+				cache->carve += BLOCK_SIZE;
+			}
+			return first;
+		}
+
+		const uint64_t id_;
+		allocators::TaggedStack<Magazine> full_;
+		allocators::TaggedStack<Magazine> empty_;
+		std::atomic<Magazine*> magazines_{ nullptr };
+		std::atomic<Cache*> caches_{ nullptr };
+		std::atomic<Slab*> slabs_{ nullptr };
+	};
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#include "devswSTL.h"
+#include "Traits.h"
+
+namespace devsw::stl {
+	// Instruction set tiers the kernels are compiled for, narrowest first
+	enum class SimdTier : uint8_t {
+		Scalar = 0,
+		SSE42 = 1,
+		AVX2 = 2,   // AVX2 + FMA + F16C
+		AVX512 = 3  // AVX-512 F/BW/CD/DQ/VL, as in x86-64-v4
+	};
+
+	// Predicate for Intrinsics::compare. Floating point compares are ordered (NaN fails), except NotEqual, as in C++
+	enum class Comparison : uint8_t {
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual
+	};
+
+	// Index handling of Intrinsics::gather/scatter. Checked reads T() for, or skips, indices past the table and counts them;
+	// Unchecked trusts every index and saves the test
+	enum class BoundsCheck : uint8_t {
+		Checked,
+		Unchecked
+	};
+
+	// How an Intrinsics op (or copy_range/fill_range) writes its destination. Streaming stores are non-temporal: they go
+	// to memory without reading the lines in first and without evicting anything, a win only once the output is too big
+	// to be read back from cache anyway. Auto streams writes that never read dest from Dispatch::streaming_threshold()
+	// bytes up, and keeps the in-place Intrinsics cached
+	enum class StoreMode : uint8_t {
+		Auto,
+		Cached,
+		Streaming
+	};
+
+	// CPUID bits the tiers (and a few kernels) care about, already masked by what the OS saves on context switch
+	struct CpuFeatures {
+		bool sse42 = false;
+		bool popcnt = false;
+		bool avx = false;
+		bool avx2 = false;
+		bool fma = false;
+		bool f16c = false;
+		bool bmi2 = false;
+		bool erms = false;   // Enhanced rep movsb/stosb
+		bool fsrm = false;   // Fast short rep movsb
+		bool avx512f = false;
+		bool avx512bw = false;
+		bool avx512dq = false;
+		bool avx512vl = false;
+		bool avx512cd = false;
+		bool avx512vnni = false;
+		size_t last_level_cache = 0; // Bytes, 0 if CPUID does not say
+	};
+
+	/**
+	* Resolved kernel entry points for one element type. Each tier translation unit fills one of these.
+	* @note Entries that make no sense for T (divide, sqrt, fmadd, the compensated sums and the transcendentals for integers, abs for
+	* unsigned) stay nullptr. reduce_min/reduce_max/argmin/argmax expect n > 0. The element-wise entries take stream, true
+	* for non-temporal stores (see StoreMode).
+	*/
+	template <typename T>
+	struct KernelTable {
+		void (*add)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*subtract)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*multiply)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*divide)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*min)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*max)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+		void (*abs)(T* dest, size_t n, bool stream) = nullptr;
+		void (*sqrt)(T* dest, size_t n, bool stream) = nullptr;
+		T (*dot_product)(const T* a, const T* b, size_t n) = nullptr;
+		void (*fmadd)(T* dest, const T* a, const T* b, size_t n, bool stream) = nullptr;
+
+		// Horizontal reductions
+		sum_t<T> (*sum)(const T* src, size_t n) = nullptr;
+		sum_t<T> (*sum_pairwise)(const T* src, size_t n) = nullptr;
+		sum_t<T> (*sum_kahan)(const T* src, size_t n) = nullptr;
+		T (*reduce_min)(const T* src, size_t n) = nullptr;
+		T (*reduce_max)(const T* src, size_t n) = nullptr;
+		size_t (*argmin)(const T* src, size_t n) = nullptr;
+		size_t (*argmax)(const T* src, size_t n) = nullptr;
+		real_t<T> (*sum_squared_deviation)(const T* src, size_t n, real_t<T> center) = nullptr;
+
+		// Transcendentals (SimdMath.h), floating point only. pow is dest[i] = dest[i] ^ src[i]
+		void (*exp)(T* dest, size_t n, bool stream) = nullptr;
+		void (*log)(T* dest, size_t n, bool stream) = nullptr;
+		void (*log2)(T* dest, size_t n, bool stream) = nullptr;
+		void (*sin)(T* dest, size_t n, bool stream) = nullptr;
+		void (*cos)(T* dest, size_t n, bool stream) = nullptr;
+		void (*tanh)(T* dest, size_t n, bool stream) = nullptr;
+		void (*sigmoid)(T* dest, size_t n, bool stream) = nullptr;
+		void (*erf)(T* dest, size_t n, bool stream) = nullptr;
+		void (*pow)(T* dest, const T* src, size_t n, bool stream) = nullptr;
+
+		// Packed predicate results, bit i of bits[i / 64] is a[i] op b[i] (or a[i] op value). Bits past n are zero
+		void (*compare)(uint64_t* bits, const T* a, const T* b, size_t n, Comparison op) = nullptr;
+		void (*compare_scalar)(uint64_t* bits, const T* a, T value, size_t n, Comparison op) = nullptr;
+		// Stream compaction, copies the selected src[i] to the front of dest in order and returns how many. dest may be src
+		size_t (*compress)(T* dest, const T* src, const uint64_t* bits, size_t n) = nullptr;
+		size_t (*compress_scalar)(T* dest, const T* src, T value, size_t n, Comparison op) = nullptr;
+
+		// Prefix scans, dest[i] = init op src[0] op ... op src[i] (exclusive: up to src[i - 1]). dest may be src.
+		// Sums wrap for integers, running_min/running_max take the identity (or a carry-in) as init
+		void (*inclusive_scan)(T* dest, const T* src, size_t n, T init) = nullptr;
+		void (*exclusive_scan)(T* dest, const T* src, size_t n, T init) = nullptr;
+		void (*running_min)(T* dest, const T* src, size_t n, T init) = nullptr;
+		void (*running_max)(T* dest, const T* src, size_t n, T init) = nullptr;
+
+		// Ascending sorts (Sort.h). Floating point keys in total order, NaNs at the end matching their sign bit.
+		// argsort fills index with the positions of keys in sorted order, equal keys in their original order
+		void (*sort)(T* data, size_t n) = nullptr;
+		void (*argsort)(size_t* index, const T* keys, size_t n) = nullptr;
+
+		// Histograms, counts[bin] is added to rather than overwritten. histogram (integers) counts values in [0, bins),
+		// histogram_range (floating point) splits [low, high) into bins equal-width buckets. Anything else is skipped
+		void (*histogram)(uint32_t* counts, size_t bins, const T* src, size_t n) = nullptr;
+		void (*histogram_range)(uint32_t* counts, size_t bins, const T* src, size_t n, T low, T high) = nullptr;
+
+		// Indexed access, dest[i] = table[indices[i]] and table[indices[i]] = src[i] in order of i (the last write to a
+		// repeated index wins). dest may not overlap table. Both return how many indices were out of range, 0 when Unchecked
+		size_t (*gather)(T* dest, const T* table, size_t table_size, const uint32_t* indices, size_t n, BoundsCheck check) = nullptr;
+		size_t (*scatter)(T* table, size_t table_size, const uint32_t* indices, const T* src, size_t n, BoundsCheck check) = nullptr;
+		// Strided copies behind StridedView (Views.h), element i of the strided side at its base + i * stride bytes.
+		// Neither side needs to be aligned, not even to sizeof(T)
+		void (*load_strided)(T* dest, const T* src, ptrdiff_t stride, size_t n) = nullptr;
+		void (*store_strided)(T* dest, ptrdiff_t stride, const T* src, size_t n) = nullptr;
+
+		// Dense linear algebra (Gemm.h), floating point only, row-major with leading dimensions in elements.
+		// gemm is C = alpha * A * B + beta * C with A m x k and B k x n, gemv is y = alpha * A * x + beta * y with A m x n
+		void (*gemm)(size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc) = nullptr;
+		void (*gemv)(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) = nullptr;
+	};
+
+	/**
+	* Resolved mixed-precision kernels, float against the narrow storage formats, one per tier like KernelTable.
+	* quantize is dest[i] = saturate(round(src[i] / scale) + zero_point), computed as src[i] * (1 / scale);
+	* dequantize is dest[i] = (src[i] - zero_point) * scale. Rounding is to nearest even throughout.
+	* @note dot_i8/dot_u8i8 accumulate in 32-bit lanes, which wrap, so the result is exact whenever the true sum fits
+	* in int32_t. On AVX-512 hosts with VNNI both are bound to vpdpbusd.
+	*/
+	struct ConvertTable {
+		void (*f32_to_f16)(float16* dest, const float* src, size_t n) = nullptr;
+		void (*f16_to_f32)(float* dest, const float16* src, size_t n) = nullptr;
+		void (*f32_to_bf16)(bfloat16* dest, const float* src, size_t n) = nullptr;
+		void (*bf16_to_f32)(float* dest, const bfloat16* src, size_t n) = nullptr;
+		void (*quantize_i8)(int8_t* dest, const float* src, size_t n, float scale, int32_t zero_point) = nullptr;
+		void (*quantize_u8)(uint8_t* dest, const float* src, size_t n, float scale, int32_t zero_point) = nullptr;
+		void (*dequantize_i8)(float* dest, const int8_t* src, size_t n, float scale, int32_t zero_point) = nullptr;
+		void (*dequantize_u8)(float* dest, const uint8_t* src, size_t n, float scale, int32_t zero_point) = nullptr;
+		int32_t (*dot_i8)(const int8_t* a, const int8_t* b, size_t n) = nullptr;
+		int32_t (*dot_u8i8)(const uint8_t* a, const int8_t* b, size_t n) = nullptr;
+	};
+
+	/**
+	* Resolved byte-level bulk primitives behind Memory.h, one per tier like KernelTable. No alignment is required anywhere.
+	* copy is for non-overlapping ranges. fill repeats the size byte pattern at value over bytes, size being a power of
+	* two of at most 64 that divides bytes. mismatch returns the offset of the first differing byte (bytes if there is none).
+	* @note stream_copy/stream_fill write dest with non-temporal stores, see StoreMode.
+	*/
+	struct MemoryTable {
+		void (*copy)(void* dest, const void* src, size_t bytes) = nullptr;
+		void (*fill)(void* dest, const void* value, size_t size, size_t bytes) = nullptr;
+		size_t (*mismatch)(const void* a, const void* b, size_t bytes) = nullptr;
+		bool (*is_zero)(const void* src, size_t bytes) = nullptr;
+		void (*stream_copy)(void* dest, const void* src, size_t bytes) = nullptr;
+		void (*stream_fill)(void* dest, const void* value, size_t size, size_t bytes) = nullptr;
+	};
+
+	/**
+	* Runtime CPU dispatch for the Intrinsics kernels.
+	* init() reads CPUID once, picks the widest tier the host (and OS) supports and binds every KernelTable to it.
+	* Setting DEVSW_SIMD_TIER=scalar|sse42|avx2|avx512 in the environment forces a narrower tier for A/B runs;
+	* asking for a tier the host cannot execute is clamped to the detected one instead of dying with SIGILL.
+	* The streaming threshold defaults to the last-level cache size, DEVSW_STREAMING_THRESHOLD=<bytes> overrides it.
+	* @note kernels() initializes lazily, so calling Init() up front only moves the CPUID cost out of the first kernel call.
+	*/
+	struct devswSTL Dispatch {
+		static void init();
+
+		static const CpuFeatures& features();
+		static SimdTier detected_tier();
+		static SimdTier active_tier();
+
+		// Rebinds every table, clamped to detected_tier(). Not meant to race with running kernels.
+		static void set_tier(SimdTier tier);
+		static const char* tier_name(SimdTier tier);
+
+		template <typename T>
+		static const KernelTable<T>& kernels();
+		static const ConvertTable& conversions();
+		static const MemoryTable& memory();
+
+		// Destination size in bytes from which StoreMode::Auto streams
+		static size_t streaming_threshold();
+		static void set_streaming_threshold(size_t bytes);
+
+		// Auto never streams less than this, a handful of cache lines is cheaper through the cache whatever the threshold
+		static constexpr size_t MIN_STREAMING_BYTES = 64 * 1024;
+
+		static bool streams(StoreMode mode, size_t bytes) {
+			if (mode == StoreMode::Auto) return bytes >= MIN_STREAMING_BYTES && bytes >= streaming_threshold();
+			return mode == StoreMode::Streaming;
+		}
+	};
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "AlignedVector.h"
+
+namespace devsw::stl {
+	/**
+	* Lazy arithmetic over AlignedVector. The operators below only build a compile-time tree; assigning the tree to an
+	* AlignedVector evaluates it in one pass, loading every operand and storing the destination once per lane:
+	*     dest = a * b + c - d;
+	* A multiply feeding an add or subtract is lowered to fmadd/fmsub/fnmadd. Nodes hold data pointers and scalars by
+	* value, so a tree never dangles into a temporary and never allocates one.
+	* @note The tree type is only known to the translation unit that spells it, so it is evaluated with Simd<T>, the
+	* widest tier that unit is compiled for, rather than the runtime Dispatch tier. Build hot paths with -mavx2 or better.
+	*/
+	template <typename Derived, typename T>
+	struct VectorExpression {
+		using value_type = T;
+		static constexpr bool is_vector_expression = true;
+
+		const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+		// dest[0, size()) = *this. dest and every leaf are AlignedVector storage, whose capacity is whole cache lines, so
+		// the last vector runs into the padding instead of needing a tail. stream writes dest with non-temporal stores
+		template <typename S>
+		void evaluate(T* dest, bool stream = false) const {
+			size_t padded = (self().size() + S::lanes - 1) & ~(S::lanes - 1);
+			if (stream) {
+				for (size_t i = 0; i < padded; i += S::lanes)
+					S::stream(dest + i, self().template eval<S>(i));
+				S::fence();
+			}
+			else {
+				for (size_t i = 0; i < padded; i += S::lanes)
+					S::storeu(dest + i, self().template eval<S>(i));
+			}
+		}
+	};
+
+	template <typename T>
+	class VectorTerm : public VectorExpression<VectorTerm<T>, T> {
+	public:
+		explicit VectorTerm(const AlignedVector<T>& vector) : data_(vector.begin()), size_(vector.get_size()) {}
+
+		size_t size() const { return size_; }
+
+		template <typename S>
+		FORCEINLINE typename S::reg eval(size_t i) const { return S::loadu(data_ + i); }
+
+	private:
+		const T* data_;
+		size_t size_;
+	};
+
+	// Broadcast scalar, size() is 0 so it adopts the size of whatever it is combined with
+	template <typename T>
+	class ScalarTerm : public VectorExpression<ScalarTerm<T>, T> {
+	public:
+		explicit ScalarTerm(T value) : value_(value) {}
+
+		size_t size() const { return 0; }
+
+		template <typename S>
+		FORCEINLINE typename S::reg eval(size_t) const { return S::set1(value_); }
+
+	private:
+		T value_;
+	};
+
+	template <typename L, typename R, typename Op>
+	class BinaryExpression : public VectorExpression<BinaryExpression<L, R, Op>, typename L::value_type> {
+		static_assert(is_same_v<typename L::value_type, typename R::value_type>, "Expression operands must share an element type");
+
+	public:
+		BinaryExpression(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+			if (lhs_.size() && rhs_.size() && lhs_.size() != rhs_.size()) {
+				//TODO Errors...
+			}
+		}
+
+		size_t size() const { return lhs_.size() ? lhs_.size() : rhs_.size(); }
+		const L& lhs() const { return lhs_; }
+		const R& rhs() const { return rhs_; }
+
+		template <typename S>
+		FORCEINLINE typename S::reg eval(size_t i) const {
+			if constexpr (is_same_v<Op, SimdAdd> && is_product_v<L>)
+				return S::fmadd(lhs_.lhs().template eval<S>(i), lhs_.rhs().template eval<S>(i), rhs_.template eval<S>(i));
+			else if constexpr (is_same_v<Op, SimdAdd> && is_product_v<R>)
+				return S::fmadd(rhs_.lhs().template eval<S>(i), rhs_.rhs().template eval<S>(i), lhs_.template eval<S>(i));
+			else if constexpr (is_same_v<Op, SimdSub> && is_product_v<L>)
+				return S::fmsub(lhs_.lhs().template eval<S>(i), lhs_.rhs().template eval<S>(i), rhs_.template eval<S>(i));
+			else if constexpr (is_same_v<Op, SimdSub> && is_product_v<R>)
+				return S::fnmadd(rhs_.lhs().template eval<S>(i), rhs_.rhs().template eval<S>(i), lhs_.template eval<S>(i));
+			else
+				return Op::template apply<S>(lhs_.template eval<S>(i), rhs_.template eval<S>(i));
+		}
+
+	private:
+		template <typename E> struct is_product : FalseType {};
+		template <typename A, typename B> struct is_product<BinaryExpression<A, B, SimdMul>> : TrueType {};
+		template <typename E> static constexpr bool is_product_v = is_product<E>::value;
+
+		L lhs_;
+		R rhs_;
+	};
+
+	namespace expression {
+		template <typename E>
+		concept Expression = requires { E::is_vector_expression; };
+
+		template <typename X> struct is_vector : FalseType {};
+		template <typename T> struct is_vector<AlignedVector<T>> : TrueType {};
+
+		template <typename X>
+		concept Operand = Expression<X> || is_vector<X>::value;
+
+		template <typename X> struct element { using type = typename X::value_type; };
+		template <typename T> struct element<AlignedVector<T>> { using type = T; };
+
+		template <typename T> VectorTerm<T> as_term(const AlignedVector<T>& vector) { return VectorTerm<T>(vector); }
+		template <Expression E> const E& as_term(const E& expr) { return expr; }
+
+		// Node type an operand is stored as, by value
+		template <typename X> using term_t = std::remove_cvref_t<decltype(as_term(std::declval<const X&>()))>;
+
+		// At least one side is a vector or expression, the other may be a plain number that gets broadcast
+		template <typename Op, typename A, typename B>
+		auto combine(const A& a, const B& b) {
+			if constexpr (!Operand<A>) {
+				using T = typename element<B>::type;
+				return BinaryExpression<ScalarTerm<T>, term_t<B>, Op>(ScalarTerm<T>(static_cast<T>(a)), as_term(b));
+			}
+			else if constexpr (!Operand<B>) {
+				using T = typename element<A>::type;
+				return BinaryExpression<term_t<A>, ScalarTerm<T>, Op>(as_term(a), ScalarTerm<T>(static_cast<T>(b)));
+			}
+			else {
+				return BinaryExpression<term_t<A>, term_t<B>, Op>(as_term(a), as_term(b));
+			}
+		}
+
+		template <typename A, typename B>
+		concept Operands = (Operand<A> && Operand<B>) || (Operand<A> && is_numeric_v<B>) || (is_numeric_v<A> && Operand<B>);
+	}
+
+	template <typename A, typename B> requires expression::Operands<A, B>
+	auto operator+(const A& a, const B& b) { return expression::combine<SimdAdd>(a, b); }
+
+	template <typename A, typename B> requires expression::Operands<A, B>
+	auto operator-(const A& a, const B& b) { return expression::combine<SimdSub>(a, b); }
+
+	template <typename A, typename B> requires expression::Operands<A, B>
+	auto operator*(const A& a, const B& b) { return expression::combine<SimdMul>(a, b); }
+
+	template <typename A, typename B> requires expression::Operands<A, B>
+	auto operator/(const A& a, const B& b) {
+		auto expr = expression::combine<SimdDiv>(a, b);
+		static_assert(is_floating_point_v<typename decltype(expr)::value_type>, "Vector division is floating point only");
+		return expr;
+	}
+}
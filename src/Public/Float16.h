@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <bit>
+
+#include "devswSTL.h"
+
+namespace devsw::stl {
+	/**
+	* 16-bit floating point storage types. Neither does arithmetic; they let an AlignedVector hold half-size data that
+	* Intrinsics::convert widens to float and narrows back with the F16C/AVX-512 conversion instructions.
+	* float16 is IEEE 754 binary16 (5-bit exponent, 10-bit mantissa, max 65504), bfloat16 is the top half of a float
+	* (same 8-bit exponent, 7-bit mantissa). Narrowing rounds to nearest even, overflow goes to infinity, NaN stays NaN.
+	* @note The scalar conversions below are what the scalar and SSE4.2 tiers use, and match the hardware bit for bit.
+	*/
+	struct float16 {
+		uint16_t bits;
+
+		constexpr float16() : bits(0) {}
+		explicit float16(float value) : bits(from_float(value)) {}
+		explicit operator float() const { return to_float(bits); }
+		static constexpr float16 from_bits(uint16_t value) { float16 h; h.bits = value; return h; }
+
+		static uint16_t from_float(float value) {
+			uint32_t x = std::bit_cast<uint32_t>(value);
+			uint32_t sign = (x >> 16) & 0x8000;
+			uint32_t abs = x & 0x7FFFFFFF;
+			if (abs >= 0x47800000) { // 2^16 and up, infinity or NaN. Everything from 65520 rounds up to infinity below
+				if (abs > 0x7F800000) return static_cast<uint16_t>(sign | 0x7E00 | ((abs >> 13) & 0x3FF)); // Quieted, payload kept
+				return static_cast<uint16_t>(sign | 0x7C00);
+			}
+			if (abs < 0x38800000) { // Below 2^-14, subnormal: adding 0.5 lines the half ulp (2^-24) up with the float ulp
+				float shifted = std::bit_cast<float>(abs) + 0.5f;
+				return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(shifted) - 0x3F000000));
+			}
+			// Rebias the exponent (127 - 15) and round the 13 dropped bits to nearest even
+			abs += 0xC8000FFF + ((abs >> 13) & 1);
+			return static_cast<uint16_t>(sign | (abs >> 13));
+		}
+		static float to_float(uint16_t value) {
+			uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+			uint32_t abs = value & 0x7FFF;
+			if (abs >= 0x7C00) return std::bit_cast<float>(sign | 0x7F800000 | ((abs & 0x3FF) << 13));
+			if (abs < 0x0400) {
+				float magnitude = static_cast<float>(abs) * 5.9604644775390625e-8f; // 2^-24, exact
+				return sign ? -magnitude : magnitude;
+			}
+			return std::bit_cast<float>(sign | ((abs << 13) + 0x38000000));
+		}
+	};
+
+	struct bfloat16 {
+		uint16_t bits;
+
+		constexpr bfloat16() : bits(0) {}
+		explicit bfloat16(float value) : bits(from_float(value)) {}
+		explicit operator float() const { return to_float(bits); }
+		static constexpr bfloat16 from_bits(uint16_t value) { bfloat16 b; b.bits = value; return b; }
+
+		static uint16_t from_float(float value) {
+			uint32_t x = std::bit_cast<uint32_t>(value);
+			if ((x & 0x7FFFFFFF) > 0x7F800000) return static_cast<uint16_t>((x >> 16) | 0x40);
+			return static_cast<uint16_t>((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+		}
+		static float to_float(uint16_t value) { return std::bit_cast<float>(static_cast<uint32_t>(value) << 16); }
+	};
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "devswSTL.h"
+#include "AllocatorStats.h"
+#include "Traits.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace devsw::stl {
+	/**
+	* Byte-oriented frame arena for per-request scratch memory, the type-erased counterpart of StackAllocator.
+	* - Allocation is a pointer bump in the current block. A request that does not fit moves on to the next block of
+	*   the chain, which is a new one (at least the request's size) only the first time the arena gets that deep.
+	* - get_marker/rewind (or an ArenaScope) free everything allocated since the marker in one step. Blocks are kept
+	*   and reused by the next frame, so a server in steady state allocates from the system never again. trim() frees
+	*   the blocks past the current one.
+	* - create/create_array construct objects and register their destructors when they have one: rewinding past them
+	*   destroys them, most recent first. alloc<T> is raw, correctly aligned storage that nobody destroys.
+	* @note Not synchronized: one arena per thread or per request.
+	*/
+	class devswSTL FrameArena {
+		struct Block {
+			Block* next;
+			size_t size; // Bytes, header included
+		};
+
+		struct Finalizer {
+			void (*destroy)(void* objects, size_t count);
+			void* objects;
+			size_t count;
+			Finalizer* previous;
+		};
+
+	public:
+		static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+		static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+		// Everything needed to come back to one point of the arena
+		struct Marker {
+			Block* block;
+			uintptr_t top;
+			Finalizer* finalizers;
+			size_t used;
+		};
+
+		explicit FrameArena(size_t block_size = DEFAULT_BLOCK_SIZE);
+		// Runs the destructors still registered
+		~FrameArena();
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		// bytes of storage aligned to alignment (a power of two). Throws std::bad_alloc only when the system is out of memory
+		void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+			uintptr_t start = (top_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+			if (start < top_ || start > end_ || bytes > end_ - start) return grow(bytes, alignment); // No sums that could wrap
+			top_ = start + bytes;
+			used_ += bytes;
+			stats_.on_allocate(bytes, DEVSW_ALLOCATION_SITE());
+			return reinterpret_cast<void*>(start);
+		}
+
+		// Uninitialized storage for n T
+		template <typename T>
+		T* alloc(size_t n = 1) {
+			if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+			return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+		}
+
+		// One T, destroyed when the arena is rewound past it
+		template <typename T, typename... Args>
+		T* create(Args&&... args) {
+			if constexpr (is_trivially_destructible_v<T>) {
+				return ::new (alloc<T>()) T(std::forward<Args>(args)...);
+			}
+			else {
+				Finalizer* finalizer = alloc<Finalizer>(); // First, so a registered object never lacks its record
+				T* object = ::new (alloc<T>()) T(std::forward<Args>(args)...);
+				push(finalizer, &destroy_objects<T>, object, 1);
+				return object;
+			}
+		}
+
+		// n value-initialized T, destroyed when the arena is rewound past them
+		template <typename T>
+		T* create_array(size_t n) {
+			Finalizer* finalizer = is_trivially_destructible_v<T> ? nullptr : alloc<Finalizer>();
+			T* objects = alloc<T>(n);
+			size_t built = 0;
+			try {
+				for (; built < n; ++built) ::new (objects + built) T();
+			}
+			catch (...) {
+				destroy_objects<T>(objects, built);
+				throw;
+			}
+			if (finalizer) push(finalizer, &destroy_objects<T>, objects, n);
+			return objects;
+		}
+
+		Marker get_marker() const { return { current_, top_, finalizers_, used_ }; }
+		// Destroys what was created since marker, newest first, and makes its memory available again
+		void rewind(const Marker& marker);
+		void reset() { rewind({ head_, first_top(head_), nullptr, 0 }); }
+		// Frees the blocks past the current one
+		void trim();
+
+		// Bytes handed out since the arena was last reset, padding excluded
+		size_t bytes_used() const { return used_; }
+		// Blocks are the chunks. Empty unless built with DEVSW_ALLOCATOR_STATS
+		AllocatorSnapshot stats() const { return stats_.snapshot(); }
+
+	private:
+		template <typename T>
+		static void destroy_objects(void* objects, size_t count) {
+			T* typed = static_cast<T*>(objects);
+			while (count) typed[--count].~T();
+		}
+
+		static uintptr_t first_top(Block* block) { return reinterpret_cast<uintptr_t>(block) + sizeof(Block); }
+
+		void push(Finalizer* finalizer, void (*destroy)(void*, size_t), void* objects, size_t count) {
+			*finalizer = { destroy, objects, count, finalizers_ };
+			finalizers_ = finalizer;
+		}
+
+		void* grow(size_t bytes, size_t alignment);
+		void enter(Block* block);
+
+		size_t block_size_;
+		Block* head_;
+		Block* current_;
+		uintptr_t top_;
+		uintptr_t end_;
+		Finalizer* finalizers_;
+		size_t used_;
+		AllocatorStats stats_;
+	};
+
+	/**
+	* Rewinds an arena to where it was when the scope was entered: a FrameArena, or a StackAllocator (anything with
+	* get_marker/rewind). Scopes nest like the frames they guard.
+	*   ArenaScope scope(arena);
+	*   Parsed* parsed = arena.create<Parsed>(request);
+	*/
+	template <typename A>
+	class ArenaScope {
+	public:
+		explicit ArenaScope(A& arena) : arena_(arena), marker_(arena.get_marker()) {}
+		~ArenaScope() { arena_.rewind(marker_); }
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+		A& arena() const { return arena_; }
+
+	private:
+		A& arena_;
+		decltype(std::declval<A&>().get_marker()) marker_;
+	};
+}
@@ -0,0 +1,243 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "Float16.h"
+#include "AlignedVector.h"
+
+namespace devsw::stl {
+	// How a MappedVector sees its file
+	enum class MapMode : uint8_t {
+		ReadOnly,    // Shared read-only pages, writing through the vector faults
+		ReadWrite,   // Shared writable pages, stores reach the file (flush() to force them out)
+		CopyOnWrite  // Private pages, stores stay in this process and the file is never modified
+	};
+
+	// Access pattern hints for the kernel, madvise on POSIX. Hints only: ignored where the platform has no equivalent
+	enum class MapAdvice : uint8_t {
+		Normal,
+		Sequential, // Aggressive readahead, pages behind the reader may be dropped early
+		Random,     // No readahead
+		WillNeed,   // Start reading the range in now
+		HugePage,   // Back the range with transparent huge pages where the filesystem supports it
+		DontNeed    // Done with the range, its clean pages can go. CopyOnWrite changes in it are lost
+	};
+
+	/**
+	* A whole file mapped into memory, the platform half of MappedVector (mmap on POSIX, file mappings on Windows).
+	* Movable, not copyable. The mapping starts on a page boundary.
+	*/
+	class devswSTL MappedFile {
+	public:
+		MappedFile() : data_(nullptr), size_(0), mode_(MapMode::ReadOnly), handle_(nullptr) {}
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile() { close(); }
+
+		// Maps an existing file, false if it cannot be opened or is empty
+		bool open(const char* path, MapMode mode);
+		// Creates (or truncates) path to bytes zero bytes and maps it ReadWrite. The file is sparse until written
+		bool create(const char* path, size_t bytes);
+		void close();
+
+		// Hint for [offset, offset + length), clamped to the mapping and widened to whole pages
+		void advise(MapAdvice advice, size_t offset = 0, size_t length = SIZE_MAX) const;
+		// Writes dirty pages back to the file and waits for them, a no-op unless ReadWrite
+		void flush() const;
+
+		char* data() const { return data_; }
+		size_t size() const { return size_; }
+		MapMode mode() const { return mode_; }
+		bool is_open() const { return data_ != nullptr; }
+
+	private:
+		char* data_;
+		size_t size_;
+		MapMode mode_;
+		void* handle_; // File handle on Windows, kept for flush(). Unused on POSIX
+	};
+
+	/**
+	* First cache line of a MappedVector file. The elements follow it, so they start 64 bytes into a page-aligned
+	* mapping and are as aligned as AlignedVector storage. The file is padded to a whole cache line, owned, initialized
+	* bytes that start out as zeros but take kernel results when a ReadWrite mapping is an operand.
+	*/
+	struct MappedHeader {
+		static constexpr char MAGIC[8] = { 'D', 'E', 'V', 'S', 'W', 'V', 'E', 'C' };
+		static constexpr uint32_t VERSION = 1;
+
+		char magic[8];
+		uint32_t version;
+		uint32_t element_type; // Kind in the high byte ('f', 'i', 'u', 'h' float16, 'b' bfloat16), size in bytes below
+		uint64_t size;         // Elements
+		uint8_t reserved[40];
+
+		template <typename T>
+		static constexpr uint32_t type_of() {
+			uint32_t kind = 'u';
+			if constexpr (is_same_v<T, float16>) kind = 'h';
+			else if constexpr (is_same_v<T, bfloat16>) kind = 'b';
+			else if constexpr (is_floating_point_v<T>) kind = 'f';
+			else if constexpr (is_signed_v<T>) kind = 'i';
+			return (kind << 8) | static_cast<uint32_t>(sizeof(T));
+		}
+	};
+	static_assert(sizeof(MappedHeader) == 64, "The elements must start on a cache line");
+
+	/**
+	* File-backed sibling of AlignedVector for data sets larger than RAM (or than one wants to read at startup).
+	* Opening maps the file instead of reading it, so pages are faulted in as the kernels reach them and the page cache
+	* is the only copy. Same begin()/end()/operator[]/aligned_size() interface, and an operand to every Intrinsics op.
+	* MappedVector<T>::create makes a new file of n zero elements to fill in place, save writes out an AlignedVector.
+	* @note The size is fixed by the file, resize only moves within it (and records the new size in the header when
+	* ReadWrite). Writing to a ReadOnly mapping is a segmentation fault, not an error code.
+	*/
+	template <typename T>
+	class MappedVector {
+		static_assert(is_numeric_v<T> || is_half_float_v<T>, "MappedVector only supports floating point, integer and 16-bit float storage types");
+
+	public:
+		MappedVector() : data_(nullptr), size_(0), capacity_(0) {}
+		explicit MappedVector(const char* path, MapMode mode = MapMode::ReadOnly, MapAdvice advice = MapAdvice::Normal)
+			: data_(nullptr), size_(0), capacity_(0) {
+			if (!open(path, mode, advice)) {
+				//TODO Errors...
+			}
+		}
+
+		MappedVector(MappedVector&& other) noexcept
+			: file_(static_cast<MappedFile&&>(other.file_)), data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+			other.data_ = nullptr;
+			other.size_ = 0;
+			other.capacity_ = 0;
+		}
+		MappedVector& operator=(MappedVector&& other) noexcept {
+			if (this != &other) {
+				file_ = static_cast<MappedFile&&>(other.file_);
+				data_ = other.data_;
+				size_ = other.size_;
+				capacity_ = other.capacity_;
+				other.data_ = nullptr;
+				other.size_ = 0;
+				other.capacity_ = 0;
+			}
+			return *this;
+		}
+		MappedVector(const MappedVector&) = delete;
+		MappedVector& operator=(const MappedVector&) = delete;
+
+		// Maps path, false (and empty) if it is missing, truncated or holds another element type
+		bool open(const char* path, MapMode mode = MapMode::ReadOnly, MapAdvice advice = MapAdvice::Normal) {
+			close();
+			if (!file_.open(path, mode)) return false;
+			if (!attach()) {
+				file_.close();
+				return false;
+			}
+			if (advice != MapAdvice::Normal) file_.advise(advice);
+			return true;
+		}
+
+		// New file of n zero elements, mapped ReadWrite
+		static MappedVector create(const char* path, size_t n) {
+			MappedVector vector;
+			if (!vector.file_.create(path, file_size(n))) {
+				//TODO Errors...
+				return vector;
+			}
+			MappedHeader* header = reinterpret_cast<MappedHeader*>(vector.file_.data());
+			memcpy(header->magic, MappedHeader::MAGIC, sizeof(header->magic));
+			header->version = MappedHeader::VERSION;
+			header->element_type = MappedHeader::type_of<T>();
+			header->size = n;
+			vector.attach();
+			return vector;
+		}
+
+		// Writes src to path in the MappedVector format, false if the file could not be created
+		static bool save(const char* path, const AlignedVector<T>& src) {
+			MappedVector vector = create(path, src.get_size());
+			if (!vector.is_open()) return false;
+			if (src.get_size()) memcpy(vector.begin(), src.begin(), src.get_size() * sizeof(T));
+			vector.flush();
+			return true;
+		}
+
+		void close() {
+			file_.close();
+			data_ = nullptr;
+			size_ = 0;
+			capacity_ = 0;
+		}
+
+		// Accessors
+		T* begin() { return data_; }
+		const T* begin() const { return data_; }
+		T* end() { return data_ + size_; }
+		const T* end() const { return data_ + size_; }
+		size_t get_size() const { return size_; }
+		size_t get_capacity() const { return capacity_; }
+		MapMode get_mode() const { return file_.mode(); }
+		bool is_open() const { return file_.is_open(); }
+
+		// Element access
+		T& operator[](size_t i) { return data_[i]; }
+		const T& operator[](size_t i) const { return data_[i]; }
+
+		// Same contract as AlignedVector, the file holds the padding up to here
+		size_t aligned_size() const {
+			return (size_ + avx512_lanes_v<T> -1) & ~(avx512_lanes_v<T> -1);
+		}
+
+		// Elements [begin, begin + count) are about to be read in order, needed soon, no longer needed...
+		void advise(MapAdvice advice, size_t begin = 0, size_t count = SIZE_MAX) const {
+			size_t offset = sizeof(MappedHeader) + begin * sizeof(T);
+			file_.advise(advice, offset, count > (SIZE_MAX - offset) / sizeof(T) ? SIZE_MAX : count * sizeof(T));
+		}
+
+		void flush() const { file_.flush(); }
+
+		// Within the file only. Growing zeroes the new elements, as AlignedVector::resize would with its default value
+		void resize(size_t new_size) {
+			if (new_size > capacity_) {
+				//TODO Errors...
+				return;
+			}
+			if (get_mode() == MapMode::ReadOnly) {
+				//TODO Errors...
+				return;
+			}
+			if (new_size > size_) memset(data_ + size_, 0, (new_size - size_) * sizeof(T));
+			size_ = new_size;
+			if (get_mode() == MapMode::ReadWrite) reinterpret_cast<MappedHeader*>(file_.data())->size = new_size;
+		}
+
+	private:
+		// Header, elements, then padding to a whole cache line
+		static size_t file_size(size_t n) {
+			return sizeof(MappedHeader) + ((n * sizeof(T) + sizeof(MappedHeader) - 1) & ~(sizeof(MappedHeader) - 1));
+		}
+
+		bool attach() {
+			if (file_.size() < sizeof(MappedHeader)) return false;
+			const MappedHeader* header = reinterpret_cast<const MappedHeader*>(file_.data());
+			if (memcmp(header->magic, MappedHeader::MAGIC, sizeof(header->magic)) != 0 || header->version != MappedHeader::VERSION
+				|| header->element_type != MappedHeader::type_of<T>()) return false;
+			if (header->size > (file_.size() - sizeof(MappedHeader)) / sizeof(T) || file_size(header->size) > file_.size()) return false;
+			data_ = reinterpret_cast<T*>(file_.data() + sizeof(MappedHeader));
+			size_ = header->size;
+			capacity_ = ((file_.size() - sizeof(MappedHeader)) & ~(sizeof(MappedHeader) - 1)) / sizeof(T); // Padding included
+			return true;
+		}
+
+		MappedFile file_;
+		T* data_;
+		size_t size_;
+		size_t capacity_;
+	};
+}
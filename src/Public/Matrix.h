@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "AlignedVector.h"
+
+namespace devsw::stl {
+	/**
+	* Dense row-major matrix over AlignedVector storage, the operand type of Intrinsics::gemm and Intrinsics::gemv.
+	* Rows start on a cache line: the stride (elements between row starts) is cols rounded up to 64 bytes, plus one
+	* more line when that would be a multiple of 4 KiB, so walking down a column does not keep hitting the same L1 set.
+	* @note The padding at the end of each row is owned storage but not part of the matrix, kernels never read it.
+	*/
+	template <typename T>
+	class devswSTL Matrix {
+		static_assert(is_numeric_v<T>, "Matrix only supports floating point and integer types");
+
+	public:
+		Matrix() : rows_(0), cols_(0), stride_(0) {}
+		Matrix(size_t rows, size_t cols, T value = T()) : rows_(rows), cols_(cols), stride_(padded_stride(cols)), data_(rows * padded_stride(cols), value) {}
+
+		// Accessors
+		size_t get_rows() const { return rows_; }
+		size_t get_cols() const { return cols_; }
+		size_t get_stride() const { return stride_; }
+		T* data() { return data_.begin(); }
+		const T* data() const { return data_.begin(); }
+		T* row(size_t r) { return data_.begin() + r * stride_; }
+		const T* row(size_t r) const { return data_.begin() + r * stride_; }
+
+		// Element access, at() checks both indices
+		T& operator()(size_t r, size_t c) { return data_[r * stride_ + c]; } // No bounds, same deal as AlignedVector
+		const T& operator()(size_t r, size_t c) const { return data_[r * stride_ + c]; }
+		T& at(size_t r, size_t c) {
+			if (r >= rows_ || c >= cols_) throw std::out_of_range("Matrix::at");
+			return data_[r * stride_ + c];
+		}
+		const T& at(size_t r, size_t c) const {
+			if (r >= rows_ || c >= cols_) throw std::out_of_range("Matrix::at");
+			return data_[r * stride_ + c];
+		}
+
+		// Modifiers
+		void fill(T value) {
+			for (size_t r = 0; r < rows_; ++r) {
+				T* line = row(r);
+				for (size_t c = 0; c < cols_; ++c) line[c] = value;
+			}
+		}
+
+	private:
+		static constexpr size_t LINE_ELEMENTS = 64 / sizeof(T);
+		static constexpr size_t PAGE_ELEMENTS = 4096 / sizeof(T);
+
+		static size_t padded_stride(size_t cols) {
+			size_t stride = (cols + LINE_ELEMENTS - 1) & ~(LINE_ELEMENTS - 1);
+			if (stride >= PAGE_ELEMENTS && stride % PAGE_ELEMENTS == 0) stride += LINE_ELEMENTS;
+			return stride;
+		}
+
+		size_t rows_;
+		size_t cols_;
+		size_t stride_;
+		AlignedVector<T> data_;
+	};
+}
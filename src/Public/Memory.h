@@ -1,11 +1,22 @@
 #pragma once
 
 #include "devswSTL.h"
+#include "Dispatch.h"
 #include <new>
 #include <memory>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace devsw::stl {
+	// Smallest trivially copyable ranges, in bytes, that fill_range/compare_range/is_all_zero hand to the
+	// Dispatch::memory() kernels. Below them the inline loop wins over an indirect call. From the 8 B - 1 GB sweep of
+	// bench/MemoryCrossover on AVX-512 with ERMS, rerun it to re-derive them elsewhere. copy_range has no threshold: the
+	// copy kernel is only level with memcpy there, so it keeps memcpy unless it streams
+	constexpr size_t SIMD_FILL_BYTES = 64;     // Kernel ahead of the store loop from 64 B, behind it below
+	constexpr size_t SIMD_COMPARE_BYTES = 16;  // Kernel ahead of the == loop from 16 B
+	constexpr size_t SIMD_ZERO_BYTES = 32;     // Kernel ahead of the word-or loop from 32 B
+
 	template<typename T>
 	constexpr void static_assert_valid_type() {
 		static_assert(!std::is_abstract_v<T>, "Cannot construct abstract type.");
@@ -62,6 +73,70 @@ namespace devsw::stl {
 #endif
 	}
 
+	// Huge page use of Pages::map. DEVSW_HUGE_PAGES=off|transparent|explicit sets it at startup
+	enum class HugePages : uint8_t {
+		Off,         // Base pages only
+		Transparent, // madvise(MADV_HUGEPAGE), the kernel backs the range with huge pages where it can (default)
+		Explicit     // MAP_HUGETLB from the reserved pool, Transparent when the pool cannot cover the request
+	};
+
+	/**
+	* Whole pages straight from the OS, for buffers large enough that growing them on the heap would mean a second copy
+	* and twice the peak memory. Mappings come zeroed and page aligned, and remap grows or shrinks one by moving page
+	* table entries instead of bytes (mremap, Linux only).
+	* @note Lengths passed back to remap/unmap must be the ones map/remap were given, already rounded by Pages::round.
+	*/
+	struct devswSTL Pages {
+		// Buffers from here up are worth a mapping of their own
+		static constexpr size_t MAP_THRESHOLD = 2 * 1024 * 1024;
+		static constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+		static size_t page_size();
+		static HugePages huge_pages();
+		static void set_huge_pages(HugePages policy);
+
+		// bytes up to whole pages, whole huge pages unless HugePages::Off
+		static size_t round(size_t bytes);
+		// nullptr when the OS refuses
+		static void* map(size_t bytes);
+		// Same, at a multiple of alignment (a power of two) so that masking any address inside finds the start.
+		// bytes must be a multiple of page_size()
+		static void* map_aligned(size_t bytes, size_t alignment);
+		// nullptr when the mapping cannot change size without a copy, ptr is then still mapped with old_bytes
+		static void* remap(void* ptr, size_t old_bytes, size_t new_bytes);
+		static void unmap(void* ptr, size_t bytes);
+	};
+
+	/**
+	* NUMA placement of page mappings, through the mbind/set_mempolicy/getcpu system calls directly (no libnuma), or
+	* VirtualAllocExNuma on Windows where only map places.
+	* A node is 0 to node_count() - 1, or ANY (no policy: the first thread to touch a page gets it on its node) or
+	* INTERLEAVE (pages round-robin over every node, for buffers all sockets read).
+	* @note Without NUMA (one node, not Linux, or the calls refused as in some containers) there is one node 0 and
+	* binding is a no-op that returns false, so callers never need a second code path.
+	*/
+	struct devswSTL Numa {
+		static constexpr int ANY = -1;
+		static constexpr int INTERLEAVE = -2;
+
+		static int node_count();
+		// Node of the CPU the calling thread is running on right now, 0 without NUMA
+		static int current_node();
+
+		// Pages of [ptr, ptr + bytes) not yet touched will be allocated on node, ptr page aligned. Preferred rather than
+		// strict: a full node spills over instead of failing the fault. False if not applied
+		static bool place(void* ptr, size_t bytes, int node);
+		// Default policy for the calling thread's new pages: prefer node, or INTERLEAVE, or ANY to go back to first touch
+		static bool prefer(int node);
+		// Pages::map placed on node
+		static void* map(size_t bytes, int node);
+	};
+
+	// Where an AlignedVector (or an arena chunk) keeps its pages, see Numa
+	struct NumaPlacement {
+		int node = Numa::ANY;
+	};
+
 	template<typename T>
 	inline void devswSTL construct(void* p, T&& value) {
 		static_assert_valid_type<T>();
@@ -119,13 +194,32 @@ namespace devsw::stl {
 		}
 	}
 
+	// Trivially copyable ranges past Dispatch::streaming_threshold() (or any size with StoreMode::Streaming) are written
+	// with non-temporal stores, so filling or copying a buffer larger than the cache does not flush everything else out.
+	// Below that, elements of 1 to 64 bytes (powers of two) are filled a whole register at a time
+	template<typename T>
+	inline void devswSTL fill_range(T* dest, size_t count, const T& value, StoreMode mode = StoreMode::Auto) {
+		if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) & (sizeof(T) - 1)) == 0 && sizeof(T) <= 64) {
+			size_t bytes = count * sizeof(T);
+			if (Dispatch::streams(mode, bytes)) {
+				Dispatch::memory().stream_fill(dest, &value, sizeof(T), bytes);
+				return;
+			}
+			if (bytes >= SIMD_FILL_BYTES) {
+				Dispatch::memory().fill(dest, &value, sizeof(T), bytes);
+				return;
+			}
+		}
+		for (size_t i = 0; i < count; ++i) {
+			dest[i] = value;
+		}
+	}
+
 	template<typename T>
 	inline void devswSTL uninitialized_fill_range(T* dest, size_t count, const T& value) {
 		static_assert_valid_type<T>();
 		if constexpr (std::is_trivially_copyable_v<T>) {
-			for (size_t i = 0; i < count; ++i) {
-				dest[i] = value;
-			}
+			fill_range(dest, count, value);
 		}
 		else {
 			size_t i = 0;
@@ -227,17 +321,13 @@ namespace devsw::stl {
 		}
 	}
 
+	// dest and src may not overlap, see move_range. Trivially copyable ranges are a memcpy, or stream like fill_range
 	template<typename T>
-	inline void devswSTL fill_range(T* dest, size_t count, const T& value) {
-		for (size_t i = 0; i < count; ++i) {
-			dest[i] = value;
-		}
-	}
-
-	template<typename T>
-	inline void devswSTL copy_range(T* dest, const T* src, size_t count) {
+	inline void devswSTL copy_range(T* dest, const T* src, size_t count, StoreMode mode = StoreMode::Auto) {
 		if constexpr (std::is_trivially_copyable_v<T>) {
-			memcpy(dest, src, count * sizeof(T));
+			size_t bytes = count * sizeof(T);
+			if (Dispatch::streams(mode, bytes)) Dispatch::memory().stream_copy(dest, src, bytes);
+			else memcpy(dest, src, bytes);
 		}
 		else {
 			for (size_t i = 0; i < count; ++i) {
@@ -246,6 +336,42 @@ namespace devsw::stl {
 		}
 	}
 
+	// Index of the first element where a and b differ, count if none does. Types whose equal values are equal bytes
+	// (integers, pointers, enums, structs without padding) are compared bytewise with SIMD, anything else with ==
+	template<typename T>
+	inline size_t devswSTL compare_range(const T* a, const T* b, size_t count) {
+		if constexpr (std::has_unique_object_representations_v<T>) {
+			if (count * sizeof(T) >= SIMD_COMPARE_BYTES) return Dispatch::memory().mismatch(a, b, count * sizeof(T)) / sizeof(T);
+		}
+		for (size_t i = 0; i < count; ++i) {
+			if (!(a[i] == b[i])) return i;
+		}
+		return count;
+	}
+
+	template<typename T>
+	inline bool devswSTL equal_range(const T* a, const T* b, size_t count) {
+		return compare_range(a, b, count) == count;
+	}
+
+	// Whether every byte of the range is zero. Note that -0.0 is not
+	template<typename T>
+	inline bool devswSTL is_all_zero(const T* ptr, size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>, "is_all_zero reads the object representation");
+		size_t bytes = count * sizeof(T);
+		if (bytes >= SIMD_ZERO_BYTES) return Dispatch::memory().is_zero(ptr, bytes);
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(ptr);
+		uint64_t acc = 0;
+		size_t i = 0;
+		for (; i + 8 <= bytes; i += 8) {
+			uint64_t word;
+			memcpy(&word, p + i, 8);
+			acc |= word;
+		}
+		for (; i < bytes; ++i) acc |= p[i];
+		return acc == 0;
+	}
+
 	template<typename T>
 	inline void devswSTL move_range(T* dest, const T* src, size_t count) {
 		if constexpr (std::is_trivially_move_assignable_v<T>) {
@@ -267,16 +393,18 @@ namespace devsw::stl {
 		}
 	}
 
+	// Moves count objects into the uninitialized dest and ends their lifetime in src, which may not overlap dest.
+	// One memcpy for is_trivially_relocatable types, a move and a destructor call per element otherwise
 	template<typename T>
 	inline void devswSTL relocate_range(T* dest, T* src, size_t count) {
-		if constexpr (std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>) {
-			memmove(dest, src, count * sizeof(T));
+		if constexpr (is_trivially_relocatable_v<T>) {
+			if (count) memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
 		}
 		else {
 			for (size_t i = 0; i < count; ++i) {
 				::new (dest + i) T(std::move(src[i]));
 				if constexpr (!std::is_trivially_destructible_v<T>) {
-					(src + i).~T();
+					src[i].~T();
 				}
 			}
 		}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "devswSTL.h"
+#include "Allocators.h"
+#include "Memory.h"
+#include <cstddef>
+#include <new>
+
+namespace devsw::stl {
+	/**
+	* Bump arena with a pool of chunks per NUMA node, for worker threads that should only ever touch memory local to
+	* their socket. Every chunk is a page mapping placed on its node before anything is written to it (see Numa).
+	* - allocate(bytes, node) carves from that node's current chunk; Numa::ANY means the caller's current node.
+	* - Numa::INTERLEAVE has a pool of its own, spread page by page over every node, for large buffers all sockets read.
+	* - Requests above a quarter of the chunk size get a chunk of their own.
+	* - reset() hands every standard chunk back to its node's free pool, so a steady state maps nothing new.
+	*   trim() unmaps the free pools.
+	* @note Not synchronized, like UnboundedAllocator: one arena per worker, or per node behind the caller's own lock.
+	* Without NUMA there is one node and the arena is a plain chunked arena.
+	*/
+	class devswSTL NumaArena {
+	public:
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 2 * 1024 * 1024;
+
+		explicit NumaArena(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+		~NumaArena();
+		NumaArena(const NumaArena&) = delete;
+		NumaArena& operator=(const NumaArena&) = delete;
+
+		// alignment a power of two up to the page size. nullptr when the OS is out of memory
+		void* allocate(size_t bytes, int node = Numa::ANY, size_t alignment = 64);
+		void reset();
+		void trim();
+
+		int node_count() const { return nodes_; }
+		size_t chunk_size() const { return chunk_size_; }
+		// Chunks are the reserved bytes. Empty unless built with DEVSW_ALLOCATOR_STATS
+		AllocatorSnapshot stats() const { return stats_.snapshot(); }
+
+	private:
+		struct Chunk;
+		struct Pool {
+			Chunk* active; // Current chunk first
+			Chunk* free;
+		};
+
+		Pool& pool_for(int node);
+		Chunk* new_chunk(size_t size, int node);
+
+		size_t chunk_size_;
+		int nodes_;
+		Pool* pools_; // One per node, then INTERLEAVE
+		AllocatorStats stats_;
+	};
+
+	/**
+	* Allocator<T> over a NumaArena, carving from one node (Numa::ANY: wherever the allocating thread runs).
+	* Arena semantics: deallocate does nothing, the memory comes back with NumaArena::reset.
+	*/
+	template <typename T>
+	class devswSTL NumaAllocator final : public Allocator<T> {
+	public:
+		explicit NumaAllocator(NumaArena& arena, int node = Numa::ANY) noexcept : arena_(&arena), node_(node) {}
+		template <typename U>
+		NumaAllocator(const NumaAllocator<U>& other) noexcept : arena_(other.arena()), node_(other.node()) {}
+
+		T* allocate(size_t n) override {
+			if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+			void* p = arena_->allocate(n * sizeof(T), node_, alignof(T));
+			if (!p) throw std::bad_alloc();
+			return static_cast<T*>(p);
+		}
+
+		void deallocate(T*, size_t) noexcept override {
+			// Nope, NumaArena::reset
+		}
+
+		NumaArena* arena() const { return arena_; }
+		int node() const { return node_; }
+		AllocatorSnapshot stats() const { return arena_->stats(); }
+
+		template <typename U>
+		struct rebind {
+			using other = NumaAllocator<U>;
+		};
+
+	private:
+		NumaArena* arena_;
+		int node_;
+	};
+}
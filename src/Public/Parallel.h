@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+
+#include "devswSTL.h"
+#include "AlignedVector.h"
+#include "ThreadPool.h"
+
+namespace devsw::stl {
+	/**
+	* Execution policy for the parallel Intrinsics overloads, e.g. Intrinsics::add(par, dest, src).
+	* Sizes are in bytes of one operand so the same policy behaves alike for int8_t and double.
+	* @note Below serial_threshold the call runs on the calling thread, waking the pool costs more than it saves.
+	*/
+	struct ParallelPolicy {
+		size_t grain_size = 256 * 1024;        // Bytes per chunk, rounded up to whole cache lines
+		size_t serial_threshold = 1024 * 1024; // Operands smaller than this stay on one core
+
+		constexpr ParallelPolicy with_grain_size(size_t bytes) const { ParallelPolicy p = *this; p.grain_size = bytes; return p; }
+		constexpr ParallelPolicy with_serial_threshold(size_t bytes) const { ParallelPolicy p = *this; p.serial_threshold = bytes; return p; }
+	};
+
+	inline constexpr ParallelPolicy par{};
+
+	/**
+	* Chunking helpers behind the parallel overloads. Chunk boundaries are whole multiples of a cache line, so two
+	* threads never write the same line of a 64-byte aligned AlignedVector.
+	*/
+	struct devswSTL Parallel {
+		template <typename T>
+		static size_t chunk_elements(const ParallelPolicy& policy) {
+			constexpr size_t line = 64 / sizeof(T);
+			size_t elements = (policy.grain_size / sizeof(T) + line - 1) & ~(line - 1);
+			return elements ? elements : line;
+		}
+
+		// body(begin, end) over [0, n), split across the pool
+		template <typename T, typename F>
+		static void for_each_chunk(const ParallelPolicy& policy, size_t n, F&& body) {
+			if (n * sizeof(T) < policy.serial_threshold) {
+				body(size_t(0), n);
+				return;
+			}
+			size_t chunk = chunk_elements<T>(policy);
+			auto task = [&](size_t index) {
+				size_t begin = index * chunk;
+				body(begin, n - begin < chunk ? n : begin + chunk);
+			};
+			ThreadPool::run((n + chunk - 1) / chunk, task);
+		}
+
+		// map(begin, end) per chunk, then folded with combine in chunk order, so the result does not depend on the
+		// number of threads
+		template <typename T, typename R, typename Map, typename Combine>
+		static R reduce_chunks(const ParallelPolicy& policy, size_t n, Map&& map, Combine&& combine) {
+			if (n == 0 || n * sizeof(T) < policy.serial_threshold) return map(size_t(0), n);
+			size_t chunk = chunk_elements<T>(policy);
+			size_t chunks = (n + chunk - 1) / chunk;
+			AlignedVector<R> partials(chunks);
+			R* out = partials.begin();
+			auto task = [&](size_t index) {
+				size_t begin = index * chunk;
+				out[index] = map(begin, n - begin < chunk ? n : begin + chunk);
+			};
+			ThreadPool::run(chunks, task);
+			R result = out[0];
+			for (size_t i = 1; i < chunks; ++i) result = combine(result, out[i]);
+			return result;
+		}
+
+		// Reduce-then-scan: reduce(begin, end) totals every chunk but the last, the totals are folded in chunk order into
+		// each chunk's carry-in, then scan(begin, end, carry) runs per chunk. src is read twice and dest written once
+		template <typename T, typename Reduce, typename Combine, typename Scan>
+		static void scan_chunks(const ParallelPolicy& policy, size_t n, T init, Reduce&& reduce, Combine&& combine, Scan&& scan) {
+			if (n == 0 || n * sizeof(T) < policy.serial_threshold) {
+				scan(size_t(0), n, init);
+				return;
+			}
+			size_t chunk = chunk_elements<T>(policy);
+			size_t chunks = (n + chunk - 1) / chunk;
+			AlignedVector<T> carries(chunks);
+			T* carry = carries.begin();
+			auto totals = [&](size_t index) {
+				size_t begin = index * chunk;
+				carry[index] = reduce(begin, begin + chunk);
+			};
+			ThreadPool::run(chunks - 1, totals);
+			T running = init;
+			for (size_t i = 0; i + 1 < chunks; ++i) {
+				T total = carry[i];
+				carry[i] = running;
+				running = combine(running, total);
+			}
+			carry[chunks - 1] = running;
+			auto scans = [&](size_t index) {
+				size_t begin = index * chunk;
+				scan(begin, n - begin < chunk ? n : begin + chunk, carry[index]);
+			};
+			ThreadPool::run(chunks, scans);
+		}
+	};
+}
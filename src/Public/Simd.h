@@ -0,0 +1,1160 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "AVX.h"
+#include "Float16.h"
+
+namespace devsw::stl {
+	/**
+	* Width-generic views over AVXUtils, one struct per instruction set tier.
+	* Every tier exposes the same static surface (reg, lanes, load/loadu, store/storeu, zero, set1, add, sub, mul,
+	* min, max, abs, fmadd/fmsub/fnmadd, reduce_add/reduce_min/reduce_max, plus div/sqrt for floating point and
+	* sum_wide for integers) so a kernel can be written once and instantiated per tier.
+	* Floating point tiers also carry the handful of primitives SimdMath builds on: floor, round (to nearest even),
+	* ldexp (scale by 2^n for integral n), split_exponent (x = m * 2^e, m in [1, 2), positive normal x only)
+	* and cmp_unord for NaNs.
+	* Every tier compares (cmp_eq, cmp_ne, cmp_lt, cmp_le, cmp_gt, cmp_ge) into a mask: all-ones lanes in a reg on
+	* SSE4.2/AVX2, a k-register on AVX-512, bool on scalar. select(mask, if_true, if_false) blends on it and bitmask(mask)
+	* packs it to one bit per lane, lane 0 in bit 0. Floating point compares are ordered except cmp_ne, as in C++.
+	* Where compressible is true, compress(v, bits) moves the lanes set in bits to the bottom of the register in order
+	* (vpcompress on AVX-512, a shuffle table on SSE4.2/AVX2).
+	* shift_up<Count>(v, fill) moves the lanes of v up by Count (Count <= lanes / 2), filling the bottom from fill, and
+	* broadcast_top(v) copies the top lane everywhere: the two halves of an in-register prefix scan.
+	* Integer tiers where sortable is true (32/64-bit lanes on AVX2 and AVX-512) have the two steps a bitonic network
+	* is built from: permute_xor<Xor>(v) swaps lane i with lane i ^ Xor, blend_lanes<Bits>(a, b) takes the lanes set
+	* in Bits from b and the rest from a.
+	* Where scatter_increments is true (32-bit lanes on AVX-512), increment(counts, indices, valid) adds one to
+	* counts[index] for every valid lane, repeated indices in one register counted correctly.
+	* Integer tiers where gatherable is true (32/64-bit lanes on AVX2 and AVX-512) have gather(base, indices), lane i
+	* loaded from base[indices[i]] for lanes 32-bit indices below 2^31. Where scatterable is true (AVX-512 only),
+	* scatter(base, indices, v) is the reverse, the highest lane winning when indices repeat. gather_strided(base, stride)
+	* and scatter_strided(base, stride, v) address lane i at base + i * stride bytes instead, (lanes - 1) * stride in int32.
+	* Float tiers (and scalar) convert lanes elements of a narrow format in memory to and from a reg: load_f16/store_f16,
+	* load_bf16/store_bf16 (raw uint16_t bits of float16/bfloat16, nearest even), load_i8/store_i8 and load_u8/store_u8
+	* (nearest even, saturating, NaN to the lowest code). Integer tiers have dot_i8/dot_u8i8, which add the products of
+	* each group of 4 byte lanes into the 32-bit lanes of acc; the scalar tier accumulates into a plain int32_t.
+	* load_partial/store_partial touch only the first count < lanes elements, so a kernel finishes its last few
+	* elements with one masked vector step instead of a scalar loop. Lanes past count read as fill and are never written.
+	* stream(ptr, v) is a non-temporal store to a register-aligned ptr, bypassing the cache; a run of them ends with
+	* fence() before the data is handed to anyone else. On the scalar tier both are a plain store and a no-op.
+	* @note The tiers are distinct types on purpose. A kernel instantiated for SimdAVX512 never shares a symbol with the
+	* SimdAVX2 copy, so the linker cannot fold an AVX-512 body into a translation unit built for an older CPU.
+	*/
+
+	// ================= Scalar (1 lane) =================
+	template <typename T>
+	struct SimdScalar {
+		using value_type = T;
+		using reg = T;
+		static constexpr size_t lanes = 1;
+
+		FUNC reg load(const T* ptr) { return *ptr; }
+		FUNC reg loadu(const T* ptr) { return *ptr; }
+		FUNC void store(T* ptr, reg v) { *ptr = v; }
+		FUNC void storeu(T* ptr, reg v) { *ptr = v; }
+		FUNC void stream(T* ptr, reg v) { *ptr = v; }
+		FUNC void fence() {}
+		FUNC reg load_partial(const T* ptr, size_t count, reg fill = zero()) { return count ? *ptr : fill; }
+		FUNC void store_partial(T* ptr, reg v, size_t count) { if (count) *ptr = v; }
+		FUNC reg zero() { return T(0); }
+		FUNC reg set1(T v) { return v; }
+		FUNC reg add(reg a, reg b) { return T(a + b); }
+		FUNC reg sub(reg a, reg b) { return T(a - b); }
+		FUNC reg mul(reg a, reg b) { return T(a * b); }
+		FUNC reg div(reg a, reg b) { return T(a / b); }
+		FUNC reg min(reg a, reg b) { return a < b ? a : b; } // Same operand order as minps, NaN picks b
+		FUNC reg max(reg a, reg b) { return a > b ? a : b; }
+		FUNC reg abs(reg a) {
+			if constexpr (std::is_floating_point_v<T>) return std::fabs(a);
+			else if constexpr (std::is_signed_v<T>) return a < 0 ? T(-a) : a;
+			else return a;
+		}
+		FUNC reg sqrt(reg a) { return std::sqrt(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return T(a * b + c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return T(a * b - c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return T(c - a * b); }
+		FUNC T reduce_add(reg a) { return a; }
+		FUNC T reduce_min(reg a) { return a; }
+		FUNC T reduce_max(reg a) { return a; }
+		FUNC sum_t<T> sum_wide(reg a) { return a; }
+
+		using mask = bool;
+		FUNC reg floor(reg a) { return std::floor(a); }
+		FUNC reg round(reg a) { return std::nearbyint(a); }
+		FUNC reg ldexp(reg a, reg n) { return n == n ? std::ldexp(a, static_cast<int>(n)) : n; }
+		FUNC reg split_exponent(reg a, reg& e) {
+			int exponent;
+			T mantissa = std::frexp(a, &exponent);
+			e = T(exponent - 1);
+			return mantissa * 2;
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return a < b; }
+		FUNC mask cmp_le(reg a, reg b) { return a <= b; }
+		FUNC mask cmp_eq(reg a, reg b) { return a == b; }
+		FUNC mask cmp_ne(reg a, reg b) { return a != b; }
+		FUNC mask cmp_gt(reg a, reg b) { return a > b; }
+		FUNC mask cmp_ge(reg a, reg b) { return a >= b; }
+		FUNC mask cmp_unord(reg a, reg b) { return a != a || b != b; }
+		FUNC reg select(mask m, reg a, reg b) { return m ? a : b; }
+		FUNC uint64_t bitmask(mask m) { return m ? 1 : 0; }
+		// One lane, compress is the branchless store-and-advance
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t) { return a; }
+		// One lane, a shift moves it out entirely
+		template <size_t Count> FUNC reg shift_up(reg, reg fill) { return fill; }
+		FUNC reg broadcast_top(reg a) { return a; }
+		static constexpr bool sortable = false;
+		static constexpr bool scatter_increments = false;
+		static constexpr bool gatherable = false;
+		static constexpr bool scatterable = false;
+		// Narrow storage formats, see the tier notes above
+		FUNC reg load_f16(const uint16_t* ptr) { return T(float16::to_float(*ptr)); }
+		FUNC void store_f16(uint16_t* ptr, reg v) { *ptr = float16::from_float(float(v)); }
+		FUNC reg load_bf16(const uint16_t* ptr) { return T(bfloat16::to_float(*ptr)); }
+		FUNC void store_bf16(uint16_t* ptr, reg v) { *ptr = bfloat16::from_float(float(v)); }
+		FUNC reg load_i8(const int8_t* ptr) { return T(*ptr); }
+		FUNC reg load_u8(const uint8_t* ptr) { return T(*ptr); }
+		// Clamp first, with NaN failing both tests and landing on the lowest code like the SIMD max/min pair does
+		FUNC void store_i8(int8_t* ptr, reg v) { *ptr = static_cast<int8_t>(std::nearbyint(v > T(-128) ? (v < T(127) ? v : T(127)) : T(-128))); }
+		FUNC void store_u8(uint8_t* ptr, reg v) { *ptr = static_cast<uint8_t>(std::nearbyint(v > T(0) ? (v < T(255) ? v : T(255)) : T(0))); }
+		FUNC int32_t dot_i8(int32_t acc, reg a, reg b) { return acc + int32_t(int8_t(a)) * int32_t(int8_t(b)); }
+		FUNC int32_t dot_u8i8(int32_t acc, reg a, reg b) { return acc + int32_t(uint8_t(a)) * int32_t(int8_t(b)); }
+	};
+
+	// ================= SSE4.2 (128-bit) =================
+	template <typename T>
+	struct SimdSSE42 {
+		static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "SimdSSE42 integer lanes are 8 to 64 bits wide");
+		using value_type = T;
+		using reg = __m128i;
+		static constexpr size_t lanes = 16 / sizeof(T);
+
+		FUNC reg load(const T* ptr) { return AVXUtils::load_i128(ptr); }
+		FUNC reg loadu(const T* ptr) { return AVXUtils::loadu_i128(ptr); }
+		FUNC void store(T* ptr, reg v) { AVXUtils::store_i128(ptr, v); }
+		FUNC void storeu(T* ptr, reg v) { AVXUtils::storeu_i128(ptr, v); }
+		FUNC void stream(T* ptr, reg v) { AVXUtils::stream_i128(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		// No masked moves for these lanes, so the tail bounces through a register-sized stack buffer
+		FUNC reg load_partial(const T* ptr, size_t count, reg fill = zero()) {
+			alignas(16) T buffer[lanes];
+			store(buffer, fill);
+			std::memcpy(buffer, ptr, count * sizeof(T));
+			return load(buffer);
+		}
+		FUNC void store_partial(T* ptr, reg v, size_t count) {
+			alignas(16) T buffer[lanes];
+			store(buffer, v);
+			std::memcpy(ptr, buffer, count * sizeof(T));
+		}
+		FUNC reg zero() { return _mm_setzero_si128(); }
+		FUNC reg set1(T v) {
+			if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(v));
+			else if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(v));
+			else if constexpr (sizeof(T) == 4) return _mm_set1_epi32(static_cast<int>(v));
+			else return _mm_set1_epi64x(static_cast<long long>(v));
+		}
+		FUNC reg add(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::add_i8_128(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::add_i16_128(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::add_i32_128(a, b);
+			else return AVXUtils::add_i64_128(a, b);
+		}
+		FUNC reg sub(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::sub_i8_128(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::sub_i16_128(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::sub_i32_128(a, b);
+			else return AVXUtils::sub_i64_128(a, b);
+		}
+		FUNC reg mul(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::mul_i8_128(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::mul_i16_128(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::mul_i32_128(a, b);
+			else return AVXUtils::mul_i64_128(a, b);
+		}
+		FUNC reg min(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_i8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_i16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_i32_128(a, b);
+				else return AVXUtils::min_i64_128(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_u8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_u16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_u32_128(a, b);
+				else return AVXUtils::min_u64_128(a, b);
+			}
+		}
+		FUNC reg max(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_i8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_i16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_i32_128(a, b);
+				else return AVXUtils::max_i64_128(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_u8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_u16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_u32_128(a, b);
+				else return AVXUtils::max_u64_128(a, b);
+			}
+		}
+		FUNC reg abs(reg a) {
+			if constexpr (!std::is_signed_v<T>) return a;
+			else if constexpr (sizeof(T) == 1) return AVXUtils::abs_i8_128(a);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::abs_i16_128(a);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::abs_i32_128(a);
+			else return AVXUtils::abs_i64_128(a);
+		}
+		FUNC reg fmadd(reg a, reg b, reg c) { return add(mul(a, b), c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return sub(mul(a, b), c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return sub(c, mul(a, b)); }
+		// Pairwise sums of adjacent lanes up to 64-bit lanes (sad/madd against zero/one), so nothing can overflow
+		FUNC reg sum_wide(reg a) {
+			if constexpr (sizeof(T) == 1) {
+				if constexpr (!std::is_signed_v<T>) return _mm_sad_epu8(a, _mm_setzero_si128());
+				// Bias to unsigned, each 64-bit lane summed 8 biased bytes
+				reg biased = _mm_sad_epu8(_mm_xor_si128(a, _mm_set1_epi8(char(0x80))), _mm_setzero_si128());
+				return _mm_sub_epi64(biased, _mm_set1_epi64x(8 * 128));
+			}
+			else if constexpr (sizeof(T) == 2) {
+				reg pairs = _mm_madd_epi16(std::is_signed_v<T> ? a : _mm_xor_si128(a, _mm_set1_epi16(short(0x8000))), _mm_set1_epi16(1));
+				reg wide = _mm_add_epi64(_mm_cvtepi32_epi64(pairs), _mm_cvtepi32_epi64(_mm_unpackhi_epi64(pairs, pairs)));
+				return std::is_signed_v<T> ? wide : _mm_add_epi64(wide, _mm_set1_epi64x(4 * 32768));
+			}
+			else if constexpr (sizeof(T) == 4) {
+				if constexpr (std::is_signed_v<T>) return _mm_add_epi64(_mm_cvtepi32_epi64(a), _mm_cvtepi32_epi64(_mm_unpackhi_epi64(a, a)));
+				else return _mm_add_epi64(_mm_cvtepu32_epi64(a), _mm_cvtepu32_epi64(_mm_unpackhi_epi64(a, a)));
+			}
+			else return a;
+		}
+		FUNC T reduce_add(reg a) {
+			reg wide = sum_wide(a);
+			return static_cast<T>(_mm_cvtsi128_si64(_mm_add_epi64(wide, _mm_unpackhi_epi64(wide, wide))));
+		}
+		FUNC T reduce_min(reg a) {
+			a = min(a, _mm_unpackhi_epi64(a, a));
+			if constexpr (sizeof(T) <= 4) a = min(a, _mm_srli_epi64(a, 32));
+			if constexpr (sizeof(T) <= 2) a = min(a, _mm_srli_epi32(a, 16));
+			if constexpr (sizeof(T) == 1) a = min(a, _mm_srli_epi16(a, 8));
+			return static_cast<T>(_mm_cvtsi128_si64(a));
+		}
+		FUNC T reduce_max(reg a) {
+			a = max(a, _mm_unpackhi_epi64(a, a));
+			if constexpr (sizeof(T) <= 4) a = max(a, _mm_srli_epi64(a, 32));
+			if constexpr (sizeof(T) <= 2) a = max(a, _mm_srli_epi32(a, 16));
+			if constexpr (sizeof(T) == 1) a = max(a, _mm_srli_epi16(a, 8));
+			return static_cast<T>(_mm_cvtsi128_si64(a));
+		}
+
+		// Compares give all-ones lanes in a reg, select and bitmask take those
+		using mask = reg;
+		FUNC mask cmp_eq(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::cmpeq_i8_128(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::cmpeq_i16_128(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::cmpeq_i32_128(a, b);
+			else return AVXUtils::cmpeq_i64_128(a, b);
+		}
+		FUNC mask cmp_gt(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::cmpgt_i8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::cmpgt_i16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::cmpgt_i32_128(a, b);
+				else return AVXUtils::cmpgt_i64_128(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::cmpgt_u8_128(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::cmpgt_u16_128(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::cmpgt_u32_128(a, b);
+				else return AVXUtils::cmpgt_u64_128(a, b);
+			}
+		}
+		FUNC mask cmp_ne(reg a, reg b) { return AVXUtils::not_i128(cmp_eq(a, b)); }
+		FUNC mask cmp_lt(reg a, reg b) { return cmp_gt(b, a); }
+		FUNC mask cmp_le(reg a, reg b) { return AVXUtils::not_i128(cmp_gt(a, b)); }
+		FUNC mask cmp_ge(reg a, reg b) { return AVXUtils::not_i128(cmp_gt(b, a)); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_i128(m, a, b); }
+		FUNC uint64_t bitmask(mask m) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::movemask_i8_128(m);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::movemask_i16_128(m);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::movemask_i32_128(m);
+			else return AVXUtils::movemask_i64_128(m);
+		}
+		// Left-packs the lanes set in m (bitmask layout). No byte/word lane shuffle table, 8/16-bit lanes are not compressible
+		static constexpr bool compressible = sizeof(T) >= 4;
+		FUNC reg compress(reg a, uint64_t m) {
+			static_assert(sizeof(T) >= 4, "Only 32/64-bit lanes have a compress shuffle");
+			if constexpr (sizeof(T) == 4) return AVXUtils::compress_i32_128(a, static_cast<uint32_t>(m));
+			else return AVXUtils::compress_i64_128(a, static_cast<uint32_t>(m));
+		}
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return AVXUtils::shift_up_128<int(Count * sizeof(T))>(a, fill); }
+		FUNC reg broadcast_top(reg a) { return AVXUtils::broadcast_top_128<int(sizeof(T))>(a); }
+		// Two or four lanes are not worth a network, the sort kernels go straight to radix
+		static constexpr bool sortable = false;
+		static constexpr bool scatter_increments = false;
+		// No gather before AVX2
+		static constexpr bool gatherable = false;
+		static constexpr bool scatterable = false;
+		// acc (4/8/16 x i32) += sums of 4 adjacent byte products, a and b as int8 lanes (dot_u8i8: a as uint8)
+		FUNC reg dot_i8(reg acc, reg a, reg b) { return AVXUtils::dot_i8_i32_128(acc, a, b); }
+		FUNC reg dot_u8i8(reg acc, reg a, reg b) { return AVXUtils::dot_u8i8_i32_128(acc, a, b); }
+	};
+
+	template <>
+	struct SimdSSE42<float> {
+		using value_type = float;
+		using reg = __m128;
+		static constexpr size_t lanes = 4;
+
+		FUNC reg load(const float* ptr) { return AVXUtils::load_f32_128(ptr); }
+		FUNC reg loadu(const float* ptr) { return AVXUtils::loadu_f32_128(ptr); }
+		FUNC void store(float* ptr, reg v) { AVXUtils::store_f32_128(ptr, v); }
+		FUNC void storeu(float* ptr, reg v) { AVXUtils::storeu_f32_128(ptr, v); }
+		FUNC void stream(float* ptr, reg v) { AVXUtils::stream_f32_128(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		// No masked moves for these lanes, so the tail bounces through a register-sized stack buffer
+		FUNC reg load_partial(const float* ptr, size_t count, reg fill = zero()) {
+			alignas(16) float buffer[lanes];
+			store(buffer, fill);
+			std::memcpy(buffer, ptr, count * sizeof(float));
+			return load(buffer);
+		}
+		FUNC void store_partial(float* ptr, reg v, size_t count) {
+			alignas(16) float buffer[lanes];
+			store(buffer, v);
+			std::memcpy(ptr, buffer, count * sizeof(float));
+		}
+		FUNC reg zero() { return _mm_setzero_ps(); }
+		FUNC reg set1(float v) { return _mm_set1_ps(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f32_128(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f32_128(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f32_128(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f32_128(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f32_128(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f32_128(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f32_128(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f32_128(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f32_128(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return sub(mul(a, b), c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return sub(c, mul(a, b)); }
+		FUNC float reduce_add(reg a) {
+			__m128 shuf = _mm_movehdup_ps(a);
+			__m128 sums = _mm_add_ps(a, shuf);
+			shuf = _mm_movehl_ps(shuf, sums);
+			return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+		}
+		FUNC float reduce_min(reg a) {
+			a = min(a, _mm_movehl_ps(a, a));
+			return _mm_cvtss_f32(min(a, _mm_shuffle_ps(a, a, 1)));
+		}
+		FUNC float reduce_max(reg a) {
+			a = max(a, _mm_movehl_ps(a, a));
+			return _mm_cvtss_f32(max(a, _mm_shuffle_ps(a, a, 1)));
+		}
+
+		using mask = __m128;
+		FUNC reg floor(reg a) { return _mm_floor_ps(a); }
+		FUNC reg round(reg a) { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		// 2^n built in the exponent field: n + 2^23 + 127 leaves n + 127 in the low mantissa bits. Split in two halves
+		// so |n| up to 252 works, which also rounds results below FLT_MIN to denormals rather than garbage.
+		FUNC reg pow2i(reg n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(_mm_add_ps(n, _mm_set1_ps(8388608.0f + 127.0f))), 23)); }
+		FUNC reg ldexp(reg a, reg n) {
+			reg half = round(mul(n, _mm_set1_ps(0.5f)));
+			return mul(mul(a, pow2i(half)), pow2i(sub(n, half)));
+		}
+		FUNC reg split_exponent(reg a, reg& e) {
+			__m128i bits = _mm_castps_si128(a);
+			e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+			return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm_cmple_ps(a, b); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm_cmpeq_ps(a, b); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm_cmpunord_ps(a, b); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm_cmpneq_ps(a, b); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm_cmpgt_ps(a, b); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm_cmpge_ps(a, b); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_f32_128(m, a, b); }
+		FUNC uint64_t bitmask(mask m) { return AVXUtils::movemask_f32_128(m); }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm_castsi128_ps(AVXUtils::compress_i32_128(_mm_castps_si128(a), static_cast<uint32_t>(m))); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm_castsi128_ps(AVXUtils::shift_up_128<int(Count * 4)>(_mm_castps_si128(a), _mm_castps_si128(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm_castsi128_ps(AVXUtils::broadcast_top_128<4>(_mm_castps_si128(a))); }
+		// No F16C below AVX2, so float16 goes through the scalar conversion lane by lane
+		FUNC reg load_f16(const uint16_t* ptr) {
+			return _mm_setr_ps(float16::to_float(ptr[0]), float16::to_float(ptr[1]), float16::to_float(ptr[2]), float16::to_float(ptr[3]));
+		}
+		FUNC void store_f16(uint16_t* ptr, reg v) {
+			alignas(16) float buffer[lanes];
+			store(buffer, v);
+			for (size_t i = 0; i < lanes; ++i) ptr[i] = float16::from_float(buffer[i]);
+		}
+		FUNC reg load_bf16(const uint16_t* ptr) { return AVXUtils::cvt_bf16_f32_128(ptr); }
+		FUNC void store_bf16(uint16_t* ptr, reg v) { AVXUtils::cvt_f32_bf16_128(ptr, v); }
+		FUNC reg load_i8(const int8_t* ptr) { return AVXUtils::cvt_i8_f32_128(ptr); }
+		FUNC reg load_u8(const uint8_t* ptr) { return AVXUtils::cvt_u8_f32_128(ptr); }
+		FUNC void store_i8(int8_t* ptr, reg v) { AVXUtils::cvt_f32_i8_128(ptr, v); }
+		FUNC void store_u8(uint8_t* ptr, reg v) { AVXUtils::cvt_f32_u8_128(ptr, v); }
+	};
+
+	template <>
+	struct SimdSSE42<double> {
+		using value_type = double;
+		using reg = __m128d;
+		static constexpr size_t lanes = 2;
+
+		FUNC reg load(const double* ptr) { return AVXUtils::load_f64_128(ptr); }
+		FUNC reg loadu(const double* ptr) { return AVXUtils::loadu_f64_128(ptr); }
+		FUNC void store(double* ptr, reg v) { AVXUtils::store_f64_128(ptr, v); }
+		FUNC void storeu(double* ptr, reg v) { AVXUtils::storeu_f64_128(ptr, v); }
+		FUNC void stream(double* ptr, reg v) { AVXUtils::stream_f64_128(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		// No masked moves for these lanes, so the tail bounces through a register-sized stack buffer
+		FUNC reg load_partial(const double* ptr, size_t count, reg fill = zero()) {
+			alignas(16) double buffer[lanes];
+			store(buffer, fill);
+			std::memcpy(buffer, ptr, count * sizeof(double));
+			return load(buffer);
+		}
+		FUNC void store_partial(double* ptr, reg v, size_t count) {
+			alignas(16) double buffer[lanes];
+			store(buffer, v);
+			std::memcpy(ptr, buffer, count * sizeof(double));
+		}
+		FUNC reg zero() { return _mm_setzero_pd(); }
+		FUNC reg set1(double v) { return _mm_set1_pd(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f64_128(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f64_128(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f64_128(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f64_128(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f64_128(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f64_128(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f64_128(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f64_128(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f64_128(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return sub(mul(a, b), c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return sub(c, mul(a, b)); }
+		FUNC double reduce_add(reg a) { return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a))); }
+		FUNC double reduce_min(reg a) { return _mm_cvtsd_f64(min(a, _mm_unpackhi_pd(a, a))); }
+		FUNC double reduce_max(reg a) { return _mm_cvtsd_f64(max(a, _mm_unpackhi_pd(a, a))); }
+
+		using mask = __m128d;
+		FUNC reg floor(reg a) { return _mm_floor_pd(a); }
+		FUNC reg round(reg a) { return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		FUNC reg pow2i(reg n) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627370496.0 + 1023.0))), 52)); }
+		FUNC reg ldexp(reg a, reg n) {
+			reg half = round(mul(n, _mm_set1_pd(0.5)));
+			return mul(mul(a, pow2i(half)), pow2i(sub(n, half)));
+		}
+		// No packed int64 -> double before AVX-512DQ, the exponent is ORed into the mantissa of 2^52 instead
+		FUNC reg split_exponent(reg a, reg& e) {
+			__m128i bits = _mm_castpd_si128(a);
+			reg biased = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(bits, 52), _mm_castpd_si128(_mm_set1_pd(4503599627370496.0))));
+			e = _mm_sub_pd(biased, _mm_set1_pd(4503599627370496.0 + 1023.0));
+			return _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFll)), _mm_set1_epi64x(0x3FF0000000000000ll)));
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm_cmple_pd(a, b); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm_cmpeq_pd(a, b); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm_cmpunord_pd(a, b); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm_cmpneq_pd(a, b); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm_cmpgt_pd(a, b); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm_cmpge_pd(a, b); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_f64_128(m, a, b); }
+		FUNC uint64_t bitmask(mask m) { return AVXUtils::movemask_f64_128(m); }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm_castsi128_pd(AVXUtils::compress_i64_128(_mm_castpd_si128(a), static_cast<uint32_t>(m))); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm_castsi128_pd(AVXUtils::shift_up_128<int(Count * 8)>(_mm_castpd_si128(a), _mm_castpd_si128(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm_castsi128_pd(AVXUtils::broadcast_top_128<8>(_mm_castpd_si128(a))); }
+	};
+
+	// ================= AVX2 (256-bit) =================
+	template <typename T>
+	struct SimdAVX2 {
+		static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "SimdAVX2 integer lanes are 8 to 64 bits wide");
+		using value_type = T;
+		using reg = __m256i;
+		static constexpr size_t lanes = avx_lanes_v<T>;
+
+		FUNC reg load(const T* ptr) { return AVXUtils::load_i8(reinterpret_cast<const int8_t*>(ptr)); }
+		FUNC reg loadu(const T* ptr) { return AVXUtils::loadu_i8(reinterpret_cast<const int8_t*>(ptr)); }
+		FUNC void store(T* ptr, reg v) { AVXUtils::store_i8(reinterpret_cast<int8_t*>(ptr), v); }
+		FUNC void storeu(T* ptr, reg v) { AVXUtils::storeu_i8(reinterpret_cast<int8_t*>(ptr), v); }
+		FUNC void stream(T* ptr, reg v) { AVXUtils::stream_i256(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		// vpmaskmov for 32/64-bit lanes, 8/16-bit lanes have no masked move before AVX-512 and bounce through the stack
+		FUNC reg load_partial(const T* ptr, size_t count, reg fill = zero()) {
+			if constexpr (sizeof(T) >= 4) {
+				reg mask = tail_mask(count);
+				reg loaded;
+				if constexpr (sizeof(T) == 4) loaded = _mm256_maskload_epi32(reinterpret_cast<const int*>(ptr), mask);
+				else loaded = _mm256_maskload_epi64(reinterpret_cast<const long long*>(ptr), mask);
+				return _mm256_blendv_epi8(fill, loaded, mask);
+			}
+			else {
+				alignas(32) T buffer[lanes];
+				store(buffer, fill);
+				std::memcpy(buffer, ptr, count * sizeof(T));
+				return load(buffer);
+			}
+		}
+		FUNC void store_partial(T* ptr, reg v, size_t count) {
+			if constexpr (sizeof(T) == 4) _mm256_maskstore_epi32(reinterpret_cast<int*>(ptr), tail_mask(count), v);
+			else if constexpr (sizeof(T) == 8) _mm256_maskstore_epi64(reinterpret_cast<long long*>(ptr), tail_mask(count), v);
+			else {
+				alignas(32) T buffer[lanes];
+				store(buffer, v);
+				std::memcpy(ptr, buffer, count * sizeof(T));
+			}
+		}
+		// All ones in the lanes below count, for 32/64-bit lanes
+		FUNC reg tail_mask(size_t count) {
+			if constexpr (sizeof(T) == 4) return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			else return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(count)), _mm256_setr_epi64x(0, 1, 2, 3));
+		}
+		FUNC reg zero() { return _mm256_setzero_si256(); }
+		FUNC reg set1(T v) {
+			if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(v));
+			else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(v));
+			else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(v));
+			else return _mm256_set1_epi64x(static_cast<long long>(v));
+		}
+		FUNC reg add(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::add_i8(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::add_i16(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::add_i32(a, b);
+			else return AVXUtils::add_i64(a, b);
+		}
+		FUNC reg sub(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::sub_i8(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::sub_i16(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::sub_i32(a, b);
+			else return AVXUtils::sub_i64(a, b);
+		}
+		FUNC reg mul(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::mul_i8(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::mul_i16(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::mul_i32(a, b);
+			else return AVXUtils::mul_i64(a, b);
+		}
+		FUNC reg min(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_i8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_i16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_i32(a, b);
+				else return AVXUtils::min_i64(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_u8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_u16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_u32(a, b);
+				else return AVXUtils::min_u64(a, b);
+			}
+		}
+		FUNC reg max(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_i8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_i16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_i32(a, b);
+				else return AVXUtils::max_i64(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_u8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_u16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_u32(a, b);
+				else return AVXUtils::max_u64(a, b);
+			}
+		}
+		FUNC reg abs(reg a) {
+			if constexpr (!std::is_signed_v<T>) return a;
+			else if constexpr (sizeof(T) == 1) return AVXUtils::abs_i8(a);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::abs_i16(a);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::abs_i32(a);
+			else return AVXUtils::abs_i64(a);
+		}
+		FUNC reg fmadd(reg a, reg b, reg c) { return add(mul(a, b), c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return sub(mul(a, b), c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return sub(c, mul(a, b)); }
+		FUNC reg sum_wide(reg a) {
+			if constexpr (sizeof(T) == 1) {
+				if constexpr (!std::is_signed_v<T>) return _mm256_sad_epu8(a, _mm256_setzero_si256());
+				reg biased = _mm256_sad_epu8(_mm256_xor_si256(a, _mm256_set1_epi8(char(0x80))), _mm256_setzero_si256());
+				return _mm256_sub_epi64(biased, _mm256_set1_epi64x(8 * 128));
+			}
+			else if constexpr (sizeof(T) == 2) {
+				reg pairs = _mm256_madd_epi16(std::is_signed_v<T> ? a : _mm256_xor_si256(a, _mm256_set1_epi16(short(0x8000))), _mm256_set1_epi16(1));
+				reg wide = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(pairs)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(pairs, 1)));
+				return std::is_signed_v<T> ? wide : _mm256_add_epi64(wide, _mm256_set1_epi64x(4 * 32768));
+			}
+			else if constexpr (sizeof(T) == 4) {
+				if constexpr (std::is_signed_v<T>) return _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+				else return _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1)));
+			}
+			else return a;
+		}
+		FUNC T reduce_add(reg a) {
+			reg wide = sum_wide(a);
+			__m128i half = _mm_add_epi64(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+			return static_cast<T>(_mm_cvtsi128_si64(_mm_add_epi64(half, _mm_unpackhi_epi64(half, half))));
+		}
+		FUNC T reduce_min(reg a) { return SimdSSE42<T>::reduce_min(SimdSSE42<T>::min(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1))); }
+		FUNC T reduce_max(reg a) { return SimdSSE42<T>::reduce_max(SimdSSE42<T>::max(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1))); }
+
+		// Compares give all-ones lanes in a reg, select and bitmask take those
+		using mask = reg;
+		FUNC mask cmp_eq(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::cmpeq_i8(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::cmpeq_i16(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::cmpeq_i32(a, b);
+			else return AVXUtils::cmpeq_i64(a, b);
+		}
+		FUNC mask cmp_gt(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::cmpgt_i8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::cmpgt_i16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::cmpgt_i32(a, b);
+				else return AVXUtils::cmpgt_i64(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::cmpgt_u8(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::cmpgt_u16(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::cmpgt_u32(a, b);
+				else return AVXUtils::cmpgt_u64(a, b);
+			}
+		}
+		FUNC mask cmp_ne(reg a, reg b) { return AVXUtils::not_i256(cmp_eq(a, b)); }
+		FUNC mask cmp_lt(reg a, reg b) { return cmp_gt(b, a); }
+		FUNC mask cmp_le(reg a, reg b) { return AVXUtils::not_i256(cmp_gt(a, b)); }
+		FUNC mask cmp_ge(reg a, reg b) { return AVXUtils::not_i256(cmp_gt(b, a)); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_i256(m, a, b); }
+		FUNC uint64_t bitmask(mask m) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::movemask_i8(m);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::movemask_i16(m);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::movemask_i32(m);
+			else return AVXUtils::movemask_i64(m);
+		}
+		// Left-packs the lanes set in m (bitmask layout). No byte/word lane shuffle table, 8/16-bit lanes are not compressible
+		static constexpr bool compressible = sizeof(T) >= 4;
+		FUNC reg compress(reg a, uint64_t m) {
+			static_assert(sizeof(T) >= 4, "Only 32/64-bit lanes have a compress shuffle");
+			if constexpr (sizeof(T) == 4) return AVXUtils::compress_i32(a, static_cast<uint32_t>(m));
+			else return AVXUtils::compress_i64(a, static_cast<uint32_t>(m));
+		}
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return AVXUtils::shift_up<int(Count * sizeof(T))>(a, fill); }
+		FUNC reg broadcast_top(reg a) { return AVXUtils::broadcast_top<int(sizeof(T))>(a); }
+		static constexpr bool sortable = sizeof(T) >= 4;
+		template <size_t Xor> FUNC reg permute_xor(reg a) {
+			if constexpr (sizeof(T) == 4) return AVXUtils::permute_xor_i32<int(Xor)>(a);
+			else return AVXUtils::permute_xor_i64<int(Xor)>(a);
+		}
+		template <uint64_t Bits> FUNC reg blend_lanes(reg a, reg b) {
+			if constexpr (sizeof(T) == 4) return AVXUtils::blend_lanes_i32<int(Bits)>(a, b);
+			else return AVXUtils::blend_lanes_i64<int(Bits)>(a, b);
+		}
+		// No scatter (or conflict detection) before AVX-512
+		static constexpr bool scatter_increments = false;
+		static constexpr bool gatherable = sizeof(T) >= 4;
+		static constexpr bool scatterable = false;
+		FUNC reg gather(const T* base, const uint32_t* indices) {
+			static_assert(sizeof(T) >= 4, "vpgatherd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) return AVXUtils::gather_i32(base, indices);
+			else return AVXUtils::gather_i64(base, indices);
+		}
+		FUNC reg gather_strided(const void* base, int32_t stride) {
+			static_assert(sizeof(T) >= 4, "vpgatherd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) return AVXUtils::gather_stride_i32(base, stride);
+			else return AVXUtils::gather_stride_i64(base, stride);
+		}
+		FUNC reg dot_i8(reg acc, reg a, reg b) { return AVXUtils::dot_i8_i32(acc, a, b); }
+		FUNC reg dot_u8i8(reg acc, reg a, reg b) { return AVXUtils::dot_u8i8_i32(acc, a, b); }
+	};
+
+	template <>
+	struct SimdAVX2<float> {
+		using value_type = float;
+		using reg = __m256;
+		static constexpr size_t lanes = 8;
+
+		FUNC reg load(const float* ptr) { return AVXUtils::load_f32(ptr); }
+		FUNC reg loadu(const float* ptr) { return AVXUtils::loadu_f32(ptr); }
+		FUNC void store(float* ptr, reg v) { AVXUtils::store_f32(ptr, v); }
+		FUNC void storeu(float* ptr, reg v) { AVXUtils::storeu_f32(ptr, v); }
+		FUNC void stream(float* ptr, reg v) { AVXUtils::stream_f32(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		FUNC reg load_partial(const float* ptr, size_t count, reg fill = zero()) {
+			__m256i mask = SimdAVX2<int32_t>::tail_mask(count);
+			return _mm256_blendv_ps(fill, _mm256_maskload_ps(ptr, mask), _mm256_castsi256_ps(mask));
+		}
+		FUNC void store_partial(float* ptr, reg v, size_t count) { _mm256_maskstore_ps(ptr, SimdAVX2<int32_t>::tail_mask(count), v); }
+		FUNC reg zero() { return _mm256_setzero_ps(); }
+		FUNC reg set1(float v) { return _mm256_set1_ps(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f32(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f32(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f32(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f32(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f32(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f32(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f32(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f32(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f32(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return AVXUtils::fmsub_f32(a, b, c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return AVXUtils::fnmadd_f32(a, b, c); }
+		FUNC float reduce_add(reg a) {
+			__m128 v = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+			__m128 shuf = _mm_movehdup_ps(v);
+			__m128 sums = _mm_add_ps(v, shuf);
+			shuf = _mm_movehl_ps(shuf, sums);
+			return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+		}		FUNC float reduce_min(reg a) { return SimdSSE42<float>::reduce_min(_mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1))); }
+		FUNC float reduce_max(reg a) { return SimdSSE42<float>::reduce_max(_mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1))); }
+
+		using mask = __m256;
+		FUNC reg floor(reg a) { return _mm256_floor_ps(a); }
+		FUNC reg round(reg a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		FUNC reg pow2i(reg n) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(_mm256_add_ps(n, _mm256_set1_ps(8388608.0f + 127.0f))), 23)); }
+		FUNC reg ldexp(reg a, reg n) {
+			reg half = round(mul(n, _mm256_set1_ps(0.5f)));
+			return mul(mul(a, pow2i(half)), pow2i(sub(n, half)));
+		}
+		FUNC reg split_exponent(reg a, reg& e) {
+			__m256i bits = _mm256_castps_si256(a);
+			e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+			return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_UNORD_Q); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_f32(m, a, b); }
+		FUNC uint64_t bitmask(mask m) { return AVXUtils::movemask_f32(m); }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm256_castsi256_ps(AVXUtils::compress_i32(_mm256_castps_si256(a), static_cast<uint32_t>(m))); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm256_castsi256_ps(AVXUtils::shift_up<int(Count * 4)>(_mm256_castps_si256(a), _mm256_castps_si256(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm256_castsi256_ps(AVXUtils::broadcast_top<4>(_mm256_castps_si256(a))); }
+		FUNC reg load_f16(const uint16_t* ptr) { return AVXUtils::cvt_f16_f32(ptr); }
+		FUNC void store_f16(uint16_t* ptr, reg v) { AVXUtils::cvt_f32_f16(ptr, v); }
+		FUNC reg load_bf16(const uint16_t* ptr) { return AVXUtils::cvt_bf16_f32(ptr); }
+		FUNC void store_bf16(uint16_t* ptr, reg v) { AVXUtils::cvt_f32_bf16(ptr, v); }
+		FUNC reg load_i8(const int8_t* ptr) { return AVXUtils::cvt_i8_f32(ptr); }
+		FUNC reg load_u8(const uint8_t* ptr) { return AVXUtils::cvt_u8_f32(ptr); }
+		FUNC void store_i8(int8_t* ptr, reg v) { AVXUtils::cvt_f32_i8(ptr, v); }
+		FUNC void store_u8(uint8_t* ptr, reg v) { AVXUtils::cvt_f32_u8(ptr, v); }
+	};
+
+	template <>
+	struct SimdAVX2<double> {
+		using value_type = double;
+		using reg = __m256d;
+		static constexpr size_t lanes = 4;
+
+		FUNC reg load(const double* ptr) { return AVXUtils::load_f64(ptr); }
+		FUNC reg loadu(const double* ptr) { return AVXUtils::loadu_f64(ptr); }
+		FUNC void store(double* ptr, reg v) { AVXUtils::store_f64(ptr, v); }
+		FUNC void storeu(double* ptr, reg v) { AVXUtils::storeu_f64(ptr, v); }
+		FUNC void stream(double* ptr, reg v) { AVXUtils::stream_f64(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		FUNC reg load_partial(const double* ptr, size_t count, reg fill = zero()) {
+			__m256i mask = SimdAVX2<int64_t>::tail_mask(count);
+			return _mm256_blendv_pd(fill, _mm256_maskload_pd(ptr, mask), _mm256_castsi256_pd(mask));
+		}
+		FUNC void store_partial(double* ptr, reg v, size_t count) { _mm256_maskstore_pd(ptr, SimdAVX2<int64_t>::tail_mask(count), v); }
+		FUNC reg zero() { return _mm256_setzero_pd(); }
+		FUNC reg set1(double v) { return _mm256_set1_pd(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f64(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f64(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f64(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f64(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f64(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f64(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f64(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f64(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f64(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return AVXUtils::fmsub_f64(a, b, c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return AVXUtils::fnmadd_f64(a, b, c); }
+		FUNC double reduce_add(reg a) {
+			__m128d v = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+			return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+		}		FUNC double reduce_min(reg a) { return SimdSSE42<double>::reduce_min(_mm_min_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1))); }
+		FUNC double reduce_max(reg a) { return SimdSSE42<double>::reduce_max(_mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1))); }
+
+		using mask = __m256d;
+		FUNC reg floor(reg a) { return _mm256_floor_pd(a); }
+		FUNC reg round(reg a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		FUNC reg pow2i(reg n) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0))), 52)); }
+		FUNC reg ldexp(reg a, reg n) {
+			reg half = round(mul(n, _mm256_set1_pd(0.5)));
+			return mul(mul(a, pow2i(half)), pow2i(sub(n, half)));
+		}
+		FUNC reg split_exponent(reg a, reg& e) {
+			__m256i bits = _mm256_castpd_si256(a);
+			reg biased = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0))));
+			e = _mm256_sub_pd(biased, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+			return _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)), _mm256_set1_epi64x(0x3FF0000000000000ll)));
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_UNORD_Q); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+		FUNC reg select(mask m, reg a, reg b) { return AVXUtils::blend_f64(m, a, b); }
+		FUNC uint64_t bitmask(mask m) { return AVXUtils::movemask_f64(m); }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm256_castsi256_pd(AVXUtils::compress_i64(_mm256_castpd_si256(a), static_cast<uint32_t>(m))); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm256_castsi256_pd(AVXUtils::shift_up<int(Count * 8)>(_mm256_castpd_si256(a), _mm256_castpd_si256(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm256_castsi256_pd(AVXUtils::broadcast_top<8>(_mm256_castpd_si256(a))); }
+	};
+
+#ifdef __AVX512F__
+	// ================= AVX-512 (512-bit) =================
+	template <typename T>
+	struct SimdAVX512 {
+		static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "SimdAVX512 integer lanes are 8 to 64 bits wide");
+		using value_type = T;
+		using reg = __m512i;
+		static constexpr size_t lanes = avx512_lanes_v<T>;
+
+		FUNC reg load(const T* ptr) { return AVXUtils::load_i8_512(reinterpret_cast<const int8_t*>(ptr)); }
+		FUNC reg loadu(const T* ptr) { return AVXUtils::loadu_i8_512(reinterpret_cast<const int8_t*>(ptr)); }
+		FUNC void store(T* ptr, reg v) { AVXUtils::store_i8_512(reinterpret_cast<int8_t*>(ptr), v); }
+		FUNC void storeu(T* ptr, reg v) { AVXUtils::storeu_i8_512(reinterpret_cast<int8_t*>(ptr), v); }
+		FUNC void stream(T* ptr, reg v) { AVXUtils::stream_i512(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		// Masked-off lanes are fault suppressed, so a tail may end right before an unmapped page
+		FUNC reg load_partial(const T* ptr, size_t count, reg fill = zero()) {
+			uint64_t mask = (uint64_t(1) << count) - 1;
+			if constexpr (sizeof(T) == 1) return _mm512_mask_loadu_epi8(fill, static_cast<__mmask64>(mask), ptr);
+			else if constexpr (sizeof(T) == 2) return _mm512_mask_loadu_epi16(fill, static_cast<__mmask32>(mask), ptr);
+			else if constexpr (sizeof(T) == 4) return _mm512_mask_loadu_epi32(fill, static_cast<__mmask16>(mask), ptr);
+			else return _mm512_mask_loadu_epi64(fill, static_cast<__mmask8>(mask), ptr);
+		}
+		FUNC void store_partial(T* ptr, reg v, size_t count) {
+			uint64_t mask = (uint64_t(1) << count) - 1;
+			if constexpr (sizeof(T) == 1) _mm512_mask_storeu_epi8(ptr, static_cast<__mmask64>(mask), v);
+			else if constexpr (sizeof(T) == 2) _mm512_mask_storeu_epi16(ptr, static_cast<__mmask32>(mask), v);
+			else if constexpr (sizeof(T) == 4) _mm512_mask_storeu_epi32(ptr, static_cast<__mmask16>(mask), v);
+			else _mm512_mask_storeu_epi64(ptr, static_cast<__mmask8>(mask), v);
+		}
+		FUNC reg zero() { return _mm512_setzero_si512(); }
+		FUNC reg set1(T v) {
+			if constexpr (sizeof(T) == 1) return _mm512_set1_epi8(static_cast<char>(v));
+			else if constexpr (sizeof(T) == 2) return _mm512_set1_epi16(static_cast<short>(v));
+			else if constexpr (sizeof(T) == 4) return _mm512_set1_epi32(static_cast<int>(v));
+			else return _mm512_set1_epi64(static_cast<long long>(v));
+		}
+		FUNC reg add(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::add_i8_512(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::add_i16_512(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::add_i32_512(a, b);
+			else return AVXUtils::add_i64_512(a, b);
+		}
+		FUNC reg sub(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::sub_i8_512(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::sub_i16_512(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::sub_i32_512(a, b);
+			else return AVXUtils::sub_i64_512(a, b);
+		}
+		FUNC reg mul(reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return AVXUtils::mul_i8_512(a, b);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::mul_i16_512(a, b);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::mul_i32_512(a, b);
+			else return AVXUtils::mul_i64_512(a, b);
+		}
+		FUNC reg min(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_i8_512(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_i16_512(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_i32_512(a, b);
+				else return AVXUtils::min_i64_512(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::min_u8_512(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::min_u16_512(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::min_u32_512(a, b);
+				else return AVXUtils::min_u64_512(a, b);
+			}
+		}
+		FUNC reg max(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_i8_512(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_i16_512(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_i32_512(a, b);
+				else return AVXUtils::max_i64_512(a, b);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return AVXUtils::max_u8_512(a, b);
+				else if constexpr (sizeof(T) == 2) return AVXUtils::max_u16_512(a, b);
+				else if constexpr (sizeof(T) == 4) return AVXUtils::max_u32_512(a, b);
+				else return AVXUtils::max_u64_512(a, b);
+			}
+		}
+		FUNC reg abs(reg a) {
+			if constexpr (!std::is_signed_v<T>) return a;
+			else if constexpr (sizeof(T) == 1) return AVXUtils::abs_i8_512(a);
+			else if constexpr (sizeof(T) == 2) return AVXUtils::abs_i16_512(a);
+			else if constexpr (sizeof(T) == 4) return AVXUtils::abs_i32_512(a);
+			else return AVXUtils::abs_i64_512(a);
+		}
+		FUNC reg fmadd(reg a, reg b, reg c) { return add(mul(a, b), c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return sub(mul(a, b), c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return sub(c, mul(a, b)); }
+		FUNC reg sum_wide(reg a) {
+			if constexpr (sizeof(T) == 1) {
+				if constexpr (!std::is_signed_v<T>) return _mm512_sad_epu8(a, _mm512_setzero_si512());
+				reg biased = _mm512_sad_epu8(_mm512_xor_si512(a, _mm512_set1_epi8(char(0x80))), _mm512_setzero_si512());
+				return _mm512_sub_epi64(biased, _mm512_set1_epi64(8 * 128));
+			}
+			else if constexpr (sizeof(T) == 2) {
+				reg pairs = _mm512_madd_epi16(std::is_signed_v<T> ? a : _mm512_xor_si512(a, _mm512_set1_epi16(short(0x8000))), _mm512_set1_epi16(1));
+				reg wide = _mm512_add_epi64(_mm512_cvtepi32_epi64(_mm512_castsi512_si256(pairs)), _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(pairs, 1)));
+				return std::is_signed_v<T> ? wide : _mm512_add_epi64(wide, _mm512_set1_epi64(4 * 32768));
+			}
+			else if constexpr (sizeof(T) == 4) {
+				if constexpr (std::is_signed_v<T>) return _mm512_add_epi64(_mm512_cvtepi32_epi64(_mm512_castsi512_si256(a)), _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(a, 1)));
+				else return _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(a)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(a, 1)));
+			}
+			else return a;
+		}
+		FUNC T reduce_add(reg a) { return static_cast<T>(_mm512_reduce_add_epi64(sum_wide(a))); }
+		FUNC T reduce_min(reg a) { return SimdAVX2<T>::reduce_min(SimdAVX2<T>::min(_mm512_castsi512_si256(a), _mm512_extracti64x4_epi64(a, 1))); }
+		FUNC T reduce_max(reg a) { return SimdAVX2<T>::reduce_max(SimdAVX2<T>::max(_mm512_castsi512_si256(a), _mm512_extracti64x4_epi64(a, 1))); }
+
+		// One mask bit per lane, so bitmask is free
+		using mask = conditional_t<sizeof(T) == 1, __mmask64, conditional_t<sizeof(T) == 2, __mmask32, conditional_t<sizeof(T) == 4, __mmask16, __mmask8>>>;
+		template <int Predicate>
+		FUNC mask compare(reg a, reg b) {
+			if constexpr (std::is_signed_v<T>) {
+				if constexpr (sizeof(T) == 1) return _mm512_cmp_epi8_mask(a, b, Predicate);
+				else if constexpr (sizeof(T) == 2) return _mm512_cmp_epi16_mask(a, b, Predicate);
+				else if constexpr (sizeof(T) == 4) return _mm512_cmp_epi32_mask(a, b, Predicate);
+				else return _mm512_cmp_epi64_mask(a, b, Predicate);
+			}
+			else {
+				if constexpr (sizeof(T) == 1) return _mm512_cmp_epu8_mask(a, b, Predicate);
+				else if constexpr (sizeof(T) == 2) return _mm512_cmp_epu16_mask(a, b, Predicate);
+				else if constexpr (sizeof(T) == 4) return _mm512_cmp_epu32_mask(a, b, Predicate);
+				else return _mm512_cmp_epu64_mask(a, b, Predicate);
+			}
+		}
+		FUNC mask cmp_eq(reg a, reg b) { return compare<_MM_CMPINT_EQ>(a, b); }
+		FUNC mask cmp_ne(reg a, reg b) { return compare<_MM_CMPINT_NE>(a, b); }
+		FUNC mask cmp_lt(reg a, reg b) { return compare<_MM_CMPINT_LT>(a, b); }
+		FUNC mask cmp_le(reg a, reg b) { return compare<_MM_CMPINT_LE>(a, b); }
+		FUNC mask cmp_gt(reg a, reg b) { return compare<_MM_CMPINT_NLE>(a, b); }
+		FUNC mask cmp_ge(reg a, reg b) { return compare<_MM_CMPINT_NLT>(a, b); }
+		FUNC reg select(mask m, reg a, reg b) {
+			if constexpr (sizeof(T) == 1) return _mm512_mask_blend_epi8(m, b, a);
+			else if constexpr (sizeof(T) == 2) return _mm512_mask_blend_epi16(m, b, a);
+			else if constexpr (sizeof(T) == 4) return _mm512_mask_blend_epi32(m, b, a);
+			else return _mm512_mask_blend_epi64(m, b, a);
+		}
+		FUNC uint64_t bitmask(mask m) { return m; }
+		// vpcompressb/w need VBMI2, which the tier does not require
+		static constexpr bool compressible = sizeof(T) >= 4;
+		FUNC reg compress(reg a, uint64_t m) {
+			static_assert(sizeof(T) >= 4, "Only 32/64-bit lanes have a compress without VBMI2");
+			if constexpr (sizeof(T) == 4) return _mm512_maskz_compress_epi32(static_cast<__mmask16>(m), a);
+			else return _mm512_maskz_compress_epi64(static_cast<__mmask8>(m), a);
+		}
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return AVXUtils::shift_up_512<int(Count * sizeof(T))>(a, fill); }
+		FUNC reg broadcast_top(reg a) { return AVXUtils::broadcast_top_512<int(sizeof(T))>(a); }
+		static constexpr bool sortable = sizeof(T) >= 4;
+		template <size_t Xor> FUNC reg permute_xor(reg a) {
+			if constexpr (sizeof(T) == 4) return AVXUtils::permute_xor_i32_512<int(Xor)>(a);
+			else return AVXUtils::permute_xor_i64_512<int(Xor)>(a);
+		}
+		template <uint64_t Bits> FUNC reg blend_lanes(reg a, reg b) {
+			if constexpr (sizeof(T) == 4) return AVXUtils::blend_lanes_i32_512<int(Bits)>(a, b);
+			else return AVXUtils::blend_lanes_i64_512<int(Bits)>(a, b);
+		}
+#ifdef __AVX512CD__
+		static constexpr bool scatter_increments = sizeof(T) == 4;
+		FUNC void increment(uint32_t* counts, reg indices, mask valid) {
+			static_assert(sizeof(T) == 4, "Counter indices are 32-bit lanes");
+			AVXUtils::increment_i32_512(counts, indices, valid);
+		}
+#else
+		static constexpr bool scatter_increments = false;
+#endif
+		static constexpr bool gatherable = sizeof(T) >= 4;
+		static constexpr bool scatterable = sizeof(T) >= 4;
+		FUNC reg gather(const T* base, const uint32_t* indices) {
+			static_assert(sizeof(T) >= 4, "vpgatherd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) return AVXUtils::gather_i32_512(base, indices);
+			else return AVXUtils::gather_i64_512(base, indices);
+		}
+		FUNC void scatter(T* base, const uint32_t* indices, reg v) {
+			static_assert(sizeof(T) >= 4, "vpscatterd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) AVXUtils::scatter_i32_512(base, indices, v);
+			else AVXUtils::scatter_i64_512(base, indices, v);
+		}
+		FUNC reg gather_strided(const void* base, int32_t stride) {
+			static_assert(sizeof(T) >= 4, "vpgatherd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) return AVXUtils::gather_stride_i32_512(base, stride);
+			else return AVXUtils::gather_stride_i64_512(base, stride);
+		}
+		FUNC void scatter_strided(void* base, int32_t stride, reg v) {
+			static_assert(sizeof(T) >= 4, "vpscatterd* has 32/64-bit lanes only");
+			if constexpr (sizeof(T) == 4) AVXUtils::scatter_stride_i32_512(base, stride, v);
+			else AVXUtils::scatter_stride_i64_512(base, stride, v);
+		}
+		FUNC reg dot_i8(reg acc, reg a, reg b) { return AVXUtils::dot_i8_i32_512(acc, a, b); }
+		FUNC reg dot_u8i8(reg acc, reg a, reg b) { return AVXUtils::dot_u8i8_i32_512(acc, a, b); }
+	};
+
+	template <>
+	struct SimdAVX512<float> {
+		using value_type = float;
+		using reg = __m512;
+		static constexpr size_t lanes = 16;
+
+		FUNC reg load(const float* ptr) { return AVXUtils::load_f32_512(ptr); }
+		FUNC reg loadu(const float* ptr) { return AVXUtils::loadu_f32_512(ptr); }
+		FUNC void store(float* ptr, reg v) { AVXUtils::store_f32_512(ptr, v); }
+		FUNC void storeu(float* ptr, reg v) { AVXUtils::storeu_f32_512(ptr, v); }
+		FUNC void stream(float* ptr, reg v) { AVXUtils::stream_f32_512(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		FUNC reg load_partial(const float* ptr, size_t count, reg fill = zero()) { return _mm512_mask_loadu_ps(fill, static_cast<__mmask16>((1u << count) - 1), ptr); }
+		FUNC void store_partial(float* ptr, reg v, size_t count) { _mm512_mask_storeu_ps(ptr, static_cast<__mmask16>((1u << count) - 1), v); }
+		FUNC reg zero() { return _mm512_setzero_ps(); }
+		FUNC reg set1(float v) { return _mm512_set1_ps(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f32_512(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f32_512(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f32_512(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f32_512(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f32_512(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f32_512(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f32_512(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f32_512(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f32_512(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return AVXUtils::fmsub_f32_512(a, b, c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return AVXUtils::fnmadd_f32_512(a, b, c); }
+		FUNC float reduce_add(reg a) { return _mm512_reduce_add_ps(a); }		FUNC float reduce_min(reg a) { return _mm512_reduce_min_ps(a); }
+		FUNC float reduce_max(reg a) { return _mm512_reduce_max_ps(a); }
+
+		using mask = __mmask16;
+		FUNC reg floor(reg a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+		FUNC reg round(reg a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		FUNC reg ldexp(reg a, reg n) { return _mm512_scalef_ps(a, n); }
+		FUNC reg split_exponent(reg a, reg& e) {
+			e = _mm512_getexp_ps(a);
+			return _mm512_getmant_ps(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+		FUNC reg select(mask m, reg a, reg b) { return _mm512_mask_blend_ps(m, b, a); }
+		FUNC uint64_t bitmask(mask m) { return m; }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm512_maskz_compress_ps(static_cast<__mmask16>(m), a); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm512_castsi512_ps(AVXUtils::shift_up_512<int(Count * 4)>(_mm512_castps_si512(a), _mm512_castps_si512(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm512_castsi512_ps(AVXUtils::broadcast_top_512<4>(_mm512_castps_si512(a))); }
+		FUNC reg load_f16(const uint16_t* ptr) { return AVXUtils::cvt_f16_f32_512(ptr); }
+		FUNC void store_f16(uint16_t* ptr, reg v) { AVXUtils::cvt_f32_f16_512(ptr, v); }
+		FUNC reg load_bf16(const uint16_t* ptr) { return AVXUtils::cvt_bf16_f32_512(ptr); }
+		FUNC void store_bf16(uint16_t* ptr, reg v) { AVXUtils::cvt_f32_bf16_512(ptr, v); }
+		FUNC reg load_i8(const int8_t* ptr) { return AVXUtils::cvt_i8_f32_512(ptr); }
+		FUNC reg load_u8(const uint8_t* ptr) { return AVXUtils::cvt_u8_f32_512(ptr); }
+		FUNC void store_i8(int8_t* ptr, reg v) { AVXUtils::cvt_f32_i8_512(ptr, v); }
+		FUNC void store_u8(uint8_t* ptr, reg v) { AVXUtils::cvt_f32_u8_512(ptr, v); }
+	};
+
+	template <>
+	struct SimdAVX512<double> {
+		using value_type = double;
+		using reg = __m512d;
+		static constexpr size_t lanes = 8;
+
+		FUNC reg load(const double* ptr) { return AVXUtils::load_f64_512(ptr); }
+		FUNC reg loadu(const double* ptr) { return AVXUtils::loadu_f64_512(ptr); }
+		FUNC void store(double* ptr, reg v) { AVXUtils::store_f64_512(ptr, v); }
+		FUNC void storeu(double* ptr, reg v) { AVXUtils::storeu_f64_512(ptr, v); }
+		FUNC void stream(double* ptr, reg v) { AVXUtils::stream_f64_512(ptr, v); }
+		FUNC void fence() { AVXUtils::sfence(); }
+		FUNC reg load_partial(const double* ptr, size_t count, reg fill = zero()) { return _mm512_mask_loadu_pd(fill, static_cast<__mmask8>((1u << count) - 1), ptr); }
+		FUNC void store_partial(double* ptr, reg v, size_t count) { _mm512_mask_storeu_pd(ptr, static_cast<__mmask8>((1u << count) - 1), v); }
+		FUNC reg zero() { return _mm512_setzero_pd(); }
+		FUNC reg set1(double v) { return _mm512_set1_pd(v); }
+		FUNC reg add(reg a, reg b) { return AVXUtils::add_f64_512(a, b); }
+		FUNC reg sub(reg a, reg b) { return AVXUtils::sub_f64_512(a, b); }
+		FUNC reg mul(reg a, reg b) { return AVXUtils::mul_f64_512(a, b); }
+		FUNC reg div(reg a, reg b) { return AVXUtils::div_f64_512(a, b); }
+		FUNC reg min(reg a, reg b) { return AVXUtils::min_f64_512(a, b); }
+		FUNC reg max(reg a, reg b) { return AVXUtils::max_f64_512(a, b); }
+		FUNC reg abs(reg a) { return AVXUtils::abs_f64_512(a); }
+		FUNC reg sqrt(reg a) { return AVXUtils::sqrt_f64_512(a); }
+		FUNC reg fmadd(reg a, reg b, reg c) { return AVXUtils::fmadd_f64_512(a, b, c); }
+		FUNC reg fmsub(reg a, reg b, reg c) { return AVXUtils::fmsub_f64_512(a, b, c); }
+		FUNC reg fnmadd(reg a, reg b, reg c) { return AVXUtils::fnmadd_f64_512(a, b, c); }
+		FUNC double reduce_add(reg a) { return _mm512_reduce_add_pd(a); }		FUNC double reduce_min(reg a) { return _mm512_reduce_min_pd(a); }
+		FUNC double reduce_max(reg a) { return _mm512_reduce_max_pd(a); }
+
+		using mask = __mmask8;
+		FUNC reg floor(reg a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+		FUNC reg round(reg a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		FUNC reg ldexp(reg a, reg n) { return _mm512_scalef_pd(a, n); }
+		FUNC reg split_exponent(reg a, reg& e) {
+			e = _mm512_getexp_pd(a);
+			return _mm512_getmant_pd(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);
+		}
+		FUNC mask cmp_lt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+		FUNC mask cmp_le(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+		FUNC mask cmp_eq(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+		FUNC mask cmp_unord(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q); }
+		FUNC mask cmp_ne(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+		FUNC mask cmp_gt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+		FUNC mask cmp_ge(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+		FUNC reg select(mask m, reg a, reg b) { return _mm512_mask_blend_pd(m, b, a); }
+		FUNC uint64_t bitmask(mask m) { return m; }
+		static constexpr bool compressible = true;
+		FUNC reg compress(reg a, uint64_t m) { return _mm512_maskz_compress_pd(static_cast<__mmask8>(m), a); }
+		template <size_t Count> FUNC reg shift_up(reg a, reg fill) { return _mm512_castsi512_pd(AVXUtils::shift_up_512<int(Count * 8)>(_mm512_castpd_si512(a), _mm512_castpd_si512(fill))); }
+		FUNC reg broadcast_top(reg a) { return _mm512_castsi512_pd(AVXUtils::broadcast_top_512<8>(_mm512_castpd_si512(a))); }
+	};
+#endif
+
+	// Widest tier the including translation unit is compiled for. Header-only code that cannot go through Dispatch
+	// (expression templates) evaluates with this; precompiled kernels never do.
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+	template <typename T> using Simd = SimdAVX512<T>;
+#elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+	template <typename T> using Simd = SimdAVX2<T>;
+#elif defined(__SSE4_2__)
+	template <typename T> using Simd = SimdSSE42<T>;
+#else
+	template <typename T> using Simd = SimdScalar<T>;
+#endif
+
+	// Element-wise operations as types, so kernels and expression templates can be parameterized on them
+	struct SimdAdd { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::add(a, b); } };
+	struct SimdSub { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::sub(a, b); } };
+	struct SimdMul { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::mul(a, b); } };
+	struct SimdDiv { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::div(a, b); } };
+	struct SimdMin { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::min(a, b); } };
+	struct SimdMax { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return S::max(a, b); } };
+	struct SimdAbs { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return S::abs(a); } };
+	struct SimdSqrt { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return S::sqrt(a); } };
+
+	// Predicates as types, apply returns the tier's mask
+	struct SimdCmpEq { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_eq(a, b); } };
+	struct SimdCmpNe { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_ne(a, b); } };
+	struct SimdCmpLt { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_lt(a, b); } };
+	struct SimdCmpLe { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_le(a, b); } };
+	struct SimdCmpGt { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_gt(a, b); } };
+	struct SimdCmpGe { template <typename S> FUNC typename S::mask apply(typename S::reg a, typename S::reg b) { return S::cmp_ge(a, b); } };
+}
@@ -0,0 +1,257 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "Simd.h"
+
+namespace devsw::stl {
+	/**
+	* Vectorized transcendentals, written once against the tier surface in Simd.h so every tier (scalar, SSE4.2,
+	* AVX2, AVX-512) and both float and double get the same algorithm. Each function takes and returns one register:
+	*     auto y = SimdMath::exp<SimdAVX2<float>>(x);
+	* Argument reduction is Cody-Waite with the constant split so that n * C_hi is exact, followed by a minimax or Pade
+	* polynomial (Cephes/fdlibm coefficients) and a reconstruction through S::ldexp. sin and cos split pi / 2 into four
+	* parts short enough that j times each is exact with or without FMA, so the reduction stays exact near their zeros.
+	*
+	* Maximum error against a long double reference, in ULP of the result type. sin and cos were sampled uniformly and
+	* around every zero of the range, on the scalar, SSE4.2, AVX2 and AVX-512 tiers:
+	*     function   float   double   range
+	*     exp        1       2        full, overflows to inf above ~88.7 / ~709.8, denormals below
+	*     log        1       1.5      full, 0 -> -inf, x < 0 -> NaN, inf -> inf
+	*     log2       2       2        as log
+	*     sin, cos   2.5     1.6      |x| < 39000 (float), |x| < 1e6 (double); double 2.3 by 1e8, float past 5e4 only
+	*                                 holds with FMA (AVX2, AVX-512)
+	*     tanh       1.5     1.5      full
+	*     sigmoid    2.5     2.5      full, large negative x rounds into the denormals rather than to 0
+	*     erf        3       3        full
+	*     pow        2 + 1.5 |y log2 x|   x < 0 -> NaN, y == 0 or x == 1 -> 1
+	* NaN inputs propagate through every function.
+	* @note pow is exp(y * log(x)) in the working precision, so its error grows with the magnitude of the exponent it
+	* feeds to exp. Fine for gamma curves and softmax temperatures, not for 1.0001^100000.
+	*/
+	struct devswSTL SimdMath {
+		// c[0] * x^(N-1) + ... + c[N-1], Horner with FMA
+		template <typename S, size_t N>
+		FUNC typename S::reg polynomial(typename S::reg x, const typename S::value_type (&c)[N]) {
+			typename S::reg y = S::set1(c[0]);
+			for (size_t i = 1; i < N; ++i) y = S::fmadd(y, x, S::set1(c[i]));
+			return y;
+		}
+
+		template <typename S>
+		FUNC typename S::reg exp(typename S::reg x) {
+			using T = typename S::value_type;
+			using reg = typename S::reg;
+			constexpr bool single = is_same_v<T, float>;
+			// Past these exp is inf or 0 anyway; the operand order keeps a NaN x
+			x = S::max(S::set1(single ? T(-104) : T(-746)), S::min(S::set1(single ? T(89) : T(710)), x));
+			reg n = S::round(S::mul(x, S::set1(T(1.44269504088896340736))));
+			reg r;
+			if constexpr (single) {
+				r = S::fnmadd(n, S::set1(0.693359375f), x);
+				r = S::fnmadd(n, S::set1(-2.12194440e-4f), r);
+				reg p = polynomial<S>(r, { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f });
+				r = S::add(S::fmadd(p, S::mul(r, r), r), S::set1(1.0f));
+			}
+			else {
+				r = S::fnmadd(n, S::set1(6.93145751953125e-1), x);
+				r = S::fnmadd(n, S::set1(1.42860682030941723212e-6), r);
+				// Pade form 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+				reg rr = S::mul(r, r);
+				reg p = S::mul(r, polynomial<S>(rr, { 1.26177193074810590878e-4, 3.02994407707441961300e-2, 9.99999999999999999910e-1 }));
+				reg q = polynomial<S>(rr, { 3.00198505138664455042e-6, 2.52448340349684104192e-3, 2.27265548208155028766e-1, 2.0 });
+				r = S::fmadd(S::set1(2.0), S::div(p, S::sub(q, p)), S::set1(1.0));
+			}
+			return S::ldexp(r, n);
+		}
+
+		// log(x) = e * ln2 + log(m) with m in [sqrt(2)/2, sqrt(2)), log(m) split as f - f^2/2 + s (f^2/2 + R(s^2)), s = f / (2 + f).
+		// Returns the pieces so log2 can scale the small part instead of the whole result.
+		template <typename S>
+		FUNC typename S::reg log_mantissa(typename S::reg x, typename S::reg& e) {
+			using T = typename S::value_type;
+			using reg = typename S::reg;
+			constexpr bool single = is_same_v<T, float>;
+			// Bring denormals into the normal range first, the bit tricks in split_exponent assume a biased exponent
+			typename S::mask tiny = S::cmp_lt(x, S::set1(std::numeric_limits<T>::min()));
+			x = S::select(tiny, S::mul(x, S::set1(single ? T(33554432.0) : T(18014398509481984.0))), x);
+			reg m = S::split_exponent(x, e);
+			e = S::select(tiny, S::sub(e, S::set1(single ? T(25) : T(54))), e);
+			typename S::mask big = S::cmp_lt(S::set1(T(1.41421356237309504880)), m);
+			m = S::select(big, S::mul(m, S::set1(T(0.5))), m);
+			e = S::select(big, S::add(e, S::set1(T(1))), e);
+
+			reg f = S::sub(m, S::set1(T(1)));
+			reg s = S::div(f, S::add(f, S::set1(T(2))));
+			reg z = S::mul(s, s);
+			reg R;
+			if constexpr (single)
+				R = S::mul(z, polynomial<S>(z, { 0.24279078841f, 0.28498786688f, 0.40000972152f, 0.66666662693f }));
+			else
+				R = S::mul(z, polynomial<S>(z, { 1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01,
+					2.222219843214978396e-01, 2.857142874366239149e-01, 3.999999999940941908e-01, 6.666666666666735130e-01 }));
+			reg hfsq = S::mul(S::set1(T(0.5)), S::mul(f, f));
+			return S::sub(f, S::fnmadd(s, S::add(hfsq, R), hfsq));
+		}
+
+		// 0 -> -inf, x < 0 -> NaN, inf -> inf, NaN -> NaN
+		template <typename S>
+		FUNC typename S::reg log_special(typename S::reg x, typename S::reg y) {
+			using T = typename S::value_type;
+			y = S::select(S::cmp_lt(x, S::zero()), S::set1(std::numeric_limits<T>::quiet_NaN()), y);
+			y = S::select(S::cmp_eq(x, S::zero()), S::set1(-std::numeric_limits<T>::infinity()), y);
+			y = S::select(S::cmp_eq(x, S::set1(std::numeric_limits<T>::infinity())), x, y);
+			return S::select(S::cmp_unord(x, x), x, y);
+		}
+
+		template <typename S>
+		FUNC typename S::reg log(typename S::reg x) {
+			using T = typename S::value_type;
+			constexpr bool single = is_same_v<T, float>;
+			typename S::reg e;
+			typename S::reg lm = log_mantissa<S>(x, e);
+			// ln2 = hi + lo with e * hi exact
+			lm = S::fmadd(e, S::set1(single ? T(9.0580006145e-06) : T(1.90821492927058770002e-10)), lm);
+			return log_special<S>(x, S::fmadd(e, S::set1(single ? T(6.9313812256e-01) : T(6.93147180369123816490e-01)), lm));
+		}
+
+		template <typename S>
+		FUNC typename S::reg log2(typename S::reg x) {
+			using T = typename S::value_type;
+			typename S::reg e;
+			typename S::reg lm = log_mantissa<S>(x, e);
+			return log_special<S>(x, S::fmadd(lm, S::set1(T(1.44269504088896340736)), e));
+		}
+
+		// Shared body of sin and cos: j = round(x * 2 / pi), r = x - j * pi / 2 in four parts, then the quadrant
+		// (j + offset) mod 4 picks the sin or cos polynomial and the sign
+		template <typename S>
+		FUNC typename S::reg sincos(typename S::reg x, typename S::value_type offset) {
+			using T = typename S::value_type;
+			using reg = typename S::reg;
+			constexpr bool single = is_same_v<T, float>;
+			reg j = S::round(S::mul(x, S::set1(T(0.63661977236758134308))));
+			reg r;
+			if constexpr (single) {
+				r = S::fnmadd(j, S::set1(1.5703125f), x);
+				r = S::fnmadd(j, S::set1(4.8351287841796875e-4f), r);
+				r = S::fnmadd(j, S::set1(3.1385570764541625977e-7f), r);
+				r = S::fnmadd(j, S::set1(6.0771006282767103810e-11f), r);
+			}
+			else {
+				r = S::fnmadd(j, S::set1(1.5707963109016418457e0), x);
+				r = S::fnmadd(j, S::set1(1.5893254712295856735e-8), r);
+				r = S::fnmadd(j, S::set1(6.1232339320535942510e-17), r);
+				r = S::fnmadd(j, S::set1(6.3683171635109499079e-25), r);
+			}
+			j = S::add(j, S::set1(offset));
+			reg q = S::fnmadd(S::set1(T(4)), S::floor(S::mul(j, S::set1(T(0.25)))), j);
+
+			reg z = S::mul(r, r);
+			reg sin_r, cos_r;
+			if constexpr (single) {
+				sin_r = S::fmadd(S::mul(polynomial<S>(z, { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f }), z), r, r);
+				cos_r = S::fmadd(polynomial<S>(z, { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f }), S::mul(z, z),
+					S::fnmadd(S::set1(0.5f), z, S::set1(1.0f)));
+			}
+			else {
+				sin_r = S::fmadd(S::mul(polynomial<S>(z, { 1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+					-1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1 }), z), r, r);
+				cos_r = S::fmadd(polynomial<S>(z, { -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+					2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2 }), S::mul(z, z),
+					S::fnmadd(S::set1(0.5), z, S::set1(1.0)));
+			}
+			// q is 0, 1, 2 or 3: odd quadrants take the cofunction, the upper two flip the sign
+			reg half = S::floor(S::mul(q, S::set1(T(0.5))));
+			reg y = S::select(S::cmp_eq(S::fnmadd(S::set1(T(2)), half, q), S::zero()), sin_r, cos_r);
+			return S::select(S::cmp_eq(half, S::zero()), y, S::sub(S::zero(), y));
+		}
+
+		template <typename S>
+		FUNC typename S::reg sin(typename S::reg x) { return sincos<S>(x, 0); }
+
+		template <typename S>
+		FUNC typename S::reg cos(typename S::reg x) { return sincos<S>(x, 1); }
+
+		template <typename S>
+		FUNC typename S::reg tanh(typename S::reg x) {
+			using T = typename S::value_type;
+			using reg = typename S::reg;
+			reg a = S::abs(x);
+			// Near zero 1 - 2 / (e^2x + 1) cancels, use the odd series there
+			reg z = S::mul(x, x);
+			reg small;
+			if constexpr (is_same_v<T, float>) {
+				small = S::fmadd(S::mul(polynomial<S>(z, { -5.70498872745e-3f, 2.06390887954e-2f, -5.37397155531e-2f, 1.33314422036e-1f, -3.33332819422e-1f }), z), x, x);
+			}
+			else {
+				reg p = polynomial<S>(z, { -9.64399179425052238628e-1, -9.92877231001918586564e1, -1.61468768441708447952e3 });
+				reg q = polynomial<S>(z, { 1.0, 1.12811678491632931402e2, 2.23548839060100448583e3, 4.84406305325125486048e3 });
+				small = S::fmadd(S::mul(S::div(p, q), z), x, x);
+			}
+			reg large = S::sub(S::set1(T(1)), S::div(S::set1(T(2)), S::add(exp<S>(S::add(a, a)), S::set1(T(1)))));
+			large = S::select(S::cmp_lt(x, S::zero()), S::sub(S::zero(), large), large);
+			return S::select(S::cmp_lt(a, S::set1(T(0.625))), small, large);
+		}
+
+		// 1 / (1 + e^-x) for x >= 0 and e^x / (1 + e^x) below, so the exp never overflows and large negative x rounds to
+		// the right denormal instead of 1 / inf
+		template <typename S>
+		FUNC typename S::reg sigmoid(typename S::reg x) {
+			using T = typename S::value_type;
+			typename S::reg e = exp<S>(S::sub(S::zero(), S::abs(x)));
+			typename S::reg one = S::set1(T(1));
+			return S::div(S::select(S::cmp_lt(x, S::zero()), e, one), S::add(one, e));
+		}
+
+		template <typename S>
+		FUNC typename S::reg erf(typename S::reg x) {
+			using T = typename S::value_type;
+			using reg = typename S::reg;
+			reg a = S::abs(x);
+			reg z = S::mul(x, x);
+			reg small;
+			if constexpr (is_same_v<T, float>)
+				small = S::mul(x, polynomial<S>(z, { 7.853861353153693e-5f, -8.010193625184903e-4f, 5.188327685732524e-3f,
+					-2.685381193529856e-2f, 1.128358514861418e-1f, -3.761262582423300e-1f, 1.128379165726710e+0f }));
+			else
+				small = S::div(S::mul(x, polynomial<S>(z, { 9.60497373987051638749e0, 9.00260197203842689217e1, 2.23200534594684319226e3,
+					7.00332514112805075473e3, 5.55923013010394962768e4 })), polynomial<S>(z, { 1.0, 3.35617141647503099647e1,
+					5.21357949780152679795e2, 4.59432382970980127987e3, 2.26290000613890934246e4, 4.92673942608635921086e4 }));
+			// erfc(a) = exp(-a^2) P(a) / Q(a), every coefficient positive so Horner stays stable in float as well. Past 4
+			// (float) or 8 (double) erfc is below half an ulp of 1, so a is clamped there.
+			reg c = S::min(S::set1(is_same_v<T, float> ? T(4) : T(8)), a);
+			reg p = polynomial<S>(c, { T(2.46196981473530512524e-10), T(5.64189564831068821977e-1), T(7.46321056442269912687e0),
+				T(4.86371970985681366614e1), T(1.96520832956077098242e2), T(5.26445194995477358631e2), T(9.34528527171957607540e2),
+				T(1.02755188689515710272e3), T(5.57535335369399327526e2) });
+			reg q = polynomial<S>(c, { T(1.0), T(1.32281951154744992508e1), T(8.67072140885989742329e1), T(3.54937778887819891062e2),
+				T(9.75708501743205489753e2), T(1.82390916687909736289e3), T(2.24633760818710981792e3), T(1.65666309194161350182e3),
+				T(5.57535340817727675546e2) });
+			reg tail = S::div(S::mul(exp<S>(S::sub(S::zero(), S::mul(c, c))), p), q);
+			reg large = S::sub(S::set1(T(1)), tail);
+			large = S::select(S::cmp_lt(x, S::zero()), S::sub(S::zero(), large), large);
+			// a NaN fails the compare and travels through the tail branch
+			return S::select(S::cmp_lt(a, S::set1(T(1))), small, large);
+		}
+
+		template <typename S>
+		FUNC typename S::reg pow(typename S::reg x, typename S::reg y) {
+			using T = typename S::value_type;
+			typename S::reg one = S::set1(T(1));
+			typename S::reg r = exp<S>(S::mul(y, log<S>(x)));
+			return S::select(S::cmp_eq(y, S::zero()), one, S::select(S::cmp_eq(x, one), one, r));
+		}
+	};
+
+	struct SimdExp { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::exp<S>(a); } };
+	struct SimdLog { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::log<S>(a); } };
+	struct SimdLog2 { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::log2<S>(a); } };
+	struct SimdSin { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::sin<S>(a); } };
+	struct SimdCos { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::cos<S>(a); } };
+	struct SimdTanh { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::tanh<S>(a); } };
+	struct SimdSigmoid { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::sigmoid<S>(a); } };
+	struct SimdErf { template <typename S> FUNC typename S::reg apply(typename S::reg a) { return SimdMath::erf<S>(a); } };
+	struct SimdPow { template <typename S> FUNC typename S::reg apply(typename S::reg a, typename S::reg b) { return SimdMath::pow<S>(a, b); } };
+}
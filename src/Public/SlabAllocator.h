@@ -0,0 +1,109 @@
+#pragma once
+
+#include "devswSTL.h"
+#include "Allocators.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace devsw::stl {
+	/**
+	* General-purpose byte heap for node-heavy containers, segregated by size so nodes of one size share slabs instead
+	* of fragmenting malloc's arenas.
+	* - 44 geometric size classes from 8 B to 32 KiB, four per power of two (8, 16, 24, 32, 40, 48, 56, 64, 80, 96...).
+	* - Each class carves SLAB_SIZE-aligned slabs mapped straight from the OS (see Pages), created on demand. A slab
+	*   header keeps an occupancy bitmap, so a free is a mask, a multiply and a bit clear.
+	* - A slab whose last block is freed goes back to the OS, except one per class kept for the next allocation.
+	* - Above 32 KiB every allocation is a mapping of its own, unmapped when freed.
+	* Blocks are aligned to the largest power of two dividing their class size, and every class a type rounds up to is a
+	* multiple of its alignment. Large allocations are 64-byte aligned.
+	* @note Not synchronized, like BlockAllocator: one heap per thread, or ConcurrentPoolAllocator for a shared one.
+	* deallocate must get the size the block was allocated with, or at least one on the same side of MAX_SIZE.
+	*/
+	class devswSTL SlabHeap {
+	public:
+		static constexpr size_t MIN_SIZE = allocators::MIN_CLASS_SIZE;
+		static constexpr size_t MAX_SIZE = allocators::MAX_CLASS_SIZE;
+		static constexpr size_t CLASS_COUNT = allocators::CLASS_COUNT;
+		static constexpr size_t SLAB_SIZE = 256 * 1024;
+
+		SlabHeap();
+		~SlabHeap();
+		SlabHeap(const SlabHeap&) = delete;
+		SlabHeap& operator=(const SlabHeap&) = delete;
+
+		// nullptr when the OS is out of memory
+		void* allocate(size_t bytes);
+		void deallocate(void* p, size_t bytes);
+
+		// Index of the smallest class holding bytes (1 to MAX_SIZE), and the size of a class
+		static constexpr size_t size_class(size_t bytes) { return allocators::size_class(bytes); }
+		static constexpr size_t class_size(size_t index) { return allocators::class_size(index); }
+
+		// Slabs and large mappings are the chunks. Empty unless built with DEVSW_ALLOCATOR_STATS
+		AllocatorSnapshot stats() const { return stats_.snapshot(); }
+
+	private:
+		struct Slab;
+		struct Large;
+
+		struct SizeClass {
+			Slab* partial; // Some blocks free, allocated from first
+			Slab* full;
+			Slab* spare;   // Empty, kept so a class hovering around a slab boundary does not map and unmap every time
+		};
+
+		Slab* new_slab(size_t index);
+		void release(Slab* slab);
+		void* allocate_large(size_t bytes);
+		void deallocate_large(void* p);
+
+		SizeClass classes_[CLASS_COUNT];
+		Large* large_;
+		AllocatorStats stats_;
+	};
+
+	/**
+	* Allocator<T> over a SlabHeap, any n. Owns a heap of its own by default; or shares one with other SlabAllocators,
+	* so the nodes of several containers (or of several node types, through rebind) fill the same slabs.
+	* @note A copy shares the heap of the original without owning it, the original must outlive it.
+	*/
+	template <typename T>
+	class devswSTL SlabAllocator final : public Allocator<T> {
+	public:
+		SlabAllocator() : heap_(new SlabHeap()), owned_(true) {}
+		explicit SlabAllocator(SlabHeap& heap) noexcept : heap_(&heap), owned_(false) {}
+		SlabAllocator(const SlabAllocator& other) noexcept : heap_(other.heap_), owned_(false) {}
+		template <typename U>
+		SlabAllocator(const SlabAllocator<U>& other) noexcept : heap_(other.heap()), owned_(false) {}
+		SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+		~SlabAllocator() noexcept override {
+			if (owned_) delete heap_;
+		}
+
+		T* allocate(size_t n) override {
+			if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+			void* p = heap_->allocate(n * sizeof(T));
+			if (!p) throw std::bad_alloc();
+			return static_cast<T*>(p);
+		}
+
+		void deallocate(T* p, size_t n) noexcept override {
+			heap_->deallocate(p, n * sizeof(T));
+		}
+
+		SlabHeap* heap() const { return heap_; }
+		// The heap's counters, shared with every allocator on it
+		AllocatorSnapshot stats() const { return heap_->stats(); }
+
+		template <typename U>
+		struct rebind {
+			using other = SlabAllocator<U>;
+		};
+
+	private:
+		SlabHeap* heap_;
+		bool owned_;
+	};
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+
+#include "devswSTL.h"
+
+namespace devsw::stl {
+	/**
+	* The library's persistent worker pool. Threads are started on first use and parked on a condition variable
+	* between jobs, so a parallel kernel pays a wake-up rather than a thread creation.
+	* run() hands out chunk indices from a shared counter; the calling thread works through chunks too, which keeps a
+	* pool of N - 1 workers from idling one core. Jobs are serialized: a second caller waits for the running job.
+	* @note Calling run() from inside a task runs the nested job serially on that thread instead of deadlocking.
+	* DEVSW_THREADS=n in the environment overrides the default of std::thread::hardware_concurrency().
+	*/
+	struct devswSTL ThreadPool {
+		using Task = void (*)(void* context, size_t chunk);
+
+		// Calls task(context, chunk) once for every chunk in [0, chunks) and returns when all of them finished
+		static void run(size_t chunks, Task task, void* context);
+
+		template <typename F>
+		static void run(size_t chunks, F& body) {
+			run(chunks, [](void* context, size_t chunk) { (*static_cast<F*>(context))(chunk); }, &body);
+		}
+
+		// Threads taking part in a job, the caller included
+		static size_t concurrency();
+		// Joins the current workers and restarts with threads - 1 of them. Not meant to race with run().
+		static void set_concurrency(size_t threads);
+	};
+}
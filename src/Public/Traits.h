@@ -50,6 +50,14 @@ namespace devsw::stl {
 	};
 	template <typename T> inline constexpr bool is_trivially_destructible_v = is_trivially_destructible<T>::value;
 
+	//Is trivially relocatable
+	// Moving to new storage and destroying the source is the same as copying the bytes. Trivially move constructible
+	// and destructible types are; others opt in with DEVSW_TRIVIALLY_RELOCATABLE when none of their members point
+	// into the object itself (std::unique_ptr, most handle structs, but not every std::string)
+	template <typename T> struct is_trivially_relocatable
+		: BoolConstant<__is_trivially_constructible(T, T&&) && __is_trivially_destructible(T)> {};
+	template <typename T> inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 	//Remove const
 	template <typename T> struct remove_const { using type = T; };
 	template <typename T> struct remove_const<const T> { using type = T; };
@@ -108,6 +116,22 @@ namespace devsw::stl {
 	struct is_numeric : BoolConstant<is_floating_point_v<T> || is_integral_v<T>> {};
 	template <typename T> inline constexpr bool is_numeric_v = is_numeric<T>::value;
 
+	//Is signed (numeric types only)
+	template <typename T> struct is_signed : BoolConstant<is_floating_point_v<T> || (is_integral_v<T> && T(-1) < T(0))> {};
+	template <typename T> inline constexpr bool is_signed_v = is_signed<T>::value;
+
+	//Reduction result types: integer sums widen to 64 bits, statistics are float for float and double otherwise
+	template <typename T> using sum_t = conditional_t<is_floating_point_v<T>, T, conditional_t<is_signed_v<T>, int64_t, uint64_t>>;
+	template <typename T> using real_t = conditional_t<is_same_v<T, float>, float, double>;
+
+	//Is half float, the 16-bit storage types of Float16.h. Storable in an AlignedVector, not numeric
+	struct float16;
+	struct bfloat16;
+	template <typename T> struct is_half_float : FalseType {};
+	template <> struct is_half_float<float16> : TrueType {};
+	template <> struct is_half_float<bfloat16> : TrueType {};
+	template <typename T> inline constexpr bool is_half_float_v = is_half_float<T>::value;
+
 	template <typename T> struct avx_lanes { static constexpr size_t value = 0; };
 	template <> struct avx_lanes<float> { static constexpr size_t value = 8; };
 	template <> struct avx_lanes<double> { static constexpr size_t value = 4; };
@@ -119,6 +143,8 @@ namespace devsw::stl {
 	template <> struct avx_lanes<uint32_t> { static constexpr size_t value = 8; };
 	template <> struct avx_lanes<int64_t> { static constexpr size_t value = 4; };
 	template <> struct avx_lanes<uint64_t> { static constexpr size_t value = 4; };
+	template <> struct avx_lanes<float16> { static constexpr size_t value = 16; };
+	template <> struct avx_lanes<bfloat16> { static constexpr size_t value = 16; };
 	template <typename T> inline constexpr size_t avx_lanes_v = avx_lanes<T>::value;
 
 	template <typename T> struct avx512_lanes { static constexpr size_t value = 0; };
@@ -132,9 +158,15 @@ namespace devsw::stl {
 	template <> struct avx512_lanes<uint32_t> { static constexpr size_t value = 16; };
 	template <> struct avx512_lanes<int64_t> { static constexpr size_t value = 8; };  
 	template <> struct avx512_lanes<uint64_t> { static constexpr size_t value = 8; };
+	template <> struct avx512_lanes<float16> { static constexpr size_t value = 32; };
+	template <> struct avx512_lanes<bfloat16> { static constexpr size_t value = 32; };
 	template <typename T> inline constexpr size_t avx512_lanes_v = avx512_lanes<T>::value;
 
 	template <typename T>
 	struct is_avx_supported : BoolConstant<avx_lanes_v<T> != 0> {};
 	template <typename T> inline constexpr bool is_avx_supported_v = is_avx_supported<T>::value;
 }
+
+// Opts a type in to is_trivially_relocatable, at global scope: DEVSW_TRIVIALLY_RELOCATABLE(my::Handle)
+#define DEVSW_TRIVIALLY_RELOCATABLE(...) \
+	namespace devsw::stl { template <> struct is_trivially_relocatable<__VA_ARGS__> : TrueType {}; }
@@ -0,0 +1,251 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+#include "devswSTL.h"
+#include "Traits.h"
+#include "AlignedVector.h"
+#include "MappedVector.h"
+#include "Dispatch.h"
+
+namespace devsw::stl {
+	/**
+	* Non-owning contiguous view, the zero-copy Intrinsics operand for memory no AlignedVector owns: a sub-range of a
+	* vector, a network buffer, a memory mapped file. T is const for read-only operands.
+	* Any address works. The element-wise kernels peel the elements before the first register boundary of the
+	* destination off as one masked step, so their main loop still stores whole aligned registers.
+	* @note A view owns no padding, so the kernels always finish it with a masked tail step instead of running over
+	* aligned_size() as they do for AlignedVector. A view cannot grow: resize only narrows it.
+	*/
+	template <typename T>
+	class AlignedSpan {
+		using value_type = remove_const_t<T>;
+
+	public:
+		AlignedSpan() : data_(nullptr), size_(0) {}
+		AlignedSpan(T* data, size_t size) : data_(data), size_(size) {}
+		AlignedSpan(AlignedVector<value_type>& vector) : data_(vector.begin()), size_(vector.get_size()) {}
+		template <typename U = T, typename = enable_if_t<is_const_v<U>, void>>
+		AlignedSpan(const AlignedVector<value_type>& vector) : data_(vector.begin()), size_(vector.get_size()) {}
+		// Read-only view of a mutable one
+		template <typename U = T, typename = enable_if_t<is_const_v<U>, void>>
+		AlignedSpan(const AlignedSpan<value_type>& other) : data_(other.begin()), size_(other.get_size()) {}
+
+		// Accessors
+		T* begin() const { return data_; }
+		T* end() const { return data_ + size_; }
+		size_t get_size() const { return size_; }
+		bool is_aligned(size_t alignment = 64) const { return reinterpret_cast<uintptr_t>(data_) % alignment == 0; }
+
+		// Element access
+		T& operator[](size_t i) const { return data_[i]; }
+
+		// Elements [offset, offset + count) of this view
+		AlignedSpan subspan(size_t offset, size_t count) const {
+			if (offset > size_ || count > size_ - offset) {
+				//TODO Errors...
+			}
+			return AlignedSpan(data_ + offset, count);
+		}
+
+		// Lets the Intrinsics that size their output write into a view, which must already be long enough
+		void resize(size_t new_size) {
+			if (new_size > size_) {
+				//TODO Errors...
+				return;
+			}
+			size_ = new_size;
+		}
+
+	private:
+		T* data_;
+		size_t size_;
+	};
+
+	template <typename T> AlignedSpan(AlignedVector<T>&) -> AlignedSpan<T>;
+	template <typename T> AlignedSpan(const AlignedVector<T>&) -> AlignedSpan<const T>;
+
+	/**
+	* Non-owning strided view, element i at data + i * stride bytes: one field of an array of records, every k-th
+	* sample of an interleaved stream. The stride is in bytes so packed records of any size work, and may be negative.
+	* Elements need no alignment at all.
+	* @note Intrinsics stage a strided operand through contiguous scratch for the length of one call: one vector gather
+	* per register to load it and, when it is the call's destination, one scatter per register to write it back (AVX-512,
+	* scalar stores below that).
+	*/
+	template <typename T>
+	class StridedView {
+		using value_type = remove_const_t<T>;
+		using byte_type = conditional_t<is_const_v<T>, const char, char>;
+
+	public:
+		StridedView(T* data, size_t size, ptrdiff_t stride) : data_(data), size_(size), stride_(stride) {}
+		// One field of size records, e.g. StridedView(quotes, n, &Quote::price)
+		template <typename R>
+		StridedView(R* records, size_t size, value_type remove_const_t<R>::* field)
+			: data_(&(records->*field)), size_(size), stride_(static_cast<ptrdiff_t>(sizeof(R))) {}
+
+		// Accessors
+		T* data() const { return data_; }
+		size_t get_size() const { return size_; }
+		ptrdiff_t get_stride() const { return stride_; }
+		bool is_contiguous() const { return stride_ == static_cast<ptrdiff_t>(sizeof(T)); }
+
+		// Element access, memcpy based since packed records leave elements unaligned
+		value_type get(size_t i) const {
+			value_type value;
+			std::memcpy(&value, address(i), sizeof(T));
+			return value;
+		}
+		void set(size_t i, value_type value) const {
+			static_assert(!is_const_v<T>, "Read-only view");
+			std::memcpy(address(i), &value, sizeof(T));
+		}
+
+	private:
+		byte_type* address(size_t i) const { return reinterpret_cast<byte_type*>(data_) + static_cast<ptrdiff_t>(i) * stride_; }
+
+		T* data_;
+		size_t size_;
+		ptrdiff_t stride_;
+	};
+
+	template <typename R, typename F> StridedView(R*, size_t, F R::*) -> StridedView<F>;
+	template <typename R, typename F> StridedView(const R*, size_t, F R::*) -> StridedView<const F>;
+
+	namespace views {
+		/**
+		* Contiguous scratch standing in for a StridedView for the length of one Intrinsics call. Loaded from the view
+		* when constructed, and written back (up to the view's length) when destroyed if it stands for the destination.
+		* @note Derives from AlignedVector so the operations take it exactly as they take their own vectors, padding included.
+		*/
+		template <typename T>
+		class Staged : public AlignedVector<T> {
+		public:
+			template <typename U>
+			Staged(const StridedView<U>& view, bool writable)
+				: AlignedVector<T>(view.get_size()), target_(nullptr), stride_(view.get_stride()), limit_(view.get_size()) {
+				if constexpr (!is_const_v<U>) if (writable) target_ = view.data();
+				if constexpr (is_numeric_v<T>) {
+					Dispatch::kernels<T>().load_strided(this->begin(), view.data(), stride_, limit_);
+				}
+				else {
+					for (size_t i = 0; i < limit_; ++i) (*this)[i] = view.get(i);
+				}
+			}
+
+			Staged(Staged&& other) noexcept
+				: AlignedVector<T>(std::move(other)), target_(other.target_), stride_(other.stride_), limit_(other.limit_) {
+				other.target_ = nullptr;
+			}
+
+			Staged(const Staged&) = delete;
+			Staged& operator=(const Staged&) = delete;
+
+			~Staged() {
+				if (!target_) return;
+				size_t n = this->get_size() < limit_ ? this->get_size() : limit_;
+				if constexpr (is_numeric_v<T>) {
+					Dispatch::kernels<T>().store_strided(target_, stride_, this->begin(), n);
+				}
+				else {
+					char* to = reinterpret_cast<char*>(target_);
+					for (size_t i = 0; i < n; ++i, to += stride_) std::memcpy(to, this->begin() + i, sizeof(T));
+				}
+			}
+
+			// Hides AlignedVector::resize, the view behind it cannot grow
+			void resize(size_t new_size, T value = T()) {
+				if (new_size > limit_) {
+					//TODO Errors...
+					return;
+				}
+				AlignedVector<T>::resize(new_size, value);
+			}
+
+		private:
+			T* target_;
+			ptrdiff_t stride_;
+			size_t limit_;
+		};
+
+		// What an Intrinsics operand is: contiguous (AlignedVector, MappedVector, AlignedSpan, Staged) or strided, and whether it owns
+		// the AlignedVector padding the element-wise kernels may run over
+		template <typename C>
+		struct operand {
+			static constexpr bool contiguous = false;
+			static constexpr bool strided = false;
+			static constexpr bool padded = false;
+		};
+		template <typename T>
+		struct operand<AlignedVector<T>> {
+			using element = T;
+			static constexpr bool contiguous = true;
+			static constexpr bool strided = false;
+			static constexpr bool padded = true;
+		};
+		template <typename T>
+		struct operand<Staged<T>> : operand<AlignedVector<T>> {};
+		template <typename T>
+		struct operand<MappedVector<T>> : operand<AlignedVector<T>> {};
+		template <typename T>
+		struct operand<AlignedSpan<T>> {
+			using element = remove_const_t<T>;
+			static constexpr bool contiguous = true;
+			static constexpr bool strided = false;
+			static constexpr bool padded = false;
+		};
+		template <typename T>
+		struct operand<StridedView<T>> {
+			using element = remove_const_t<T>;
+			static constexpr bool contiguous = false;
+			static constexpr bool strided = true;
+			static constexpr bool padded = false;
+		};
+
+		template <typename C> using operand_of = operand<remove_const_t<remove_reference_t<C>>>;
+		template <typename C> using element_t = typename operand_of<C>::element;
+
+		// The operand types of the Intrinsics proper. Argument lists with a strided operand go through unstride first
+		template <typename C>
+		concept Operand = operand_of<C>::contiguous;
+		template <typename C, typename T>
+		concept OperandOf = Operand<C> && is_same_v<element_t<C>, T>;
+		template <typename... C>
+		concept AnyStrided = (operand_of<C>::strided || ...);
+
+		// Elements an element-wise kernel runs over: aligned_size() when every operand owns AlignedVector padding,
+		// get_size() otherwise
+		template <typename D, typename... C>
+		size_t extent(const D& dest, const C&...) {
+			if constexpr (operand_of<D>::padded && (operand_of<C>::padded && ...)) return dest.aligned_size();
+			else return dest.get_size();
+		}
+
+		// A StridedView argument becomes Staged scratch, written back when it is the output; anything else is forwarded
+		template <typename A>
+		decltype(auto) stage(A&& arg, bool output) {
+			using C = remove_const_t<remove_reference_t<A>>;
+			if constexpr (operand<C>::strided) return Staged<element_t<C>>(arg, output);
+			else return std::forward<A>(arg);
+		}
+
+		constexpr size_t NO_OUTPUT = static_cast<size_t>(-1);
+
+		// f(args...) with every strided argument staged. Only the argument at position output (NO_OUTPUT for none) is
+		// scattered back once f has returned: a source, even one aliasing the output, is never written
+		template <typename F, typename... A, size_t... I>
+		decltype(auto) unstride(std::index_sequence<I...>, size_t output, F&& f, A&&... args) {
+			std::tuple<decltype(stage(std::forward<A>(args), false))...> staged{ stage(std::forward<A>(args), I == output)... };
+			return std::apply(f, staged);
+		}
+
+		template <typename F, typename... A>
+		decltype(auto) unstride(size_t output, F&& f, A&&... args) {
+			return unstride(std::index_sequence_for<A...>(), output, std::forward<F>(f), std::forward<A>(args)...);
+		}
+	}
+}
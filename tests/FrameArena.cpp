@@ -0,0 +1,100 @@
+// FrameArena: frames, destructor registration, overflow blocks reused across frames, sizes that cannot fit
+#include "FrameArena.h"
+#include "Allocators.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <vector>
+
+using namespace devsw::stl;
+
+namespace {
+	int failures = 0;
+	std::vector<int> destroyed;
+
+	void check(bool condition, const char* what) {
+		if (condition) return;
+		++failures;
+		std::printf("FAIL %s\n", what);
+	}
+
+	struct Tracked {
+		int id;
+		explicit Tracked(int id = 0) : id(id) {}
+		~Tracked() { destroyed.push_back(id); }
+	};
+
+	struct alignas(256) Wide {
+		char bytes[3];
+	};
+
+	template <typename F>
+	bool throws_bad_alloc(F&& f) {
+		try {
+			f();
+		}
+		catch (const std::bad_alloc&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+int main() {
+	{
+		FrameArena arena(4096);
+		{
+			ArenaScope outer(arena);
+			arena.create<Tracked>(1);
+			arena.create<Tracked>(2);
+			{
+				ArenaScope inner(arena);
+				arena.create<Tracked>(3);
+				int* many = arena.alloc<int>(5000); // Past the first block
+				many[4999] = 1;
+				arena.create<Tracked>(4);
+			}
+			check(destroyed == std::vector<int>({ 4, 3 }), "inner scope destroys its objects, newest first");
+			check(reinterpret_cast<uintptr_t>(arena.alloc<Wide>(2)) % alignof(Wide) == 0, "over-aligned alloc");
+			check(reinterpret_cast<uintptr_t>(arena.alloc<double>()) % alignof(double) == 0, "alloc after odd sizes");
+		}
+		check(destroyed == std::vector<int>({ 4, 3, 2, 1 }), "outer scope destroys the rest");
+		check(arena.bytes_used() == 0, "nothing used after the last scope");
+
+		// The same frame twice lands on the same blocks
+		void* first[2] = {};
+		for (int round = 0; round < 2; ++round) {
+			ArenaScope frame(arena);
+			arena.alloc<char>(3000);
+			void* second_block = arena.alloc<char>(3000);
+			if (round == 0) first[0] = second_block;
+			else first[1] = second_block;
+		}
+		check(first[0] == first[1], "blocks reused by the next frame");
+
+		// Sizes whose end would wrap the address space
+		FrameArena::Marker before = arena.get_marker();
+		check(throws_bad_alloc([&] { arena.allocate(SIZE_MAX - 8, 8); }), "allocate(SIZE_MAX - 8) throws");
+		check(throws_bad_alloc([&] { arena.allocate(SIZE_MAX, 64); }), "allocate(SIZE_MAX) throws");
+		check(throws_bad_alloc([&] { arena.alloc<double>(SIZE_MAX / 4); }), "alloc<double>(SIZE_MAX / 4) throws");
+		FrameArena::Marker after = arena.get_marker();
+		check(before.block == after.block && before.top == after.top, "failed allocations leave the arena as it was");
+		check(arena.alloc<int>(4) != nullptr, "usable after a failed allocation");
+	}
+
+	// ArenaScope over a StackAllocator
+	{
+		StackAllocator<int> stack;
+		stack.allocate(10);
+		void* marker = stack.get_marker();
+		{
+			ArenaScope scope(stack);
+			stack.allocate(100);
+		}
+		check(stack.get_marker() == marker, "ArenaScope rewinds a StackAllocator");
+	}
+
+	std::printf("FrameArena: %d failures\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,406 @@
+// Every KernelTable<T> entry of every tier the host can bind, against the scalar table, on sizes around the vector
+// widths (tails) and on pointers one element off their allocation (unaligned). Also sin/cos near their zeros on every
+// tier, Dispatch clamping and DEVSW_SIMD_TIER
+#include "Dispatch.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace devsw::stl;
+
+namespace {
+	int failures = 0;
+	const char* type_name = "";
+	const char* tier_name = "";
+
+	void fail(const char* entry, size_t n, size_t offset) {
+		if (++failures <= 50) std::printf("FAIL %s %s %s n=%zu offset=%zu\n", tier_name, type_name, entry, n, offset);
+	}
+
+	void check(bool condition, const char* what) {
+		if (condition) return;
+		++failures;
+		std::printf("FAIL %s\n", what);
+	}
+
+	const size_t SIZES[] = { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 129, 255, 257, 1000, 1031 };
+	const Comparison COMPARISONS[] = { Comparison::Equal, Comparison::NotEqual, Comparison::Less, Comparison::LessEqual, Comparison::Greater, Comparison::GreaterEqual };
+
+	// Relative to scale, which is the magnitude of what was summed for reductions: tiers may add in another order
+	template <typename T>
+	bool close(T expected, T actual, double scale = 0) {
+		if constexpr (std::is_floating_point_v<T>) {
+			if (std::isnan(expected) || std::isnan(actual)) return std::isnan(expected) && std::isnan(actual);
+			if (std::isinf(expected) || std::isinf(actual)) return expected == actual;
+			double tolerance = std::is_same_v<T, float> ? 1e-4 : 1e-10;
+			double magnitude = std::fabs(static_cast<double>(expected));
+			if (scale < magnitude) scale = magnitude;
+			return std::fabs(static_cast<double>(expected) - static_cast<double>(actual)) <= tolerance * (scale > 1 ? scale : 1);
+		}
+		else {
+			return expected == actual;
+		}
+	}
+
+	template <typename T>
+	bool close(const std::vector<T>& expected, const std::vector<T>& actual, double scale = 0) {
+		if (expected.size() != actual.size()) return false;
+		for (size_t i = 0; i < expected.size(); ++i) if (!close(expected[i], actual[i], scale)) return false;
+		return true;
+	}
+
+	// Small values, so that integer products and sums stay comparable and floating point ones stay finite
+	template <typename T>
+	std::vector<T> random_vector(std::mt19937& rng, size_t n, bool positive = false) {
+		std::vector<T> values(n);
+		for (T& value : values) {
+			if constexpr (std::is_floating_point_v<T>) value = static_cast<T>(std::uniform_real_distribution<double>(positive ? 0.125 : -4.0, 4.0)(rng));
+			else if constexpr (std::is_signed_v<T>) value = static_cast<T>(std::uniform_int_distribution<int>(positive ? 1 : -10, 10)(rng));
+			else value = static_cast<T>(std::uniform_int_distribution<int>(positive ? 1 : 0, 20)(rng));
+		}
+		return values;
+	}
+
+	template <typename T>
+	double magnitude(const T* src, size_t n) {
+		double total = 1;
+		for (size_t i = 0; i < n; ++i) total += std::fabs(static_cast<double>(src[i]));
+		return total;
+	}
+
+	template <typename F>
+	bool present(F expected, F actual, const char* name) {
+		if ((expected == nullptr) != (actual == nullptr)) {
+			fail(name, 0, 0);
+			return false;
+		}
+		return expected != nullptr;
+	}
+
+	template <typename T>
+	void compare_tables(const KernelTable<T>& ref, const KernelTable<T>& tier) {
+		using Binary = void (*)(T*, const T*, size_t, bool);
+		using Unary = void (*)(T*, size_t, bool);
+		std::mt19937 rng(1234);
+
+		for (size_t n : SIZES) {
+			for (size_t offset = 0; offset < 2; ++offset) {
+				std::vector<T> a = random_vector<T>(rng, n + offset), b = random_vector<T>(rng, n + offset), positive = random_vector<T>(rng, n + offset, true);
+				const T* pa = a.data() + offset;
+				const T* pb = b.data() + offset;
+				const T* pp = positive.data() + offset;
+				double products = 1;
+				for (size_t i = 0; i < n; ++i) products += std::fabs(static_cast<double>(pa[i]) * static_cast<double>(pb[i]));
+
+				// In place on a copy of base, both store modes
+				auto binary = [&](const char* name, Binary expected, Binary actual, const std::vector<T>& base, const T* src) {
+					if (!present(expected, actual, name)) return;
+					for (bool stream : { false, true }) {
+						std::vector<T> e(base), t(base);
+						expected(e.data() + offset, src, n, stream);
+						actual(t.data() + offset, src, n, stream);
+						if (!close(e, t)) fail(name, n, offset);
+					}
+				};
+				auto unary = [&](const char* name, Unary expected, Unary actual, const std::vector<T>& base) {
+					if (!present(expected, actual, name)) return;
+					for (bool stream : { false, true }) {
+						std::vector<T> e(base), t(base);
+						expected(e.data() + offset, n, stream);
+						actual(t.data() + offset, n, stream);
+						if (!close(e, t)) fail(name, n, offset);
+					}
+				};
+
+				binary("add", ref.add, tier.add, a, pb);
+				binary("subtract", ref.subtract, tier.subtract, a, pb);
+				binary("multiply", ref.multiply, tier.multiply, a, pb);
+				binary("divide", ref.divide, tier.divide, a, pp);
+				binary("min", ref.min, tier.min, a, pb);
+				binary("max", ref.max, tier.max, a, pb);
+				binary("pow", ref.pow, tier.pow, positive, pb);
+				unary("abs", ref.abs, tier.abs, a);
+				unary("sqrt", ref.sqrt, tier.sqrt, positive);
+				unary("exp", ref.exp, tier.exp, a);
+				unary("log", ref.log, tier.log, positive);
+				unary("log2", ref.log2, tier.log2, positive);
+				unary("sin", ref.sin, tier.sin, a);
+				unary("cos", ref.cos, tier.cos, a);
+				unary("tanh", ref.tanh, tier.tanh, a);
+				unary("sigmoid", ref.sigmoid, tier.sigmoid, a);
+				unary("erf", ref.erf, tier.erf, a);
+
+				if (present(ref.fmadd, tier.fmadd, "fmadd")) {
+					for (bool stream : { false, true }) {
+						std::vector<T> e(positive), t(positive);
+						ref.fmadd(e.data() + offset, pa, pb, n, stream);
+						tier.fmadd(t.data() + offset, pa, pb, n, stream);
+						if (!close(e, t, products)) fail("fmadd", n, offset);
+					}
+				}
+				if (present(ref.dot_product, tier.dot_product, "dot_product") && !close(ref.dot_product(pa, pb, n), tier.dot_product(pa, pb, n), products)) fail("dot_product", n, offset);
+
+				// Reductions
+				double summed = magnitude(pa, n);
+				if (present(ref.sum, tier.sum, "sum") && !close(ref.sum(pa, n), tier.sum(pa, n), summed)) fail("sum", n, offset);
+				if (present(ref.sum_pairwise, tier.sum_pairwise, "sum_pairwise") && !close(ref.sum_pairwise(pa, n), tier.sum_pairwise(pa, n), summed)) fail("sum_pairwise", n, offset);
+				if (present(ref.sum_kahan, tier.sum_kahan, "sum_kahan") && !close(ref.sum_kahan(pa, n), tier.sum_kahan(pa, n), summed)) fail("sum_kahan", n, offset);
+				if (present(ref.reduce_min, tier.reduce_min, "reduce_min") && ref.reduce_min(pa, n) != tier.reduce_min(pa, n)) fail("reduce_min", n, offset);
+				if (present(ref.reduce_max, tier.reduce_max, "reduce_max") && ref.reduce_max(pa, n) != tier.reduce_max(pa, n)) fail("reduce_max", n, offset);
+				if (present(ref.argmin, tier.argmin, "argmin") && ref.argmin(pa, n) != tier.argmin(pa, n)) fail("argmin", n, offset);
+				if (present(ref.argmax, tier.argmax, "argmax") && ref.argmax(pa, n) != tier.argmax(pa, n)) fail("argmax", n, offset);
+				if (present(ref.sum_squared_deviation, tier.sum_squared_deviation, "sum_squared_deviation")) {
+					real_t<T> center = static_cast<real_t<T>>(pa[n / 2]);
+					if (!close(ref.sum_squared_deviation(pa, n, center), tier.sum_squared_deviation(pa, n, center), 64.0 * static_cast<double>(n))) fail("sum_squared_deviation", n, offset);
+				}
+
+				// Predicates and compaction. Bits past n must be cleared, so the words start out dirty
+				size_t words = (n + 63) / 64;
+				for (Comparison op : COMPARISONS) {
+					if (present(ref.compare, tier.compare, "compare")) {
+						std::vector<uint64_t> e(words, ~uint64_t(0)), t(words, ~uint64_t(0));
+						ref.compare(e.data(), pa, pb, n, op);
+						tier.compare(t.data(), pa, pb, n, op);
+						if (e != t) fail("compare", n, offset);
+					}
+					if (present(ref.compare_scalar, tier.compare_scalar, "compare_scalar")) {
+						std::vector<uint64_t> e(words, ~uint64_t(0)), t(words, ~uint64_t(0));
+						ref.compare_scalar(e.data(), pa, pb[0], n, op);
+						tier.compare_scalar(t.data(), pa, pb[0], n, op);
+						if (e != t) fail("compare_scalar", n, offset);
+					}
+					if (present(ref.compress_scalar, tier.compress_scalar, "compress_scalar")) {
+						std::vector<T> e(n), t(n);
+						size_t ne = ref.compress_scalar(e.data(), pa, pb[0], n, op);
+						size_t nt = tier.compress_scalar(t.data(), pa, pb[0], n, op);
+						e.resize(ne);
+						t.resize(nt);
+						if (e != t) fail("compress_scalar", n, offset);
+					}
+				}
+				if (present(ref.compress, tier.compress, "compress") && ref.compare) {
+					std::vector<uint64_t> bits(words);
+					ref.compare(bits.data(), pa, pb, n, Comparison::Less);
+					std::vector<T> e(n), t(n);
+					size_t ne = ref.compress(e.data(), pa, bits.data(), n);
+					size_t nt = tier.compress(t.data(), pa, bits.data(), n);
+					e.resize(ne);
+					t.resize(nt);
+					if (e != t) fail("compress", n, offset);
+				}
+
+				// Scans, with a carry-in
+				auto scan = [&](const char* name, void (*expected)(T*, const T*, size_t, T), void (*actual)(T*, const T*, size_t, T)) {
+					if (!present(expected, actual, name)) return;
+					std::vector<T> e(n), t(n);
+					expected(e.data(), pa, n, T(3));
+					actual(t.data(), pa, n, T(3));
+					if (!close(e, t, summed + 3)) fail(name, n, offset);
+				};
+				scan("inclusive_scan", ref.inclusive_scan, tier.inclusive_scan);
+				scan("exclusive_scan", ref.exclusive_scan, tier.exclusive_scan);
+				scan("running_min", ref.running_min, tier.running_min);
+				scan("running_max", ref.running_max, tier.running_max);
+
+				if (present(ref.sort, tier.sort, "sort")) {
+					std::vector<T> e(pa, pa + n), t(pa, pa + n);
+					ref.sort(e.data(), n);
+					tier.sort(t.data(), n);
+					if (e != t) fail("sort", n, offset);
+				}
+				if (present(ref.argsort, tier.argsort, "argsort")) {
+					std::vector<size_t> e(n), t(n);
+					ref.argsort(e.data(), pa, n);
+					tier.argsort(t.data(), pa, n);
+					if (e != t) fail("argsort", n, offset);
+				}
+
+				// Counts are added to, so they start at one
+				if (present(ref.histogram, tier.histogram, "histogram")) {
+					std::vector<uint32_t> e(16, 1), t(16, 1);
+					ref.histogram(e.data(), e.size(), pa, n);
+					tier.histogram(t.data(), t.size(), pa, n);
+					if (e != t) fail("histogram", n, offset);
+				}
+				if (present(ref.histogram_range, tier.histogram_range, "histogram_range")) {
+					std::vector<uint32_t> e(10, 1), t(10, 1);
+					ref.histogram_range(e.data(), e.size(), pa, n, T(-2), T(2));
+					tier.histogram_range(t.data(), t.size(), pa, n, T(-2), T(2));
+					if (e != t) fail("histogram_range", n, offset);
+				}
+
+				// Indexed access, a quarter of the indices past the table when checked
+				std::vector<uint32_t> in_range(n), some_out(n);
+				for (size_t i = 0; i < n; ++i) {
+					in_range[i] = static_cast<uint32_t>(rng() % n);
+					some_out[i] = static_cast<uint32_t>(rng() % (n + n / 3 + 1));
+				}
+				for (BoundsCheck checked : { BoundsCheck::Checked, BoundsCheck::Unchecked }) {
+					const uint32_t* indices = checked == BoundsCheck::Checked ? some_out.data() : in_range.data();
+					if (present(ref.gather, tier.gather, "gather")) {
+						std::vector<T> e(a), t(a);
+						size_t ne = ref.gather(e.data() + offset, pb, n, indices, n, checked);
+						size_t nt = tier.gather(t.data() + offset, pb, n, indices, n, checked);
+						if (ne != nt || e != t) fail("gather", n, offset);
+					}
+					if (present(ref.scatter, tier.scatter, "scatter")) {
+						std::vector<T> e(b), t(b);
+						size_t ne = ref.scatter(e.data() + offset, n, indices, pa, n, checked);
+						size_t nt = tier.scatter(t.data() + offset, n, indices, pa, n, checked);
+						if (ne != nt || e != t) fail("scatter", n, offset);
+					}
+				}
+
+				// Strided copies, byte-misaligned and both directions of stride. Compared bitwise
+				for (ptrdiff_t stride : { ptrdiff_t(3 * sizeof(T)), -ptrdiff_t(2 * sizeof(T)) }) {
+					size_t span = n * static_cast<size_t>(stride < 0 ? -stride : stride);
+					std::vector<unsigned char> raw(span + 2 * sizeof(T) + 2);
+					for (unsigned char& byte : raw) byte = static_cast<unsigned char>(std::uniform_int_distribution<int>(0, 63)(rng));
+					unsigned char* first = raw.data() + 1 + (stride < 0 ? span : 0);
+					if (present(ref.load_strided, tier.load_strided, "load_strided")) {
+						std::vector<T> e(n + 1), t(n + 1);
+						ref.load_strided(e.data() + offset, reinterpret_cast<const T*>(first), stride, n);
+						tier.load_strided(t.data() + offset, reinterpret_cast<const T*>(first), stride, n);
+						if (std::memcmp(e.data(), t.data(), (n + 1) * sizeof(T)) != 0) fail("load_strided", n, offset);
+					}
+					if (present(ref.store_strided, tier.store_strided, "store_strided")) {
+						std::vector<unsigned char> e(raw), t(raw);
+						ref.store_strided(reinterpret_cast<T*>(e.data() + (first - raw.data())), stride, pa, n);
+						tier.store_strided(reinterpret_cast<T*>(t.data() + (first - raw.data())), stride, pa, n);
+						if (e != t) fail("store_strided", n, offset);
+					}
+				}
+			}
+		}
+
+		// Dense linear algebra on shapes around the register blocks, with padded leading dimensions
+		const size_t SHAPES[] = { 1, 3, 8, 17, 33, 70 };
+		for (size_t m : SHAPES) {
+			for (size_t n : SHAPES) {
+				for (size_t k : SHAPES) {
+					std::vector<T> a = random_vector<T>(rng, m * (k + 1)), b = random_vector<T>(rng, k * (n + 2)), c = random_vector<T>(rng, m * (n + 3));
+					double scale = 16.0 * static_cast<double>(k + 1);
+					if (present(ref.gemm, tier.gemm, "gemm")) {
+						std::vector<T> e(c), t(c);
+						ref.gemm(m, n, k, T(1.5), a.data(), k + 1, b.data(), n + 2, T(0.5), e.data(), n + 3);
+						tier.gemm(m, n, k, T(1.5), a.data(), k + 1, b.data(), n + 2, T(0.5), t.data(), n + 3);
+						if (!close(e, t, scale)) fail("gemm", m * 10000 + n * 100 + k, 0);
+					}
+					if (k == 1 && present(ref.gemv, tier.gemv, "gemv")) {
+						std::vector<T> matrix = random_vector<T>(rng, m * (n + 1)), x = random_vector<T>(rng, n), e(c.begin(), c.begin() + m), t(e);
+						ref.gemv(m, n, T(1.5), matrix.data(), n + 1, x.data(), T(0.5), e.data());
+						tier.gemv(m, n, T(1.5), matrix.data(), n + 1, x.data(), T(0.5), t.data());
+						if (!close(e, t, 16.0 * static_cast<double>(n + 1))) fail("gemv", m * 100 + n, 0);
+					}
+				}
+			}
+		}
+	}
+
+	// sin and cos at the arguments nearest their zeros up to SimdMath's documented range, where the result is tiny
+	// and every bit the argument reduction drops shows: within 3 ulp of long double
+	template <typename T>
+	void check_trig_zeros(const KernelTable<T>& table) {
+		const long double half_pi = 1.5707963267948966192313216916397514L;
+		const long limit = std::is_same_v<T, float> ? 39000 : 1000000;
+		std::vector<T> args;
+		for (long j = 1; j * half_pi < limit; j += std::is_same_v<T, float> ? 1 : 37) {
+			T nearest = static_cast<T>(j * half_pi);
+			for (T x : { std::nextafter(nearest, T(0)), nearest, std::nextafter(nearest, T(limit)) }) {
+				args.push_back(x);
+				args.push_back(-x);
+			}
+		}
+		auto within = [&](const char* name, void (*f)(T*, size_t, bool), long double (*reference)(long double)) {
+			std::vector<T> y(args);
+			f(y.data(), y.size(), false);
+			for (size_t i = 0; i < y.size(); ++i) {
+				long double expected = reference(args[i]);
+				T rounded = static_cast<T>(expected);
+				long double ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<T>::infinity()) - std::fabs(rounded);
+				if (std::fabs(y[i] - expected) > 3 * ulp) {
+					fail(name, i, 0);
+					return;
+				}
+			}
+		};
+		within("sin near zeros", table.sin, [](long double x) { return std::sin(x); });
+		within("cos near zeros", table.cos, [](long double x) { return std::cos(x); });
+	}
+
+	template <typename T>
+	void test_type(const char* name) {
+		type_name = name;
+		Dispatch::set_tier(SimdTier::Scalar);
+		const KernelTable<T>& ref = Dispatch::kernels<T>();
+		if constexpr (std::is_floating_point_v<T>) {
+			tier_name = "scalar";
+			check_trig_zeros(ref);
+		}
+		for (SimdTier tier : { SimdTier::SSE42, SimdTier::AVX2, SimdTier::AVX512 }) {
+			Dispatch::set_tier(tier);
+			if (Dispatch::active_tier() != tier) continue; // Not on this host
+			tier_name = Dispatch::tier_name(tier);
+			compare_tables(ref, Dispatch::kernels<T>());
+			if constexpr (std::is_floating_point_v<T>) check_trig_zeros(Dispatch::kernels<T>());
+		}
+	}
+
+	void set_environment(const char* name, const char* value) {
+#if defined(_MSC_VER)
+		_putenv_s(name, value);
+#else
+		setenv(name, value, 1);
+#endif
+	}
+
+	SimdTier clamp(SimdTier tier) {
+		return tier < Dispatch::detected_tier() ? tier : Dispatch::detected_tier();
+	}
+
+	void test_dispatch() {
+		SimdTier host = Dispatch::detected_tier();
+		for (SimdTier tier : { SimdTier::Scalar, SimdTier::SSE42, SimdTier::AVX2, SimdTier::AVX512 }) {
+			Dispatch::set_tier(tier);
+			check(Dispatch::active_tier() == clamp(tier), "set_tier clamps to the detected tier");
+		}
+		const CpuFeatures& f = Dispatch::features();
+		if (host >= SimdTier::SSE42) check(f.sse42 && f.popcnt, "SSE4.2 tier without SSE4.2 or POPCNT");
+		if (host >= SimdTier::AVX2) check(f.avx2 && f.fma && f.f16c && f.bmi2, "AVX2 tier without AVX2, FMA, F16C or BMI2");
+		if (host >= SimdTier::AVX512) check(f.avx512f && f.avx512bw && f.avx512cd && f.avx512dq && f.avx512vl, "AVX-512 tier without AVX-512 F/BW/CD/DQ/VL");
+
+		struct { const char* value; SimdTier expected; } const forced[] = {
+			{ "scalar", SimdTier::Scalar }, { "sse42", clamp(SimdTier::SSE42) }, { "sse4.2", clamp(SimdTier::SSE42) },
+			{ "avx2", clamp(SimdTier::AVX2) }, { "avx512", host }, { "avx1024", host }, { "", host },
+		};
+		for (const auto& entry : forced) {
+			set_environment("DEVSW_SIMD_TIER", entry.value);
+			Dispatch::init();
+			check(Dispatch::active_tier() == entry.expected, "DEVSW_SIMD_TIER");
+		}
+		set_environment("DEVSW_SIMD_TIER", "");
+		Dispatch::init();
+	}
+}
+
+int main() {
+	test_dispatch();
+	test_type<float>("float");
+	test_type<double>("double");
+	test_type<int8_t>("int8_t");
+	test_type<uint8_t>("uint8_t");
+	test_type<int16_t>("int16_t");
+	test_type<uint16_t>("uint16_t");
+	test_type<int32_t>("int32_t");
+	test_type<uint32_t>("uint32_t");
+	test_type<int64_t>("int64_t");
+	test_type<uint64_t>("uint64_t");
+	std::printf("KernelTiers: host %s, %d failures\n", Dispatch::tier_name(Dispatch::detected_tier()), failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+// NumaArena: alignment, requests that only fit a chunk of their own, chunks reused after reset
+#include "NumaAllocator.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace devsw::stl;
+
+namespace {
+	int failures = 0;
+
+	void check(bool condition, const char* what) {
+		if (condition) return;
+		++failures;
+		std::printf("FAIL %s\n", what);
+	}
+
+	struct Block {
+		unsigned char* data;
+		size_t bytes;
+		unsigned char fill;
+	};
+
+	// Allocates, checks the alignment and fills every byte, so a block past the end of its chunk faults here
+	void* take(NumaArena& arena, std::vector<Block>& blocks, size_t bytes, size_t alignment) {
+		void* p = arena.allocate(bytes, Numa::ANY, alignment);
+		check(p != nullptr, "allocate succeeds");
+		if (!p) return nullptr;
+		check(reinterpret_cast<uintptr_t>(p) % alignment == 0, "allocate honours the alignment");
+		unsigned char fill = static_cast<unsigned char>(blocks.size() * 37 + 1);
+		std::memset(p, fill, bytes);
+		blocks.push_back({ static_cast<unsigned char*>(p), bytes, fill });
+		return p;
+	}
+
+	// No block was overwritten by a later one
+	bool intact(const std::vector<Block>& blocks) {
+		for (const Block& block : blocks)
+			for (size_t i = 0; i < block.bytes; ++i)
+				if (block.data[i] != block.fill) return false;
+		return true;
+	}
+}
+
+int main() {
+	size_t page = Pages::page_size();
+
+	// A page aligned request in a one page arena: the header leaves no room for it in a shared chunk
+	{
+		NumaArena arena(page);
+		std::vector<Block> blocks;
+		take(arena, blocks, page / 4, page);
+		take(arena, blocks, 16, 16);
+		take(arena, blocks, page / 4, page);
+		take(arena, blocks, page / 4 - 64, 64);
+		check(intact(blocks), "page aligned blocks in a one page arena do not overlap");
+	}
+
+	// Every alignment against sizes around the dedicated cutoff, twice with a reset in between
+	{
+		NumaArena arena(4 * page);
+		for (int round = 0; round < 2; ++round) {
+			std::vector<Block> blocks;
+			for (size_t alignment = 1; alignment <= page; alignment *= 2) {
+				take(arena, blocks, arena.chunk_size() / 4, alignment);
+				take(arena, blocks, arena.chunk_size() / 4 - 1, alignment);
+				take(arena, blocks, 1, alignment);
+			}
+			check(intact(blocks), "blocks near the cutoff do not overlap");
+			arena.reset();
+		}
+	}
+
+	// Larger than a chunk
+	{
+		NumaArena arena(page);
+		std::vector<Block> blocks;
+		take(arena, blocks, 3 * page, 64);
+		take(arena, blocks, 8, 8);
+		check(intact(blocks), "a request larger than a chunk gets its own");
+	}
+
+	{
+		NumaArena arena(page);
+		check(arena.allocate(16, Numa::ANY, 3) == nullptr, "alignment that is not a power of two is refused");
+		check(arena.allocate(16, Numa::ANY, 2 * page) == nullptr, "alignment above a page is refused");
+	}
+
+	std::printf("NumaArena: %d failures\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+// StridedView operands of Intrinsics: only the destination is written back, so views aliasing each other behave like
+// the contiguous operations they stand for
+#include "AvxIntrinsics.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace devsw::stl;
+
+namespace {
+	int failures = 0;
+
+	void check(bool condition, const char* what) {
+		if (condition) return;
+		++failures;
+		std::printf("FAIL %s\n", what);
+	}
+
+	struct Quote {
+		double price;
+		double size;
+	};
+
+	std::vector<Quote> quotes(std::initializer_list<double> prices) {
+		std::vector<Quote> result;
+		for (double price : prices) result.push_back({ price, -1.0 });
+		return result;
+	}
+
+	bool prices_are(const std::vector<Quote>& q, std::initializer_list<double> expected) {
+		size_t i = 0;
+		for (double price : expected) {
+			if (q[i].price != price || q[i].size != -1.0) return false;
+			++i;
+		}
+		return true;
+	}
+}
+
+int main() {
+	// Two writable views over the same column: the source must not be scattered back over the result
+	{
+		std::vector<Quote> q = quotes({ 2, 3 });
+		StridedView<double> v(q.data(), q.size(), &Quote::price), v2(q.data(), q.size(), &Quote::price);
+		Intrinsics::multiply(v, v2);
+		check(prices_are(q, { 4, 9 }), "multiply(v, v) through two views");
+	}
+	{
+		std::vector<Quote> q = quotes({ 2, 3, 4, 5 });
+		StridedView<double> v(q.data(), q.size(), &Quote::price), v2(q.data(), q.size(), &Quote::price);
+		Intrinsics::multiply(par, v, v2);
+		check(prices_are(q, { 4, 9, 16, 25 }), "multiply(par, v, v) through two views");
+	}
+	{
+		std::vector<Quote> q = quotes({ 1, 2, 3, 4, 5 });
+		StridedView<double> head(q.data(), 4, &Quote::price), tail(q.data() + 1, 4, &Quote::price);
+		Intrinsics::add(head, tail);
+		check(prices_are(q, { 3, 5, 7, 9, 5 }), "add over overlapping views");
+	}
+	{
+		std::vector<Quote> q = quotes({ 5, 1, 4, 2 });
+		StridedView<double> v(q.data(), q.size(), &Quote::price), v2(q.data(), q.size(), &Quote::price);
+		Intrinsics::min(v, v2);
+		check(prices_are(q, { 5, 1, 4, 2 }), "min(v, v) through two views");
+		check(Intrinsics::min(v) == 1.0 && prices_are(q, { 5, 1, 4, 2 }), "min(v) reduction");
+	}
+	{
+		std::vector<Quote> q = quotes({ 1, 2, 3, 4 });
+		StridedView<double> v(q.data(), q.size(), &Quote::price), v2(q.data(), q.size(), &Quote::price);
+		Intrinsics::fmadd(v, v2, v2);
+		check(prices_are(q, { 2, 6, 12, 20 }), "fmadd(v, v, v) through three views");
+	}
+	// scatter's table is its destination, the source aliasing it is read
+	{
+		std::vector<Quote> q = quotes({ 10, 20, 30 });
+		StridedView<double> table(q.data(), q.size(), &Quote::price), src(q.data(), q.size(), &Quote::price);
+		AlignedVector<uint32_t> indices(3);
+		indices[0] = 2;
+		indices[1] = 0;
+		indices[2] = 1;
+		Intrinsics::scatter(table, indices, src);
+		check(prices_are(q, { 20, 30, 10 }), "scatter with the source aliasing the table");
+	}
+	// Reductions and sources leave the column alone, even when a destination shares the call
+	{
+		std::vector<Quote> q = quotes({ 1, 2, 3 });
+		StridedView<double> v(q.data(), q.size(), &Quote::price);
+		check(Intrinsics::sum(v) == 6.0 && Intrinsics::dot_product(v, v) == 14.0, "reductions over a writable view");
+		AlignedVector<double> out(3);
+		Intrinsics::add(out, v);
+		check(out[0] == 1.0 && out[2] == 3.0 && prices_are(q, { 1, 2, 3 }), "writable view as a source");
+	}
+
+	std::printf("StridedViews: %d failures\n", failures);
+	return failures ? 1 : 0;
+}